@@ -87,6 +87,7 @@ inline void fpadd217(const digit_t* a, const digit_t* b, digit_t* c)
     fpadd217_asm(a, b, c);    
 
 #endif
+    PROFILE_COUNT(SIDH_OP_FPADD);
 } 
 
 
@@ -114,6 +115,7 @@ inline void fpsub217(const digit_t* a, const digit_t* b, digit_t* c)
     fpsub217_asm(a, b, c);    
 
 #endif
+    PROFILE_COUNT(SIDH_OP_FPSUB);
 }
 
 
@@ -160,7 +162,7 @@ void fpcorrection217(digit_t* a)
     }
 }
 
-#if (OS_TARGET == OS_NIX)
+#if (OS_TARGET == OS_NIX) && !defined(_DISPATCH_)
 
 void fp2mul217_c0_mont(const digit_t* a, const digit_t* b, digit_t* c)
 {
@@ -190,7 +192,7 @@ void fpmul217(const digit_t* a, const digit_t* b, digit_t* c)
     fpmul217_asm(a, b, c);
 }
 
-#else
+#elif (OS_TARGET == OS_WIN)
 
 // TODO: Both of these are the old P434, change it P217 (No need really since these are only for not unix)
 
@@ -504,3 +506,25 @@ void rdc_mont(digit_t* ma, digit_t* mc)
 }
 
 #endif
+
+
+#if (OS_TARGET == OS_NIX) && defined(_DISPATCH_)
+// Runtime selection between the portable kernels in fp_generic.c and the MULX+ADX assembly
+#define fp2mul_c0_mont                fp2mul217_c0_mont
+#define fp2mul_c1_mont                fp2mul217_c1_mont
+#define fp2sqr_c0_mont                fp2sqr217_c0_mont
+#define fp2sqr_c1_mont                fp2sqr217_c1_mont
+#define fpmul                         fpmul217
+#define fp2mul_c0_asm                 fp2mul217_c0_asm
+#define fp2mul_c1_asm                 fp2mul217_c1_asm
+#define fp2sqr_c0_asm                 fp2sqr217_c0_asm
+#define fp2sqr_c1_asm                 fp2sqr217_c1_asm
+#define fpmul_asm                     fpmul217_asm
+#define fpkernel_get                  fpkernel217_get
+#define fpkernel_set                  fpkernel217_set
+#define FP_MUL_GENERIC                mp_mul217_generic
+#define FP_RDC_GENERIC                rdc217_mont_generic
+#define FP_PRIMEx2                    p217x2
+
+#include "../../fpx_dispatch.c"
+#endif
@@ -85,6 +85,8 @@ const unsigned int strat_Bob[MAX_Bob - 1] = {
 #define fp2div2                       fp2div2_217
 #define fp2correction                 fp2correction217
 #define fp2mul_mont                   fp2mul217_mont
+#define fp2muladd_mont                fp2muladd217_mont
+#define fp2mulsub_mont                fp2mulsub217_mont
 #define fp2sqr_mont                   fp2sqr217_mont
 #define fp2mul_c0_mont                fp2mul217_c0_mont
 #define fp2mul_c1_mont                fp2mul217_c1_mont
@@ -98,6 +100,12 @@ const unsigned int strat_Bob[MAX_Bob - 1] = {
 #define mp_dblsubx2_asm               mp_dblsub217x2_asm
 #define crypto_kem_keypair            crypto_kem_keypair_SIKEp217
 #define crypto_kem_enc                crypto_kem_enc_SIKEp217
+#define crypto_kem_enc_batch          crypto_kem_enc_batch_SIKEp217
+#define crypto_kem_enc_ctx            crypto_kem_enc_ctx_SIKEp217
+#define sike_pk_ctx                   sike_pk_ctx_SIKEp217
+#define sike_pk_ctx_init              sike_pk_ctx_init_SIKEp217
+#define crypto_kem_ct_validate        crypto_kem_ct_validate_SIKEp217
+#define crypto_kem_scheme             crypto_kem_scheme_SIKEp217
 #define crypto_kem_dec                crypto_kem_dec_SIKEp217
 #define random_mod_order_A            random_mod_order_A_SIDHp217
 #define random_mod_order_B            random_mod_order_B_SIDHp217
@@ -105,6 +113,13 @@ const unsigned int strat_Bob[MAX_Bob - 1] = {
 #define EphemeralKeyGeneration_B      EphemeralKeyGeneration_B_SIDHp217
 #define EphemeralSecretAgreement_A    EphemeralSecretAgreement_A_SIDHp217
 #define EphemeralSecretAgreement_B    EphemeralSecretAgreement_B_SIDHp217
+#define EphemeralSecretAgreement_A_ctx EphemeralSecretAgreement_A_ctx_SIDHp217
+#define EphemeralSecretAgreement_B_ctx EphemeralSecretAgreement_B_ctx_SIDHp217
+#define sidh_load_strategies          sidh_load_strategies_SIDHp217
+
+#if defined(SIDH_FIXED_BASE)
+    #include "P217_fixed_base.c"
+#endif
 
 #include "../fpx.c"
 #include "../ec_isogeny.c"
@@ -0,0 +1,448 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: precomputed multiples of the generators of SIDHp217 for fixed-base key generation
+*           Generated by fixed_base_gen-p217, used if SIDH_FIXED_BASE is defined
+*********************************************************************************************/
+
+// Affine x-coordinates x(2^i*QA), i = 0, ..., OALICE_BITS-1, in GF(p^2), expressed in Montgomery representation
+const uint64_t A_gen_dbl[2*(OALICE_BITS)*NWORDS64_FIELD] = {
+    0x787BBD78868288C6, 0x012C095E06EAC0F0, 0x9BA422474C683ED8, 0x0000000000DE59E6,
+    0x6A98D37823E89645, 0xEEDAFB39BBE96580, 0x0CE16ADF45A3F745, 0x00000000001A56C5,
+    0x745F80EFEDABF1D3, 0xA9D3DD54EA1D16B2, 0xB6B22AF024F4AF6A, 0x00000000002845D9,
+    0x3A7EFAE36D2210EE, 0xAC60FDFC3808057C, 0x5C1B4765A7F48D55, 0x0000000000746CEA,
+    0x5D3F56A526292022, 0x85E87C94F74E7E2C, 0x587ECFF8088BB0B9, 0x0000000000E9178E,
+    0x1C75584ABFD79761, 0x2580840990183C1A, 0xA513C315B041047D, 0x00000000008DD2CA,
+    0x901940DA1BBB3107, 0x85A2B0544B863117, 0xD0D1725921D7D549, 0x00000000001DB946,
+    0xE7447AFFA5EC4DFB, 0x3F0CCFF1F308E752, 0x04566390257ECE42, 0x0000000000BA679B,
+    0xB56CF1D46D5647E9, 0xB457894A360B9D28, 0x2C991BA05EAF6A6B, 0x0000000000B43ECB,
+    0x62B44947ED49D0B7, 0xBAA003F08683D54D, 0xAA572278248D4A23, 0x000000000029ED67,
+    0x6911E1A754E4943C, 0x0EE8ED05C69E6B91, 0x12FC26242334D20B, 0x00000000009E3827,
+    0x9B148C0CBAA16E9D, 0xCC316585C8804DCE, 0x32D3B82211DE5E6C, 0x00000000004191E5,
+    0xA5D9FEE8C4502117, 0xFC8257129DD8EA5F, 0xFEF0E2A911B39E71, 0x0000000000893F7B,
+    0xF0EA2147364F1A42, 0x9D882FE54DC62E8E, 0x955C33DFCE0A2EE7, 0x00000000003E474B,
+    0xE1CAE9B0207836A3, 0x569009EB7DFEC822, 0x41F3D76329BF9B75, 0x00000000009B6048,
+    0x99C7CE837E1CA32B, 0x888E6A75A0A4BD02, 0xC543ADF0627F5BD1, 0x0000000000F590CD,
+    0x90378302CC136A54, 0x3ACAB24F3F3075E6, 0xD8C8ECC8B155C807, 0x00000000007102B4,
+    0x3E5AABC4B9EDDDAB, 0x9E81D23D024981B0, 0x20C963561C812228, 0x0000000000817267,
+    0x1BAFCF227023971E, 0x9191462E8F16E267, 0xF28A6BDA4F97761C, 0x000000000049169F,
+    0x955B2CCD8894DF1D, 0xE1F2B2779B7DE4DD, 0x847082C4FCAE6430, 0x0000000000903E29,
+    0x87BA5747A91D4AF2, 0xAE15BA1F53F02032, 0x286D4AAFF21827A7, 0x000000000090D18A,
+    0xA0D2C23C4C017BCC, 0x11AF016FD892F536, 0xD163C56349CEBCD2, 0x0000000000FF1A9C,
+    0xE32E1F082DE0CF3C, 0xFC51CEB746061F9F, 0xAD5F7A7A7939DAF4, 0x0000000000ADF8B1,
+    0xF32596992FA97E78, 0xC8FAFF46BE132239, 0xE236957A5A4C8E9B, 0x0000000000EC9057,
+    0x226E5F628790CC06, 0xD3C969C231A0EADF, 0xB933BA1E1F3A730B, 0x000000000006EA92,
+    0x6FA2CCE06A3CED4F, 0x85D012DDDC45962C, 0x0203F3A9432E1123, 0x00000000000F2B05,
+    0x59A440C04863D153, 0xC76D7907632F18C2, 0xFB1AEB7755476DDB, 0x000000000031FCB7,
+    0x8FE4CE39C96C2176, 0x9E0567B669FADE12, 0x0D6A66EB95C59673, 0x0000000000097838,
+    0x14F65A455B0EBFEC, 0xE0329A36D89BAC3D, 0xC9C61B76474FA692, 0x0000000000D51E7C,
+    0x2A93B7F362BB9470, 0xBA1752FB4133F313, 0x37C72B72AFAA965F, 0x0000000000DFA352,
+    0x388041332F32731A, 0x82B13CBFECB4A4D7, 0x7E5AAFFD37587A55, 0x000000000109B55B,
+    0xE36DACCF7CB381C6, 0xA04CFDF29E1F009D, 0xBA92CB8C9C78FC2D, 0x0000000000731589,
+    0x09279E5F8DEED0B7, 0x5CBE5262EBF3C466, 0x1B71DEADF4BD0A6F, 0x000000000109BFAF,
+    0x57CE62EDEB3979A4, 0x59F89E636C898D23, 0xAB1A041611B08086, 0x000000000013159F,
+    0x8CDE0BDD6CEB3639, 0x4087FE7679C67170, 0x61912EBE1DD6D73D, 0x0000000000946ACA,
+    0x68658671B2DA24B6, 0xCB4B83A045105747, 0xF9A5FADC6F1C6D3F, 0x000000000070A801,
+    0x025F18F038BCAF4F, 0xEC728E0D8FD074C8, 0xE151CC8B37095C63, 0x0000000000A0A2F8,
+    0x9FEE7D3D7509A589, 0xD5AA4C9D8353BB9D, 0x0D8F6E3A887FB680, 0x00000000005CAEA6,
+    0x95E1ABB1445511CF, 0x4BC610842E871AFE, 0x8C0E016C6BB51372, 0x0000000000C8DDBD,
+    0x76BBDD8257EC008B, 0xB36C9D0E151C47FA, 0x492F94EE298DEC44, 0x00000000001A47A7,
+    0x0CB548A946F76327, 0x00D17DF639962ED1, 0xE808F260953AC3BA, 0x00000000008E8D12,
+    0xCC622A29002101E4, 0x154C5A4F7AA3D1E8, 0x68AB09FD450A2702, 0x00000000006B16DD,
+    0x476784D43C007A61, 0xBF8019298A25C39D, 0x6EAEB16D817E6951, 0x000000000059068D,
+    0x483DA8CD89B86050, 0x5AF7BBB4F43B2082, 0xF3815F5F3AF279AE, 0x0000000000C8E875,
+    0x21E8253FB5D9F231, 0xC4F8F1F7FBC35CDF, 0x336736E4408CF940, 0x0000000000F3A3F9,
+    0x816633C5D8BA17DB, 0x7DE05E1D0580194F, 0x6DCC3F63585BE68B, 0x00000000006A31A5,
+    0x30F0D06E6D252528, 0x24F4EF039DA2B0C0, 0x6E606945060DB8B6, 0x0000000000C34D35,
+    0xDCCCF36B4460E445, 0x59E686557A80AD2B, 0x4DF7E0F46C55101F, 0x00000000008641A5,
+    0x575ACA42B2E602A0, 0xC476F34C42169EED, 0xD6ECC2D1643B7C5F, 0x0000000000009200,
+    0xE22232EF89BCB95F, 0x618C888D9F2D8048, 0xD67C298F016EA85F, 0x0000000001025FC7,
+    0xB7BE46CA9B56011B, 0x57DA5A20790AB3B3, 0xA6995395FF913875, 0x0000000000F63344,
+    0x0BC9E2526DCF71EB, 0xB6B1060A7DF0B099, 0x1258CDECCC0275DD, 0x00000000010681BE,
+    0x32FF5CFE98CDF653, 0x2EE8A8A6CB8CDF17, 0xA554D80F620817CA, 0x0000000000385BDF,
+    0x71E464F092A676DE, 0x467F42756ECE6AC2, 0xE2B99AAD6EA24023, 0x00000000001C7C12,
+    0x2B5D384FE26D551A, 0xFE5CB0A1A67411D6, 0xC92D7FD01EB633C4, 0x00000000001EB322,
+    0xEDED4D4E947C18BB, 0x3A1612DC9C254185, 0xDB34C08AD557B2DE, 0x00000000004FAD0C,
+    0xC4A7DD7A34A7CFDD, 0x2EE9F32EFECCCA16, 0x2B5F7F1F3BC07918, 0x000000000109760E,
+    0x2B581D27FF09B0F3, 0xD3E62FC6B3930FE3, 0x280B0D360D58C5B4, 0x000000000061F65D,
+    0xF4B0944C508BB97E, 0x7FD731D1DAA43E4C, 0xE1363D69D3700D5C, 0x0000000000AAFDC0,
+    0x93A3E8869D64D3A2, 0x585B931FDD0BADDB, 0x9A78FDA912E96B79, 0x000000000048E161,
+    0x237E7BFB85659B32, 0xB39669194EA39ACA, 0x4F6C2B648B670709, 0x0000000000B695E8,
+    0x1E475EECC2DA6C6B, 0x1C691623F6105ACE, 0x8D4EE12926706317, 0x0000000000D1322E,
+    0xCA65310624D30240, 0x84EFA0EC01DC65E6, 0xFC5E34D3285BD890, 0x00000000002A135D,
+    0x26971CB0DC21F08B, 0x3CF04715E3D759AA, 0x9A308E4E869B70B9, 0x0000000000D1DBE2,
+    0xBC6001BDDEB5A1E3, 0x56D789ECCB0E2AB3, 0x14E49166ED1568B0, 0x000000000119D55A,
+    0x9B587561CA9CFF2A, 0xAE0A794D53162435, 0xF484E703D147FF6B, 0x0000000000824CE1,
+    0xE4DF4EADC7FB6C63, 0xE75DF38EF018E59C, 0xD6C345E8F403DAFE, 0x00000000009A6002,
+    0xC71522839A8281E4, 0x705CCB1443F42DB1, 0x1B274772236F36A8, 0x0000000000049945,
+    0x2B681FB5CD9FEA30, 0x5E0BE3D4B0C2148D, 0x305264DC5DBB3006, 0x0000000000F1016D,
+    0x1F1193C840F99490, 0x8D6A8500E5F9E3BF, 0xA8A83E42F0978093, 0x000000000050BC5C,
+    0xCD8FD12A5090A4CB, 0x86F0DA9A0392F133, 0x8612925A5E446FD8, 0x000000000075E413,
+    0x0F96EC4C1345C5F0, 0xFA82B4120D574188, 0x3AFEB6E239419BB8, 0x000000000012B184,
+    0xB9711EE26710971A, 0xCA50F20C3A86B1D5, 0xFB274BF1D672914B, 0x0000000000C6C6F3,
+    0x08F8792C87EB6F99, 0x0204AC33399B362A, 0xE6027EAB454EE3B9, 0x0000000000D46D66,
+    0x055B8A7BFA05CAB8, 0x252DE81CD152A9FD, 0x527C2022D4F1EC17, 0x0000000000D72100,
+    0x9D25732409B0E436, 0xF641344B6BABA2DF, 0xC2666890F44A7264, 0x0000000000D46EE0,
+    0x242B72B40B714DCD, 0x3B00AD9999B056D2, 0x4122AF6AAB913CB3, 0x0000000001140A83,
+    0x1875BD337DB0F48F, 0xDFD9462905DA0C5F, 0x9A7D58E32D7D9C35, 0x0000000000A786AB,
+    0xAD7AC3C7478EF634, 0x157BF9708FFAC62C, 0x5A8601CE93DE0C10, 0x0000000000E8CF73,
+    0x71CBFC062B6920C9, 0x3632EB3D8AA101DE, 0x34D3A8D9D8AC3D90, 0x0000000000411564,
+    0x4DF94465742785AB, 0x733D967C47F7493D, 0x97B2873589ADD8C8, 0x0000000000F01435,
+    0x313353DAEBF74E7D, 0xE68B3CA21B038A4D, 0xFE56C4A30AEDE41C, 0x0000000000ED77A4,
+    0x4EDD80FE792BCFE5, 0x728C853F6B800E5F, 0x676400E416F76921, 0x000000000066D6D0,
+    0x0F713623105A5545, 0x6DAB9D7FFA98C20A, 0xEC0D3C785F769975, 0x00000000006D31A2,
+    0xAE251DBA48E9BFF8, 0xCC6AB260D6BBC8F3, 0x54334D9BD55C82E8, 0x00000000002F3C9F,
+    0xB8D854E14EDFFE1E, 0x2ABE3A87A0754A0F, 0x6CA0113B36D94566, 0x000000000024B0B6,
+    0x36BF6C552C359244, 0x53FA064F99DB48F8, 0x74E6CFCF0202BA7B, 0x0000000000E208BA,
+    0xC69C3F02AB988D9C, 0xC57B91D924616E5B, 0x5B4F0ADB4E0D27D1, 0x00000000000B40EE,
+    0xB07944BB6C5BDA38, 0x610C563C38C70200, 0x5902E88E39A2504B, 0x000000000120F123,
+    0x8404E6B76BAB75F3, 0x9B883ADCC1EA3EAC, 0x8D675828B4239F5D, 0x00000000005ED3DD,
+    0x724FE1A9843762E6, 0x3A6D8884FC9871E9, 0xC068FD37A824EEF6, 0x000000000027041D,
+    0xFBAB4FD372E1F3DD, 0x5D619B94EE846E1A, 0xAE54DEDFD784572B, 0x00000000005FDF2D,
+    0x3145278FB471FE47, 0x0E5A4BC6771AF24E, 0x71CEE474AF695EDB, 0x0000000000946BD3,
+    0x0FE5B5EB45F19EB0, 0xA24AC4FCA74D2B0E, 0x78F6D270987AB1B8, 0x0000000001035BC4,
+    0x4336AB14D1701099, 0x38350FB2C18018DE, 0x8DD8345AEFABFF46, 0x0000000000F35EDE,
+    0x8352E0C8508F57DE, 0xE57802999C6E15A3, 0xDB843CE6956C72E3, 0x0000000000AD7C94,
+    0x638FE56A617C64A7, 0x163297F5DB79EB8F, 0x128107C0C96BCE93, 0x0000000000C87FAC,
+    0x0C6ED42C414A0060, 0xED1C1BD1215CE085, 0x102325FC774D7C35, 0x00000000001737F6,
+    0x618E148D70AAD222, 0x9E14E70CE6806FA2, 0xC8BFF964C955336D, 0x0000000001075A17,
+    0x9ADFC6C34DF4F5A1, 0x8432FE850FA7232F, 0xE3A0725F07FE8679, 0x0000000000EF5946,
+    0x4B81ABC57E64F43C, 0x078A143E8E65E512, 0x21A3553E202D576A, 0x000000000023A2E2,
+    0x9C50F82DE9EF068F, 0x54B057FA37BFDD6C, 0xAA1FCD8C756EC470, 0x00000000001F00F1,
+    0x12EEAB9D14D03FE1, 0xD0D697B4D585A700, 0x09D72E9052E1093F, 0x0000000000F1C63E,
+    0x09868CB189885652, 0x9C73EDE78BAC6D39, 0x113CD492D8508B7F, 0x0000000000C945E7,
+    0x498BBC1F52E642ED, 0xF9B7907B8C320431, 0x74F2B59308B04058, 0x0000000000E552A0,
+    0x8894A969EBE1E08E, 0x9F13502163D55DAA, 0x4A8124B7953EDC51, 0x00000000000F7C42,
+    0x7ACA6B7B24C348F8, 0x23895F6C2B49492B, 0x810E4796AEF1E829, 0x0000000000F87332,
+    0x310CF0AE34BD7317, 0xEC5431C4D288813C, 0xFC12E882820F3743, 0x0000000000970D64,
+    0x309BAAA22467132D, 0x93956087437D4B24, 0xC24BDA10FDC4C7BD, 0x000000000108D213,
+    0x5EAC59521A33164C, 0x06D1968BD332EDA8, 0xAB7962F11B829A12, 0x000000000089E795,
+    0x734917971FF39C76, 0xEAE9D2FB1D65D7E8, 0x1851EBFB6574361E, 0x00000000007F7919,
+    0x8B6A265232E116C0, 0x92E2A0EB60328FA9, 0xB66136ABC5495CC8, 0x0000000000291D5C,
+    0x6E92C15C9DD2D3E5, 0x9E8A7EA2E7EC0D5D, 0x4A9490D66FDE8713, 0x000000000018F0B4,
+    0x07FDFE74F5AAC864, 0x5A06440381AD5C46, 0xD2BA3C048862246E, 0x0000000000E4633B,
+    0xB2BB7EDC31F58B31, 0xA222803E722A642C, 0x74082365BE65AB85, 0x0000000000EE2116,
+    0xD1BA26CA8928F4ED, 0xD8EF12B6FEE94939, 0x8B4A3810E541DCFE, 0x0000000000969F0C,
+    0x8E7BFF8A68E0EFB6, 0xDEF1475C03328755, 0x828051B8EDF992D2, 0x00000000005CCE30,
+    0x4E7638F3F8B4AA5D, 0x2798A9FC95824AC2, 0x40448155686A2DC2, 0x000000000070A4DD,
+    0x4D421DE9B83C42D2, 0xF261E08E3049FE8C, 0xE1880192EAD9F4EB, 0x0000000000825DF8,
+    0x57DD372B1DBCA572, 0x440BAE07CE042847, 0x9C60ECDE43AEF378, 0x0000000000D3F51E,
+    0xC87CDA520EC4164F, 0xCBB6F6105DCEDA93, 0x560C72CA238970CC, 0x00000000010A63EF,
+    0x3D910EF8183B76A7, 0x0289953C7A75E35A, 0x8C2D7EEDC085D368, 0x0000000000D8524A,
+    0x3013EAE39D89C332, 0xCFA9184BFC719C95, 0xEDF9358F52CAB3DB, 0x0000000001091A02,
+    0x699FC3ED24BD6875, 0x4FA08EDD3FB28258, 0x3168B7FEE8D7FE65, 0x00000000008E9CED,
+    0x9CB81CC584B38ABD, 0x5CDD5ACC53A971F1, 0x763CEC4E44CEF14C, 0x00000000010453EA,
+    0x884692BF516054C8, 0xE7475AE0416AD766, 0xD69AB7204508A61E, 0x00000000002AF2AE,
+    0x5B0C2510DC3D1177, 0x122987926688AA22, 0xC0031A9B34043715, 0x0000000000822B37,
+    0x6191F85A413BA155, 0x9BA2CF6084092ED2, 0x8EF6727917B08649, 0x000000000087ADB9,
+    0x90859B6572B1C15A, 0xC9C48310401EE1BA, 0x6AFDFD1B5338E48F, 0x00000000006F21D6,
+    0xCF6EE99A358C93DB, 0x6AF8362FCD631E7F, 0x34CF41299D05793B, 0x0000000000F03DFE,
+    0xC6A0E0F3871ECA96, 0xDFA19AF93935C788, 0x3380A0F07764CD04, 0x0000000000CE3504,
+    0xD39654E14ABF34EC, 0x442FF16FCDDBC4B9, 0x9587A793E0DB4816, 0x0000000000C49862,
+    0x3B537FE11BC3B7E8, 0x21C7D1263068F69F, 0x370D873BD91EB3D9, 0x000000000077CECD,
+    0x538D58DF7BD8176B, 0xEA5B139B66387A42, 0xFCBD694189362BC7, 0x0000000000D24E7E,
+    0x240E4EE513D2270C, 0xDD7BB65BA7170149, 0xB8E0DADA4186F175, 0x0000000000F72C2D,
+    0x73C646F3500C8823, 0x1E4152C40D5679D2, 0x7B63931FA6C496E5, 0x00000000005C26E1,
+    0x7F616BFFA8229686, 0x14F7828993CF111E, 0xA79513C7186E40D0, 0x00000000005D68C3,
+    0x9D8370C7241DF8CB, 0xD37E24D1EC76DAF3, 0x46CC29EB04C7073F, 0x0000000001162969,
+    0xE02C4F4A61F529FF, 0xBACB886B33962BC8, 0x86E2F8696EF972BF, 0x00000000006F8D21,
+    0xF1BED45F16037B01, 0xDA6CF577B7677680, 0xCF75E2B6EF6DD7E0, 0x000000000057269A,
+    0xDF0D3690A599E382, 0x45B67CBF0D9770B6, 0xDCC068993E7275EE, 0x0000000000014525,
+    0x0611DFFFD59328AC, 0xA731D4C975004DB6, 0x539ADE34A67534A5, 0x00000000007059A8,
+    0xDA65C74B6D8CEEC6, 0x7D34343B154A203B, 0x79857FB0C425E6ED, 0x0000000000173F6F,
+    0x60BBAEBDFA23F51D, 0xC2239DBFB200B142, 0xB5226F64227B7D7F, 0x00000000006D7834,
+    0xCCBF194C1C11739A, 0x480A5DF65AF567E9, 0xD70756B838E93A92, 0x0000000000724F15,
+    0xA89EA9C52FE55D53, 0x073368940C304147, 0xE1CB11C3A6840A97, 0x00000000009D4608,
+    0xFB1541CC8EF052F5, 0xC68ECEDC6BC4E774, 0x4562DA6B3C50ED7D, 0x0000000000CF304F,
+    0xBFF1C1C543DA77E2, 0x3DA4A3C9C9D79FC7, 0x0C70983C3F133169, 0x0000000000BE3E00,
+    0xA7AE00B8C000814B, 0x2DD3D9C88835623B, 0xF5424EF0A6F3C254, 0x0000000000F8692F,
+    0x3E0D3D6B2AB50208, 0x9EC761B7396E57E6, 0xEA8C6CF8AA41FB07, 0x0000000000A374D8,
+    0xE0DEA0ADA7C335F1, 0xBB70A510097F7DCD, 0x85E14757AE1A52EB, 0x0000000000027D76,
+    0x5B4B1DD0FEA73D99, 0x0CD3EF5E9D2749E5, 0x91691C67AE6EAA02, 0x0000000000D2F369,
+    0x4FFB709BBDC87CC9, 0x1ADFDA665D6C102B, 0x71BC8F7A67A745E0, 0x0000000000513FF0,
+    0x75102F51A7BDE64D, 0xDD38935E15A2EE7A, 0x7CC20EEFF25CA576, 0x00000000011D2F61,
+    0xE610942E785F7BF3, 0x2C88AF709D570F63, 0x618E9AD6B614ABCA, 0x0000000000EB1F5C,
+    0x82C9AB752383DBE5, 0xC683D7E83C04CFA9, 0x97A5DA52572D60D8, 0x000000000033C610,
+    0x552C1AFCF37621B6, 0xB2F7B3553DDDCBFB, 0x9B2BCD589127B839, 0x000000000009C741,
+    0xCE579172AE5616BB, 0xF51CC5C1E382591D, 0xF2B3559A26A60942, 0x000000000090F7B3,
+    0x59748693449E5AA7, 0x7CCAC5C2A601B5AF, 0x467B92E0DC27515A, 0x000000000080985F,
+    0xB355656C027BB77D, 0xF7AF2C5BF567D487, 0xEB9D5D9C3E76E7B5, 0x0000000001089869,
+    0xDE222D8C52306E74, 0x30570EC8B59AF088, 0xCF02710DCB7DE140, 0x00000000000C0CFA,
+    0xB92A2F3B4DD2F9A9, 0x416C1593335BC3B1, 0xF5A504C30C2C3461, 0x0000000000360D99,
+    0xAB3204F86A38AE98, 0x78C9B110049F64F5, 0x8E01E36BA45818C7, 0x0000000000DBA17B,
+    0xC634702158C0599B, 0x4D192ABD1335A8D7, 0x0FD2C043A4CF695A, 0x0000000000511A15,
+    0x9E10F0A88DDBD313, 0x357B06546A5588C1, 0x68EAD26A6B18F742, 0x0000000000C4645B,
+    0x9D8AF702C0CC084F, 0x06D7771278D9459C, 0x74DE239B33A82287, 0x0000000000613E96,
+    0x46F2829D236BA10D, 0xE04262F7B2220CA4, 0x6129F92A773C4B37, 0x0000000000F7AFA5,
+    0x6548B6FEC55B3DDF, 0xBDA7AE61BAE986C3, 0x32674E12F7EAFE3D, 0x000000000039C051,
+    0xFC345070B9BA5B8C, 0xB021A25DEB86F122, 0xB4092727B95307DE, 0x0000000000591400,
+    0x4BA9B6565EAB7318, 0xAB890C9750E30ED4, 0x20B375B295DB3911, 0x0000000000DEB71F,
+    0x734F0CEFD45551DA, 0xAD3AB1D03E632905, 0xDF19A5E9D420545F, 0x00000000000ACBE0,
+    0xCB2AA6F4526E20ED, 0xDDFE8FA84B58A94E, 0x2439EE233333DF82, 0x0000000000ACE923,
+    0x21DF8FCCFC117D00, 0xDB8E983C36B3ABED, 0x69871D146E58669A, 0x000000000102EF21,
+    0xA5CB7BE919B75CD0, 0x8352F82F2E14F559, 0x0E1CDF2665D5EE18, 0x0000000000C69F49,
+    0xEFBF0EE702DC141B, 0x964910848BEA9364, 0xD1EFACF66572CFDA, 0x00000000003B465A,
+    0xA2C5B1C8F9454123, 0xC208F5081969A5AD, 0xFF250A1D072C2975, 0x0000000000241335,
+    0x1A6B10E03DED92BD, 0xA6836B5B525C0041, 0x929B2A236296A076, 0x00000000007EB0F4,
+    0x2FD8786DA3EAD24B, 0xA4FAE33E09E12C11, 0x6A57C5E8A080D522, 0x0000000001208866,
+    0x9D8920BC98CD5E85, 0x79702FBD500BAA35, 0x0C908333F5A5AB93, 0x0000000000B51A10,
+    0x65DA9B8D63C55A15, 0xCEBA1E4E20022117, 0xC28C7A0E2DCAF642, 0x000000000016D68E,
+    0xF1DDC41B3AFB31F2, 0xB5F8F8AAA4C1DEDB, 0x43C8E9FA9922F2A0, 0x0000000000EF7575,
+    0x26856CB720FCDAE0, 0x3841A66AE10B314B, 0x6D0B527DEBD3A13C, 0x0000000000097C2F,
+    0x89672E955B2B9499, 0x547B6ED9057F08B1, 0xAB2B0927A52B3564, 0x00000000006EF15A,
+    0x5F265511A1E704A9, 0x133E301405256CE9, 0xAC171CE89B26DB67, 0x0000000000A99D7A,
+    0x48E205CD3DBF9DFD, 0xDEC204F179DBF022, 0xDC1806BAEF21754C, 0x000000000074EEF2,
+    0x6B34E1F660429581, 0x5E7874C89E7B8C7E, 0x5FDD2E3279237159, 0x000000000062C2AB,
+    0x2B066AAEA9EFFB10, 0xA9E72DF5C6CD0C96, 0xF8106CB1F64811B1, 0x00000000005E088E,
+    0x37C29B785E8A3B67, 0xC2363DABAC69845C, 0xDAF3AF2A2A5E8C68, 0x00000000007C985E,
+    0x76D00CB9C9E8F0EF, 0xCEEE343EFAD30067, 0x723565D880C8D09C, 0x000000000098A9F0,
+    0x3DEC1CE083F286FD, 0xDCE14DEE48BE6585, 0x85E1FED64DD7B893, 0x0000000000736598,
+    0x5D5037F109736B93, 0x8F6067A4C7E4D7E3, 0xB19F30995965E372, 0x00000000001A9F11,
+    0xA7B0D79A7C7E0886, 0xAE4111A2CC3B82CF, 0xC03F02A148D0C72C, 0x0000000000A81CBE,
+    0x5335FAD4C4A19A01, 0xE80B2CEA24045085, 0x59542485140F860D, 0x00000000001EB223,
+    0x1B9121545850230E, 0x5059D135D5056B3B, 0xBFA470DB34EA1ECC, 0x00000000004B08F1,
+    0xDD458F6D8B2E4076, 0xDFC0E9611939BBB3, 0xFE54C9C8917CE590, 0x0000000000D0FC4D,
+    0x880757D25F840F37, 0x9FC8136C3A3087D6, 0xECA1FD418E5E77E0, 0x000000000015D284,
+    0xFA93BE1B7CC352ED, 0xEDBF787DB3E9122B, 0x6A8ED3048B02C130, 0x0000000000D302D3,
+    0xD2D39F40A7985BFA, 0xE68B11E3A5CDE175, 0x3D75EE01265EE16E, 0x00000000006DCD70,
+    0x55B052025B69D24E, 0x09BCA0037394DC54, 0x1421365BC94A953E, 0x0000000000018981,
+    0x4E90CC6205503A13, 0x4AC93FA7ADF26BE0, 0xE2EDDCB30194D729, 0x0000000000365965,
+    0x853C2ADA47FC1D8E, 0x9BA914809FA7B013, 0x699BAA4A7614749A, 0x000000000007307B,
+    0xF90446C048C1AAE2, 0xB0EB5B2213670E31, 0x10796C8204FB9714, 0x00000000004E68D9,
+    0x293E6C59D7252CAB, 0x2985D9D75DA937C5, 0xB92BBB304E8A7466, 0x0000000000E61D20,
+    0x5AA4DE5F8EB35F92, 0xF1079D12875F30C4, 0x512E59BEADBA6AA9, 0x0000000000402666,
+    0xB78EA0178D09BF25, 0xA9A2513CF69043EC, 0xC44F2033081E8D71, 0x0000000000F0CB63,
+    0xD707572C8598E0B4, 0x462628529246AD1E, 0x8A72CC071A715729, 0x000000000112E1C2,
+    0xD12FE8CCEB3BFDE0, 0xF6A360D659137222, 0x4266DAEE5C2BE384, 0x0000000000368695,
+    0x4323EF0F5737A100, 0xAA0F725DD4DD4A42, 0xD69EBCF78F76CDED, 0x000000000006F887,
+    0xACE8A7714BF2C7FB, 0x246E6113252A53B8, 0x830AE10AED6AC4AB, 0x00000000005FAD23,
+    0x3809BE9D362E9A8F, 0x07BAF2C0CCC4AFB0, 0x89EEA2B08C306205, 0x00000000008D8054,
+    0x3501A5555239F659, 0x75B9F60199B342E5, 0xFC579AD3FA46B877, 0x0000000000406297,
+    0xA26F074BB7DE27C0, 0xCB045EB54536698E, 0xC4010F8637FE7535, 0x0000000000652E24,
+    0xEC8FA7DE786B60DB, 0x4E8CF5DD6384A096, 0xA58ABF11B3104725, 0x00000000003F5280,
+    0xB0EE623E4F9ABDEA, 0xEFB3EF75F42ADBFA, 0xB0010E39F970B5BA, 0x0000000000A9FCA0,
+    0xBFE3046A7E8919CB, 0x6853A5D5D189917E, 0xEB801104D8CA6E95, 0x00000000008CE1B9,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x000000E006430584, 0x0BC5000000000000, 0xEDA1260B181CA0F5, 0x000000000011177F,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000 };
+
+// Affine x-coordinates x(2^i*QB), i = 0, ..., OBOB_BITS-2, in GF(p^2), expressed in Montgomery representation
+const uint64_t B_gen_dbl[2*(OBOB_BITS-1)*NWORDS64_FIELD] = {
+    0x12D77EE866B12444, 0x186BF7903423F87C, 0xDC061C02B9F702FF, 0x0000000000491891,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0xF68B69054FEF00C4, 0xB7499A72861DA35A, 0x69F6E2312C78B9AB, 0x0000000000E73955,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0xC0A10661B81FDF4D, 0x42FF44E11B5B5B01, 0x73DA57FB16A7457F, 0x000000000119BD69,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0xCB9BDB5259ECB3C6, 0xC8BDB7996FCDEF3B, 0x095B0B0C449A6BBF, 0x0000000000439009,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0xD3D6154D9E0A7595, 0x9E435E91D3D4A61A, 0x6C923CE471D40D99, 0x0000000000A8F97B,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x635BAFAA459E2682, 0xA2CC809E066075C7, 0xAE860DDA25E12D22, 0x00000000006C2E38,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x918B7DDD5F75D688, 0x12E235FB3C90566E, 0xF6F75C8DAF95185F, 0x0000000000DC5C1E,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0xC87CED3C3DD3D55B, 0x9ACD969F1B45692A, 0xA8B2D78FA776A29F, 0x00000000001A8FF8,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0xC09CC3E1FD06E4C3, 0x5A3D083CEE5729BA, 0x06D6067FD4747876, 0x0000000000636E54,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0xB2131586C62A0211, 0x54958A175C79A4B6, 0x6133E8860CE7C5B4, 0x0000000000C5C1F1,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x54FAE2A9668E3F7C, 0x7DE60B134735271D, 0xD0B541572F23C973, 0x00000000004B48D3,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0xE2B7C8492BB93137, 0x4FD63BE7955BFFBF, 0xAB7BFF53573DF9A8, 0x0000000000AAA635,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x504DD7CDD16E6FDF, 0xFD45BD1964A1094F, 0xA9AB1793C7FCC943, 0x0000000000DD2397,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x29A13B7426ADA5E9, 0xAA5083874495AFD0, 0x7040F5A0EC775480, 0x0000000000BC5D03,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0xBDAF8485DBAF84F1, 0xACE8DDC5473149CD, 0xE7FA6DFCEF67FCA7, 0x000000000044F81A,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0xA65987458B07ED6A, 0xB81D10CA2AE87963, 0xD054E8C2CA3004C6, 0x000000000050E022,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0xF64639CF9EAD6A11, 0x857ADF80A0AEB664, 0xC581C2A4975A8C89, 0x00000000006675AB,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x66614D395D7457C5, 0xF4C3A1E3321908EC, 0xB995ED6CC7218940, 0x00000000000B8AF7,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0xBFF799E7AC0996B5, 0xFE0489BEF010BAE4, 0x71BE1EBA6C7A46DC, 0x0000000000A78198,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x11372268D47E5963, 0x9882224988FF4358, 0x6172B04D2B01EDF9, 0x00000000006D6205,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x1621513501FADC8E, 0x49E973EEBB2C0E2D, 0x4BC7CA5757B3CBBC, 0x00000000002945CE,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x7482381E131E013C, 0xC7D5DEBEE82249D8, 0x0DB035D330123AEF, 0x00000000002D9664,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x878DE9C9426524A4, 0x37C86E34D460338E, 0x55D5094AE7A2DE72, 0x0000000000B16D4C,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0xA679DFB3D2096AA3, 0xE632E9372B6127D2, 0x713F18CBED18DE44, 0x0000000000DBBE94,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x9FECD90FBCCB5494, 0xB8BE46D1D3DDF375, 0x81F19A1DE8CC7FF1, 0x0000000000928804,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x93D257A6549CE8FF, 0x5B2008BA29A878DE, 0x4CDA45E8C29D83C2, 0x0000000000E78258,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x427D74F15CBEAA33, 0xBA02045D15D2B7FD, 0x20D637A15B8AFF1F, 0x00000000008F7962,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x53DBBC81C89AE87D, 0x61CDBA7CC33CDC7C, 0xCA3BB98AF9C2734B, 0x0000000000362821,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x92AEDE20E30A9AA8, 0x32A898B7114CF76A, 0x9F3D0A434280D644, 0x00000000001F5ED8,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x5F8D34D45A77836B, 0x189BABEB3FE67E80, 0x52A7B7013C5B0A16, 0x00000000003C2844,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0xE8F7796D2F2580AD, 0x22BCB120DAA76C36, 0x3141A1FC32BA4F73, 0x00000000001B74D9,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x705599497A20EFB6, 0xD8B1320C9B5A5330, 0xC90960FF0C62FFA2, 0x00000000006C5D6D,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x8D03A4791EACFD12, 0x9F80999A5B0B936C, 0x781FD5647E90BCB1, 0x00000000009107A9,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x9E5A03A95DDDAA92, 0x67E8C4EC1C2E2C87, 0xADB9231A8E45EC49, 0x0000000001108C31,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0xF480DB366E7AAD53, 0x0E5CF79590D557A6, 0x79624C70FFD134F4, 0x000000000052E188,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x676719B6131E9FD8, 0x8B804D9368782D41, 0xD08E16EB463CBB74, 0x00000000003E8F60,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x5D99DC61B8CC9D83, 0x872300A2B2397401, 0x5F825E1982F947B2, 0x0000000000F13BFA,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x64026D321C49C799, 0x144D1ADCDA1E2141, 0x8487B1C242DF32C2, 0x00000000000655ED,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x23DD3A7E8FB9510F, 0xD25E7209DC437872, 0x54D73653BCCB65AB, 0x00000000005D932C,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x63D2DB1EA4D31902, 0xE9A19B5A8B638E60, 0x23060EECA4CC8FA9, 0x0000000000A5977D,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x82ACB53F473930E2, 0xB94F18E2972C1DE9, 0x35FC7291A95386A3, 0x000000000114F478,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0xB98CE20DF1A0610A, 0xE38D65D0409208A9, 0xDA373E4ED81DAF91, 0x000000000058B7F9,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x8EE066D37B74BE28, 0x649FB3E0609ECB39, 0x02C6AE025FD25F1E, 0x0000000000FF65DF,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x7D50A733BD109027, 0x9F6A2DF2E2BD6B32, 0x4BE0FB316A15ACB4, 0x0000000000C35D06,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x375F8B3C508BB996, 0x420C508A3F5CB67E, 0x6B5F2B087B650574, 0x00000000001FB6E6,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x7084F403A1A27CC4, 0x46CE3CC2ACCBB895, 0x7A38A682E1E924BB, 0x0000000000AE1D28,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0xA22A9B17340B4EB5, 0x5322DD554AEADB3C, 0x04C4DD2E6139D2FF, 0x0000000000A380C2,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x033D3181AEEE9774, 0xB4206002A4C07115, 0x773004DB5A93A92C, 0x0000000000B87B9B,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x74E24E0C70C4C20F, 0x92EA336BA011FD96, 0xF9BE8EDC66FA7A4C, 0x0000000000F4D6C9,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x3211017CD3557646, 0xF988CBCE814F6C90, 0x456B26DC54A7C69F, 0x000000000066A1C3,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x1415B5F74EBE1B9E, 0xE1F5B7CF5486DAAC, 0x0AAFD2726B0B00C2, 0x0000000000DAC0A5,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x8CBACAE057DC243C, 0xF2AFA211A0DBA937, 0x99AF9F29E69DD681, 0x000000000083ABFF,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0xC4E6C866D051CE8A, 0xEA9476785996AB53, 0xF6AFCE51C2F62E52, 0x0000000000A85108,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0xA26DE2F5C0AA5F00, 0xC8F563C91DDA62B7, 0x1244F2F094F6657A, 0x00000000007B37C7,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x28AD086678A9D093, 0xED665CAE6CCBABA1, 0xE5468B9D590E248E, 0x000000000070AC2F,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x10984D06283BA69C, 0xB0D31FD6C352480D, 0x18D4222EF17BC9BC, 0x000000000066B7BF,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0xC2CEF64ABD4C7060, 0x9A7390D75E4173C3, 0x01F0F0885CEF20E7, 0x00000000006B066E,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x83D025B2ECE76DF1, 0x9139170768856578, 0xE90000C35CAE4B5C, 0x0000000000E90445,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x6E3BC2B020C3FD60, 0xFC92B580DE5D2503, 0x4F9C7F52A509D653, 0x0000000000554DCE,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0xD5832D2D3CED4B2C, 0x76A28CE4D8659C01, 0xC7CF1F50230185C3, 0x0000000000DC3319,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x336B5440A15BBB0F, 0x2EA58ED86746B36E, 0x46BE4CB0A4947D6D, 0x00000000006AAFB1,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x50377EF86F1BA065, 0x85AC30E6CA52DB5C, 0x4CC2376B68E9C730, 0x000000000022BD5E,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0xE1BE7620361357FB, 0x7532BC14EBBF7E68, 0x41186EC4002EEF3E, 0x00000000004EAA99,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0xE5290CC68FBBAB7E, 0x4F35EB7C8B1D4143, 0x92CC67294886831D, 0x00000000003FDB47,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0xDCBBC26D9506077C, 0x72CC0242AFADC46E, 0xC95435A306FB8028, 0x0000000000455192,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0xFA5470A6853A6EA5, 0x2B857A4642E0FE19, 0x8DB1ECA3B1449094, 0x0000000000A4AB77,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x661B62AAB800436C, 0xBE66F041AF04AE79, 0x9E594E5071DFA82F, 0x0000000000C4928C,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x4F1A9A7439011FB1, 0x708EA60A7AAE46E4, 0xA08DBA80A83021A8, 0x0000000000DA29B8,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x9F90BF39E2FC2D03, 0xFE357F7DF88C8975, 0xC0782171E7EB8A91, 0x00000000008F91CE,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x4B49D4660659A98F, 0x60FA4865B91BD459, 0x5A7A5B098348CFC9, 0x0000000000E91ED5,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x7D780E900BCAB914, 0x84025320A6749EE2, 0xC46804E5076C2EC0, 0x0000000000B6A7D6,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x52A53F5D7F926C7E, 0xA4E652F56C59CB5D, 0x1DA43DA4C67DB9C5, 0x00000000005EB2C8,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x5EA3E5735940D721, 0x6C5A8F12A0C48A9A, 0x40A882DA386A0340, 0x0000000000E29795,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x0C12F502CD91B348, 0x5AD5EF13FB6C64E5, 0x65FDE7AD9C3ABFBD, 0x00000000009CCC3B,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x8E2E039149931258, 0xC7902DC256AC8E64, 0x1D2A1B6A122F2179, 0x0000000000D9ECEA,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0xA7F4917B5EC7E901, 0x3E575C24C6963DA1, 0x27E65C41BFAD621D, 0x000000000000C66B,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x1F26C17BEA014BD2, 0x2AEDD51D35ACF42C, 0x95092F60F1DE9B6A, 0x00000000009DC338,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0xAA31EE6F5DE7AA59, 0x6C437527702FDD71, 0xD44C2A62A52212BF, 0x0000000000FD1D48,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0xB8A337F74A47F21D, 0xFE36594E16BBC079, 0x10ECA26222A23FFC, 0x00000000004DC675,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0xD55674B9419A4895, 0xD6C30ED989331259, 0xE2889A9D78A4E0C2, 0x0000000000D29FE4,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x8EC63A384E121745, 0xDBD3D05AE126E898, 0xE8B00E262AC07BA5, 0x0000000001129EEF,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x22AD303341815D99, 0xFF1A0F1F35B05B85, 0x82D9C49E839B9F90, 0x00000000005189A3,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x7886DE0396E9AFA0, 0xC8BAAF511CB00E2C, 0x594C702F27B8172A, 0x0000000000A05F80,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x0194D1B18AB6EB9B, 0x4E5EAD99905902D8, 0x71032CD806706C3C, 0x0000000000984ED3,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x1C5984C9B1C0561C, 0x948055F7618DD645, 0x23D300DC287560DF, 0x00000000003856BE,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x33F866B84B451602, 0x711BD3E727667589, 0x32E218F88BBF28F4, 0x0000000001148F30,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x4BE777E2FBCAB325, 0xF1A613DD1487C469, 0xA0572417647D8C71, 0x00000000006FFF4C,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x511248EA50544C5C, 0x159498923E0F91EF, 0x98D5C5892643916E, 0x00000000000B724C,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0xF0FDE15086178E5F, 0x3CE9CF58F10B9448, 0x03C1EA24D8682F43, 0x000000000017B9BA,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0xE9A31DE89D6FA9D5, 0x9DB9CE3D8E032778, 0x38DF1CD2B3BD2DBE, 0x00000000007542B5,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x5B905E3B5A3D2542, 0x900405F204883D8E, 0xA003B1249ED0A6DC, 0x0000000000E6FF1E,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x2B04E2ACD261B882, 0xC6010314B5BCAB64, 0xBBC7F3D9ACA601CA, 0x0000000000705E2A,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0xF2C87873C17CBE01, 0x73426357475F5757, 0xEB77564A5B7A69B4, 0x0000000000CF117B,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x6855A7E427703564, 0xC23F95E7DB7E80D7, 0x9129CD8CE5551AA8, 0x0000000000F50D14,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x752E6E6C85565443, 0x0A6C15DC92DC0F0B, 0x56EEA3D7664C8445, 0x0000000000DE678D,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x798FC9FEA8E58B4B, 0xEC89E267F1B02AF8, 0x342ABCB5379F1B14, 0x0000000000C98D43,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x43D5BDFB14C8AB5D, 0x12CBE707DF3EB4E1, 0x56640B355740BA51, 0x00000000005FA650,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0xEF65F7BB92ED8981, 0x5ACC6212912F5A1B, 0xCED140F816FFA1BD, 0x0000000000A8073C,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0xEFEA033D0590FC5F, 0x121E604635CC39FA, 0x68AFDD17EB0C19A5, 0x00000000007E5B2B,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x1608288226C3C0B3, 0xDF0A3017DEC8A4EC, 0x9BFE5579A8E468F6, 0x00000000010B67CD,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x1245D014EE6FF02D, 0x130C6AC1507CBE9F, 0x9A722E0B560C5DE4, 0x0000000000B09D1E,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x5C97C6867905987C, 0xA785A9F872D8C0B8, 0xF7C726BF989A95E1, 0x0000000000D7A100,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0xD7E851B74B2EA59B, 0x518048F734F809CC, 0x275CA2AD3C62FCE9, 0x000000000102CEA4,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x70B8BBAB3BAFAE20, 0xF36C4D6165D4CD68, 0x2B9C6BF48DDF62E4, 0x00000000004CA70F,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0xE6C4B2998A7C4417, 0xA32EAFE66B4E5B7A, 0x71993D5639617C0A, 0x0000000000984661,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0xAF34B6D0EFE64912, 0x9905BFBE35507390, 0x2080D3EA43E285E5, 0x0000000000E0AFD0,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000 };
@@ -87,6 +87,7 @@ inline void fpadd434(const digit_t* a, const digit_t* b, digit_t* c)
     fpadd434_asm(a, b, c);    
 
 #endif
+    PROFILE_COUNT(SIDH_OP_FPADD);
 } 
 
 
@@ -114,6 +115,7 @@ inline void fpsub434(const digit_t* a, const digit_t* b, digit_t* c)
     fpsub434_asm(a, b, c);    
 
 #endif
+    PROFILE_COUNT(SIDH_OP_FPSUB);
 }
 
 
@@ -160,7 +162,7 @@ void fpcorrection434(digit_t* a)
     }
 }
 
-#if (OS_TARGET == OS_NIX)
+#if (OS_TARGET == OS_NIX) && !defined(_DISPATCH_)
 
 void fp2mul434_c0_mont(const digit_t* a, const digit_t* b, digit_t* c)
 {
@@ -190,7 +192,7 @@ void fpmul434(const digit_t* a, const digit_t* b, digit_t* c)
     fpmul434_asm(a, b, c);
 }
 
-#else
+#elif (OS_TARGET == OS_WIN)
 
 void mp_mul(const digit_t* a, const digit_t* b, digit_t* c, const unsigned int nwords)
 { // Multiprecision multiply, c = a*b, where lng(a) = lng(b) = nwords.
@@ -501,4 +503,26 @@ void rdc_mont(digit_t* ma, digit_t* mc)
     ADDC(carry, uv[1], ma[13], carry, mc[6]);
 }
 
+#endif
+
+
+#if (OS_TARGET == OS_NIX) && defined(_DISPATCH_)
+// Runtime selection between the portable kernels in fp_generic.c and the MULX+ADX assembly
+#define fp2mul_c0_mont                fp2mul434_c0_mont
+#define fp2mul_c1_mont                fp2mul434_c1_mont
+#define fp2sqr_c0_mont                fp2sqr434_c0_mont
+#define fp2sqr_c1_mont                fp2sqr434_c1_mont
+#define fpmul                         fpmul434
+#define fp2mul_c0_asm                 fp2mul434_c0_asm
+#define fp2mul_c1_asm                 fp2mul434_c1_asm
+#define fp2sqr_c0_asm                 fp2sqr434_c0_asm
+#define fp2sqr_c1_asm                 fp2sqr434_c1_asm
+#define fpmul_asm                     fpmul434_asm
+#define fpkernel_get                  fpkernel434_get
+#define fpkernel_set                  fpkernel434_set
+#define FP_MUL_GENERIC                mp_mul434_generic
+#define FP_RDC_GENERIC                rdc434_mont_generic
+#define FP_PRIMEx2                    p434x2
+
+#include "../../fpx_dispatch.c"
 #endif
\ No newline at end of file
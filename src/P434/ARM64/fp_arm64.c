@@ -38,6 +38,7 @@ inline void fpadd434(const digit_t* a, const digit_t* b, digit_t* c)
   // Output: c in [0, 2*p434-1]
 
     fpadd434_asm(a, b, c);
+    PROFILE_COUNT(SIDH_OP_FPADD);
 } 
 
 
@@ -47,6 +48,7 @@ inline void fpsub434(const digit_t* a, const digit_t* b, digit_t* c)
   // Output: c in [0, 2*p434-1] 
 
     fpsub434_asm(a, b, c);
+    PROFILE_COUNT(SIDH_OP_FPSUB);
 }
 
 
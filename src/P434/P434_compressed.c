@@ -365,7 +365,11 @@ const uint64_t v_3_torsion[TABLE_V3_LEN][2 * NWORDS64_FIELD] =
 #define fp2div2                       fp2div2_434
 #define fp2correction                 fp2correction434
 #define fp2mul_mont                   fp2mul434_mont
+#define fp2muladd_mont                fp2muladd434_mont
+#define fp2mulsub_mont                fp2mulsub434_mont
 #define fp2sqr_mont                   fp2sqr434_mont
+#define fp2mul_mont_x8                fp2mul434_mont_x8
+#define fp2sqr_mont_x8                fp2sqr434_mont_x8
 #define fp2mul_c0_mont                fp2mul434_c0_mont
 #define fp2mul_c1_mont                fp2mul434_c1_mont
 #define fp2sqr_c0_mont                fp2sqr434_c0_mont
@@ -376,23 +380,41 @@ const uint64_t v_3_torsion[TABLE_V3_LEN][2 * NWORDS64_FIELD] =
 #define mp_add_asm                    mp_add434_asm
 #define mp_subaddx2_asm               mp_subadd434x2_asm
 #define mp_dblsubx2_asm               mp_dblsub434x2_asm
-#define random_mod_order_A            random_mod_order_A_SIDHp434
-#define random_mod_order_B            random_mod_order_B_SIDHp434
+#define random_mod_order_A            random_mod_order_A_SIDHp434_Compressed
+#define random_mod_order_B            random_mod_order_B_SIDHp434_Compressed
 #define EphemeralKeyGeneration_A      EphemeralKeyGeneration_A_SIDHp434_Compressed
 #define EphemeralKeyGeneration_B      EphemeralKeyGeneration_B_SIDHp434_Compressed
 #define EphemeralSecretAgreement_A    EphemeralSecretAgreement_A_SIDHp434_Compressed
 #define EphemeralSecretAgreement_B    EphemeralSecretAgreement_B_SIDHp434_Compressed 
+#define EphemeralKeyGeneration_A_ex   EphemeralKeyGeneration_A_ex_SIDHp434_Compressed
+#define EphemeralKeyGeneration_B_ex   EphemeralKeyGeneration_B_ex_SIDHp434_Compressed
+#define EphemeralSecretAgreement_A_ex EphemeralSecretAgreement_A_ex_SIDHp434_Compressed
+#define EphemeralSecretAgreement_B_ex EphemeralSecretAgreement_B_ex_SIDHp434_Compressed
 #define crypto_kem_keypair            crypto_kem_keypair_SIKEp434_compressed
 #define crypto_kem_enc                crypto_kem_enc_SIKEp434_compressed
+#define crypto_kem_scheme             crypto_kem_scheme_SIKEp434_compressed
 #define crypto_kem_dec                crypto_kem_dec_SIKEp434_compressed
+#define crypto_kem_dec_batch          crypto_kem_dec_batch_SIKEp434_compressed
+#define crypto_kem_keypair_ex         crypto_kem_keypair_ex_SIKEp434_compressed
+#define crypto_kem_enc_ex             crypto_kem_enc_ex_SIKEp434_compressed
+#define crypto_kem_dec_ex             crypto_kem_dec_ex_SIKEp434_compressed
+#define crypto_kem_dec_service_create crypto_kem_dec_service_create_SIKEp434_compressed
+#define crypto_kem_dec_service_submit crypto_kem_dec_service_submit_SIKEp434_compressed
+#define crypto_kem_dec_service_poll   crypto_kem_dec_service_poll_SIKEp434_compressed
+#define crypto_kem_dec_service_stats  crypto_kem_dec_service_stats_SIKEp434_compressed
+#define crypto_kem_dec_service_destroy crypto_kem_dec_service_destroy_SIKEp434_compressed
+#define sidh_load_tables              sidh_load_tables_SIDHp434_Compressed
+#define sidh_write_tables             sidh_write_tables_SIDHp434_Compressed
 
 
 #include "../fpx.c"
 #include "../ec_isogeny.c"
 #include "../compression/torsion_basis.c"
 #include "P434_compressed_pair_tables.c"
-#include "../compression/pairing.c"
 #include "P434_compressed_dlog_tables.c"
+#include "../compression/tables.c"
+#include "../compression/pairing.c"
 #include "../compression/dlog.c"
 #include "../compression/sidh_compressed.c"
 #include "../compression/sike_compressed.c"
+#include "../compression/sike_dec_service.c"
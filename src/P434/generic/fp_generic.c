@@ -19,6 +19,12 @@ extern const uint64_t p434x2[NWORDS64_FIELD];
 extern const uint64_t p434x4[NWORDS64_FIELD];
 
 
+#if defined(_DISPATCH_)
+    // x64 builds with runtime dispatch only take the multiplication and reduction below, as fallback kernels
+    #define mp_mul                    mp_mul434_generic
+    #define rdc_mont                  rdc434_mont_generic
+#else
+
 inline void mp_sub434_p2(const digit_t* a, const digit_t* b, digit_t* c)
 { // Multiprecision subtraction with correction with 2*p, c = a-b+2p. 
     unsigned int i, borrow = 0;
@@ -70,6 +76,7 @@ inline void fpadd434(const digit_t* a, const digit_t* b, digit_t* c)
     for (i = 0; i < NWORDS_FIELD; i++) {
         ADDC(carry, c[i], ((digit_t*)p434x2)[i] & mask, carry, c[i]); 
     }
+    PROFILE_COUNT(SIDH_OP_FPADD);
 } 
 
 
@@ -89,6 +96,7 @@ inline void fpsub434(const digit_t* a, const digit_t* b, digit_t* c)
     for (i = 0; i < NWORDS_FIELD; i++) {
         ADDC(borrow, c[i], ((digit_t*)p434x2)[i] & mask, borrow, c[i]); 
     }
+    PROFILE_COUNT(SIDH_OP_FPSUB);
 }
 
 
@@ -136,6 +144,9 @@ void fpcorrection434(digit_t* a)
 }
 
 
+#endif
+
+
 void digit_x_digit(const digit_t a, const digit_t b, digit_t* c)
 { // Digit multiplication, digit * digit -> 2-digit result    
     register digit_t al, ah, bl, bh, temp;
@@ -87,6 +87,7 @@ inline void fpadd503(const digit_t* a, const digit_t* b, digit_t* c)
     fpadd503_asm(a, b, c);    
 
 #endif
+    PROFILE_COUNT(SIDH_OP_FPADD);
 } 
 
 
@@ -114,6 +115,7 @@ inline void fpsub503(const digit_t* a, const digit_t* b, digit_t* c)
     fpsub503_asm(a, b, c);    
 
 #endif
+    PROFILE_COUNT(SIDH_OP_FPSUB);
 }
 
 
@@ -160,7 +162,7 @@ void fpcorrection503(digit_t* a)
     }
 }
 
-#if (OS_TARGET == OS_NIX)
+#if (OS_TARGET == OS_NIX) && !defined(_DISPATCH_)
 
 void fp2mul503_c0_mont(const digit_t* a, const digit_t* b, digit_t* c)
 {
@@ -191,7 +193,7 @@ void fpmul503(const digit_t* a, const digit_t* b, digit_t* c)
     fpmul503_asm(a, b, c);
 }
 
-#else
+#elif (OS_TARGET == OS_WIN)
 
 void mp_mul(const digit_t* a, const digit_t* b, digit_t* c, const unsigned int nwords)
 { // Multiprecision multiply, c = a*b, where lng(a) = lng(b) = nwords.
@@ -583,4 +585,26 @@ void rdc_mont(digit_t* ma, digit_t* mc)
     ADDC(0, uv[1], ma[15], carry, mc[7]);
 }
 
+#endif
+
+
+#if (OS_TARGET == OS_NIX) && defined(_DISPATCH_)
+// Runtime selection between the portable kernels in fp_generic.c and the MULX+ADX assembly
+#define fp2mul_c0_mont                fp2mul503_c0_mont
+#define fp2mul_c1_mont                fp2mul503_c1_mont
+#define fp2sqr_c0_mont                fp2sqr503_c0_mont
+#define fp2sqr_c1_mont                fp2sqr503_c1_mont
+#define fpmul                         fpmul503
+#define fp2mul_c0_asm                 fp2mul503_c0_asm
+#define fp2mul_c1_asm                 fp2mul503_c1_asm
+#define fp2sqr_c0_asm                 fp2sqr503_c0_asm
+#define fp2sqr_c1_asm                 fp2sqr503_c1_asm
+#define fpmul_asm                     fpmul503_asm
+#define fpkernel_get                  fpkernel503_get
+#define fpkernel_set                  fpkernel503_set
+#define FP_MUL_GENERIC                mp_mul503_generic
+#define FP_RDC_GENERIC                rdc503_mont_generic
+#define FP_PRIMEx2                    p503x2
+
+#include "../../fpx_dispatch.c"
 #endif
\ No newline at end of file
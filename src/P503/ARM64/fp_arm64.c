@@ -38,6 +38,7 @@ inline void fpadd503(const digit_t* a, const digit_t* b, digit_t* c)
   // Output: c in [0, 2*p503-1]
 
     fpadd503_asm(a, b, c);
+    PROFILE_COUNT(SIDH_OP_FPADD);
 } 
 
 
@@ -47,6 +48,7 @@ inline void fpsub503(const digit_t* a, const digit_t* b, digit_t* c)
   // Output: c in [0, 2*p503-1] 
 
     fpsub503_asm(a, b, c);
+    PROFILE_COUNT(SIDH_OP_FPSUB);
 }
 
 
@@ -114,7 +114,11 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 #define fp2div2                       fp2div2_503
 #define fp2correction                 fp2correction503
 #define fp2mul_mont                   fp2mul503_mont
+#define fp2muladd_mont                fp2muladd503_mont
+#define fp2mulsub_mont                fp2mulsub503_mont
 #define fp2sqr_mont                   fp2sqr503_mont
+#define fp2mul_mont_x8                fp2mul503_mont_x8
+#define fp2sqr_mont_x8                fp2sqr503_mont_x8
 #define fp2mul_c0_mont                fp2mul503_c0_mont
 #define fp2mul_c1_mont                fp2mul503_c1_mont
 #define fp2sqr_c0_mont                fp2sqr503_c0_mont
@@ -127,6 +131,12 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 #define mp_dblsubx2_asm               mp_dblsub503x2_asm
 #define crypto_kem_keypair            crypto_kem_keypair_SIKEp503
 #define crypto_kem_enc                crypto_kem_enc_SIKEp503
+#define crypto_kem_enc_batch          crypto_kem_enc_batch_SIKEp503
+#define crypto_kem_enc_ctx            crypto_kem_enc_ctx_SIKEp503
+#define sike_pk_ctx                   sike_pk_ctx_SIKEp503
+#define sike_pk_ctx_init              sike_pk_ctx_init_SIKEp503
+#define crypto_kem_ct_validate        crypto_kem_ct_validate_SIKEp503
+#define crypto_kem_scheme             crypto_kem_scheme_SIKEp503
 #define crypto_kem_dec                crypto_kem_dec_SIKEp503
 #define random_mod_order_A            random_mod_order_A_SIDHp503
 #define random_mod_order_B            random_mod_order_B_SIDHp503
@@ -134,6 +144,13 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 #define EphemeralKeyGeneration_B      EphemeralKeyGeneration_B_SIDHp503
 #define EphemeralSecretAgreement_A    EphemeralSecretAgreement_A_SIDHp503
 #define EphemeralSecretAgreement_B    EphemeralSecretAgreement_B_SIDHp503
+#define EphemeralSecretAgreement_A_ctx EphemeralSecretAgreement_A_ctx_SIDHp503
+#define EphemeralSecretAgreement_B_ctx EphemeralSecretAgreement_B_ctx_SIDHp503
+#define sidh_load_strategies          sidh_load_strategies_SIDHp503
+
+#if defined(SIDH_FIXED_BASE)
+    #include "P503_fixed_base.c"
+#endif
 
 #include "../fpx.c"
 #include "../ec_isogeny.c"
@@ -10,6 +10,8 @@
 
 #ifndef P503_COMPRESSED_API_H
 #define P503_COMPRESSED_API_H
+
+#include "../sike_dec_service.h"
     
 
 /*********************** Key encapsulation mechanism API ***********************/
@@ -40,6 +42,37 @@ int crypto_kem_enc_SIKEp503_compressed(unsigned char *ct, unsigned char *ss, con
 // Outputs: shared secret ss      (CRYPTO_BYTES = 24 bytes)
 int crypto_kem_dec_SIKEp503_compressed(unsigned char *ss, const unsigned char *ct, const unsigned char *sk);
 
+// SIKE's decapsulation of a batch of n ciphertexts under the same secret key, e.g., for bursts of handshakes on a server
+// Input:   secret key sk          (CRYPTO_SECRETKEYBYTES bytes)
+//          ciphertext messages ct (n*CRYPTO_CIPHERTEXTBYTES bytes, the i-th ciphertext at ct + i*CRYPTO_CIPHERTEXTBYTES)
+// Outputs: shared secrets ss      (n*CRYPTO_BYTES bytes, the i-th secret at ss + i*CRYPTO_BYTES)
+int crypto_kem_dec_batch_SIKEp503_compressed(unsigned char *ss, const unsigned char *ct, const unsigned char *sk, unsigned int n);
+
+// SIKE's key generation, encapsulation and decapsulation with the large temporaries (isogeny chains, points of the tree 
+// traversals and pairing values) in a caller-supplied workspace of CRYPTO_WORKSPACE_BYTES bytes instead of the stack, 
+// e.g., for handshakes on small-stack coroutines. The workspace needs no alignment or initialization. It can be reused by 
+// any call once the previous one returns, but not by concurrent calls, and holds secret values on return.
+#define CRYPTO_WORKSPACE_BYTES    87816
+int crypto_kem_keypair_ex_SIKEp503_compressed(unsigned char *pk, unsigned char *sk, void *workspace);
+int crypto_kem_enc_ex_SIKEp503_compressed(unsigned char *ct, unsigned char *ss, const unsigned char *pk, void *workspace);
+int crypto_kem_dec_ex_SIKEp503_compressed(unsigned char *ss, const unsigned char *ct, const unsigned char *sk, void *workspace);
+
+// Asynchronous decapsulation service, see ../sike_dec_service.h. A fixed pool of worker threads runs the shared secret
+// recovery of the submitted ciphertexts by batches, with merged inversions, and their validation by re-encryption.
+// Not available in Windows builds. The submit, poll, stats and destroy functions can be called from any thread.
+// Creation with the number of worker threads and the maximum number of submitted requests not yet released. Returns NULL on error
+sike_dec_service* crypto_kem_dec_service_create_SIKEp503_compressed(unsigned int workers, unsigned int capacity);
+// Submission of a decapsulation, with ct and sk as for crypto_kem_dec. They are copied, ss must remain valid until completion.
+// On completion callback(ctx, ss) is called, or if callback is NULL the request is reported by poll. Returns 0, or -1 if full
+int crypto_kem_dec_service_submit_SIKEp503_compressed(sike_dec_service* service, unsigned char *ss, const unsigned char *ct, const unsigned char *sk, sike_dec_callback_t callback, void* ctx);
+// Release of up to max completed requests without callback, whose contexts are written to ctx. Waits for one if wait is nonzero
+// and requests are in flight. Returns the number of released requests
+unsigned int crypto_kem_dec_service_poll_SIKEp503_compressed(sike_dec_service* service, void** ctx, unsigned int max, int wait);
+// Counters, queue-depth and latency histograms of the service
+void crypto_kem_dec_service_stats_SIKEp503_compressed(sike_dec_service* service, sike_dec_stats* stats);
+// Waits for the submitted requests to complete, stops the workers and releases the service
+void crypto_kem_dec_service_destroy_SIKEp503_compressed(sike_dec_service* service);
+
 
 // Encoding of keys for KEM-based isogeny system "SIKEp503" (wire format):
 // ----------------------------------------------------------------------
@@ -67,11 +100,11 @@ int crypto_kem_dec_SIKEp503_compressed(unsigned char *ss, const unsigned char *c
 
 // Generation of Alice's secret key 
 // Outputs random value in [0, 2^250 - 1] to be used as Alice's private key
-void random_mod_order_A_SIDHp503(unsigned char* random_digits);
+void random_mod_order_A_SIDHp503_Compressed(unsigned char* random_digits);
 
 // Generation of Bob's secret key 
 // Outputs random value in [0, 2^Floor(Log(2,3^159)) - 1] to be used as Bob's private key
-void random_mod_order_B_SIDHp503(unsigned char* random_digits);
+void random_mod_order_B_SIDHp503_Compressed(unsigned char* random_digits);
 
 // Alice's ephemeral public key generation
 // Input:  a private key PrivateKeyA in the range [0, 2^250 - 1], stored in 32 bytes. 
@@ -98,6 +131,24 @@ int EphemeralSecretAgreement_A_SIDHp503_Compressed(const unsigned char* PrivateK
 // Output: a shared secret SharedSecretB that consists of one element in GF(p503^2) encoded in 126 bytes.
 int EphemeralSecretAgreement_B_SIDHp503_Compressed(const unsigned char* PrivateKeyB, const unsigned char* PublicKeyA, unsigned char* SharedSecretB);
 
+// The functions above with the large temporaries in a caller-supplied workspace of SIDH_WORKSPACE_BYTES bytes instead of the 
+// stack, as for the SIKE functions with suffix _ex
+#define SIDH_WORKSPACE_BYTES    87816
+int EphemeralKeyGeneration_A_ex_SIDHp503_Compressed(const unsigned char* PrivateKeyA, unsigned char* PublicKeyA, void* workspace);
+int EphemeralKeyGeneration_B_ex_SIDHp503_Compressed(const unsigned char* PrivateKeyB, unsigned char* PublicKeyB, void* workspace);
+int EphemeralSecretAgreement_A_ex_SIDHp503_Compressed(const unsigned char* PrivateKeyA, const unsigned char* PublicKeyB, unsigned char* SharedSecretA, void* workspace);
+int EphemeralSecretAgreement_B_ex_SIDHp503_Compressed(const unsigned char* PrivateKeyB, const unsigned char* PublicKeyA, unsigned char* SharedSecretB, void* workspace);
+
+
+// Loading of the pairing and discrete log tables from a table file, as written by sidh_write_tables_SIDHp503_Compressed (tables_gen-p503).
+// The file is mapped read-only and shared by all processes using it. Input: path of the file, or NULL to restore the built-in tables.
+// Returns 0 on success, or -1 if the file cannot be mapped or does not match this library (field, window sizes, layout or checksum).
+// Not thread-safe, to be called at initialization. The tables are shared by SIDHp503_compressed and SIKEp503_compressed.
+int sidh_load_tables_SIDHp503_Compressed(const char* path);
+
+// Writing of the pairing and discrete log tables in use to a table file. Returns 0 on success, or -1 on error.
+int sidh_write_tables_SIDHp503_Compressed(const char* path);
+
 
 // Encoding of keys for KEX-based isogeny system "SIDHp503_compressed" (wire format):
 // ----------------------------------------------------------------------
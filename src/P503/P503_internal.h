@@ -104,6 +104,7 @@
 typedef digit_t felm_t[NWORDS_FIELD];                                 // Datatype for representing 503-bit field elements (512-bit max.)
 typedef digit_t dfelm_t[2*NWORDS_FIELD];                              // Datatype for representing double-precision 2x503-bit field elements (2x512-bit max.) 
 typedef felm_t  f2elm_t[2];                                           // Datatype for representing quadratic extension field elements GF(p503^2)
+typedef dfelm_t df2elm_t[2];                                          // Datatype for representing double-precision GF(p503^2) elements, i.e., unreduced products
         
 typedef struct { f2elm_t X; f2elm_t Z; } point_proj;                  // Point representation in projective XZ Montgomery coordinates.
 typedef point_proj point_proj_t[1]; 
@@ -225,6 +226,24 @@ void fp2mul503_c0_asm(const digit_t* a, const digit_t* b, digit_t* c);
 void fp2mul503_c1_mont(const digit_t* a, const digit_t* b, digit_t* c);
 void fp2mul503_c1_asm(const digit_t* a, const digit_t* b, digit_t* c);
 
+// GF(p503^2) sum and difference of products using Montgomery arithmetic with a single reduction, e = a*b + c*d and e = a*b - c*d in GF(p503^2)
+void fp2muladd503_mont(const f2elm_t a, const f2elm_t b, const f2elm_t c, const f2elm_t d, f2elm_t e);
+void fp2mulsub503_mont(const f2elm_t a, const f2elm_t b, const f2elm_t c, const f2elm_t d, f2elm_t e);
+
+#if defined(_AVX512_IFMA_)
+// 8-way GF(p503^2) multiplication and squaring using AVX-512 IFMA, c[i] = a[i]*b[i] and c[i] = a[i]^2 in GF(p503^2) for i = 0..7
+void fp2mul503_mont_x8(const f2elm_t* a, const f2elm_t* b, f2elm_t* c);
+void fp2sqr503_mont_x8(const f2elm_t* a, f2elm_t* c);
+#endif
+
+#if defined(_DISPATCH_)
+// Runtime selection of the field multiplication kernels, see fpx_dispatch.c. The level is one of FP_KERNEL_GENERIC, FP_KERNEL_MULX, FP_KERNEL_MULX_ADX
+int fpkernel503_get(void);
+int fpkernel503_set(const int level);
+void mp_mul503_generic(const digit_t* a, const digit_t* b, digit_t* c, const unsigned int nwords);
+void rdc503_mont_generic(digit_t* ma, digit_t* mc);
+#endif
+
 // GF(p503^2) inversion using Montgomery arithmetic, a = (a0-i*a1)/(a0^2+a1^2)
 void fp2inv503_mont(f2elm_t a);
 
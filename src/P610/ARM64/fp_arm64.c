@@ -38,6 +38,7 @@ inline void fpadd610(const digit_t* a, const digit_t* b, digit_t* c)
   // Output: c in [0, 2*p610-1]
 
     fpadd610_asm(a, b, c);
+    PROFILE_COUNT(SIDH_OP_FPADD);
 } 
 
 
@@ -47,6 +48,7 @@ inline void fpsub610(const digit_t* a, const digit_t* b, digit_t* c)
   // Output: c in [0, 2*p610-1] 
 
     fpsub610_asm(a, b, c);
+    PROFILE_COUNT(SIDH_OP_FPSUB);
 }
 
 
@@ -0,0 +1,25 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: 8-way GF(p^2) arithmetic using AVX-512 IFMA for P610
+*********************************************************************************************/
+
+#include "../P610_internal.h"
+#include "../../internal.h"
+
+
+// Global constants
+extern const uint64_t p610[NWORDS64_FIELD];
+extern const uint64_t p610x2[NWORDS64_FIELD];
+
+#define NLIMBS52                12                                 // Number of 52-bit limbs of an element in [0, 4*p610-1]
+#define PRIME_IFMA              p610
+#define PRIMEx2_IFMA            p610x2
+#define fp2mul_mont_x8          fp2mul610_mont_x8
+#define fp2sqr_mont_x8          fp2sqr610_mont_x8
+
+#include "../../fpx_ifma.c"
@@ -22,6 +22,19 @@
 // Algorithm name
 #define CRYPTO_ALGNAME "SIKEp610"  
 
+// Public key context
+// It caches a decoded public key together with its curve coefficients A and A24 = (A+2)/4, so that repeated 
+// operations against the same long-lived public key skip the decoding and the inversion needed to recover A.
+typedef struct {
+    unsigned long long opaque[5*2*10];        // xP, xQ, xR, A and A24 in GF(p610^2)
+    unsigned char pk[CRYPTO_PUBLICKEYBYTES];  // Encoded public key
+} sike_pk_ctx_SIKEp610;
+
+// Precomputation of a public key context
+// Input:  public key pk (CRYPTO_PUBLICKEYBYTES = 462 bytes), either a SIKE public key or a SIDH public key
+// Output: context ctx
+void sike_pk_ctx_init_SIKEp610(sike_pk_ctx_SIKEp610 *ctx, const unsigned char *pk);
+
 // SIKE's key generation
 // It produces a private key sk and computes the public key pk.
 // Outputs: secret key sk (CRYPTO_SECRETKEYBYTES = 524 bytes)
@@ -34,6 +47,27 @@ int crypto_kem_keypair_SIKEp610(unsigned char *pk, unsigned char *sk);
 //          ciphertext message ct (CRYPTO_CIPHERTEXTBYTES = 486 bytes) 
 int crypto_kem_enc_SIKEp610(unsigned char *ct, unsigned char *ss, const unsigned char *pk);
 
+// SIKE's encapsulation using a precomputed public key context
+// Input:   context ctx of the public key pk, as computed by sike_pk_ctx_init_SIKEp610
+// Outputs: shared secret ss      (CRYPTO_BYTES = 24 bytes)
+//          ciphertext message ct (CRYPTO_CIPHERTEXTBYTES = 486 bytes)
+int crypto_kem_enc_ctx_SIKEp610(unsigned char *ct, unsigned char *ss, const sike_pk_ctx_SIKEp610 *ctx);
+
+// SIKE's batched encapsulation
+// It produces n ciphertexts and shared secrets under the same public key pk, amortizing the decoding of pk and the final inversions.
+// Input:   public key pk         (CRYPTO_PUBLICKEYBYTES = 462 bytes)
+//          number of encapsulations n
+// Outputs: shared secrets ss     (n*CRYPTO_BYTES bytes, each CRYPTO_BYTES = 24 bytes)
+//          ciphertexts ct        (n*CRYPTO_CIPHERTEXTBYTES bytes, each CRYPTO_CIPHERTEXTBYTES = 486 bytes)
+int crypto_kem_enc_batch_SIKEp610(unsigned char *ct, unsigned char *ss, const unsigned char *pk, unsigned int n);
+
+// SIKE's ciphertext validation
+// Constant-time check that the public key encoded in ct consists of elements of GF(p^2) with reduced coordinates.
+// crypto_kem_dec_SIKEp610 returns the implicit-rejection secret for ciphertexts that fail it without the isogeny walks.
+// Input:   ciphertext message ct (CRYPTO_CIPHERTEXTBYTES = 486 bytes)
+// Output:  0 if ct is validly encoded, -1 otherwise
+int crypto_kem_ct_validate_SIKEp610(const unsigned char *ct);
+
 // SIKE's decapsulation
 // Input:   secret key sk         (CRYPTO_SECRETKEYBYTES = 524 bytes)
 //          ciphertext message ct (CRYPTO_CIPHERTEXTBYTES = 486 bytes) 
@@ -59,6 +93,8 @@ int crypto_kem_dec_SIKEp610(unsigned char *ss, const unsigned char *ct, const un
 #define SIDH_SECRETKEYBYTES_B    38
 #define SIDH_PUBLICKEYBYTES     462
 #define SIDH_BYTES              154 
+#define SIDH_STRATEGY_LENGTH_A  151
+#define SIDH_STRATEGY_LENGTH_B  191
 
 // SECURITY NOTE: SIDH supports ephemeral Diffie-Hellman key exchange. It is NOT secure to use it with static keys.
 // See "On the Security of Supersingular Isogeny Cryptosystems", S.D. Galbraith, C. Petit, B. Shani and Y.B. Ti, in ASIACRYPT 2016, 2016.
@@ -90,6 +126,10 @@ int EphemeralKeyGeneration_B_SIDHp610(const unsigned char* PrivateKeyB, unsigned
 // Output: a shared secret SharedSecretA that consists of one element in GF(p610^2) encoded in 154 bytes.
 int EphemeralSecretAgreement_A_SIDHp610(const unsigned char* PrivateKeyA, const unsigned char* PublicKeyB, unsigned char* SharedSecretA);
 
+// Alice's ephemeral shared secret computation using a precomputed context of Bob's public key
+// Same as EphemeralSecretAgreement_A_SIDHp610, with PublicKeyB replaced by its context ctx as computed by sike_pk_ctx_init_SIKEp610.
+int EphemeralSecretAgreement_A_ctx_SIDHp610(const unsigned char* PrivateKeyA, const sike_pk_ctx_SIKEp610* ctx, unsigned char* SharedSecretA);
+
 // Bob's ephemeral shared secret computation
 // It produces a shared secret key SharedSecretB using his secret key PrivateKeyB and Alice's public key PublicKeyA
 // Inputs: Bob's PrivateKeyB is an integer in the range [0, 2^Floor(Log(2,3^192)) - 1], stored in 38 bytes.  
@@ -97,6 +137,16 @@ int EphemeralSecretAgreement_A_SIDHp610(const unsigned char* PrivateKeyA, const
 // Output: a shared secret SharedSecretB that consists of one element in GF(p610^2) encoded in 154 bytes. 
 int EphemeralSecretAgreement_B_SIDHp610(const unsigned char* PrivateKeyB, const unsigned char* PublicKeyA, unsigned char* SharedSecretB);
 
+// Bob's ephemeral shared secret computation using a precomputed context of Alice's public key
+// Same as EphemeralSecretAgreement_B_SIDHp610, with PublicKeyA replaced by its context ctx as computed by sike_pk_ctx_init_SIKEp610.
+int EphemeralSecretAgreement_B_ctx_SIDHp610(const unsigned char* PrivateKeyB, const sike_pk_ctx_SIKEp610* ctx, unsigned char* SharedSecretB);
+
+// Loading of alternative strategies for the isogeny tree traversal, e.g., as generated by strategy_gen-p610 for a number of threads
+// Inputs: strat_A and strat_B with SIDH_STRATEGY_LENGTH_A and SIDH_STRATEGY_LENGTH_B entries, or NULL to restore the built-in strategies.
+// Returns 0 on success, or -1 if a strategy is not valid. Not thread-safe, to be called at initialization.
+// The strategies are shared by SIDHp610 and SIKEp610.
+int sidh_load_strategies_SIDHp610(const unsigned int* strat_A, const unsigned int* strat_B);
+
 
 // Encoding of keys for KEX-based isogeny system "SIDHp610" (wire format):
 // ----------------------------------------------------------------------
@@ -360,7 +360,11 @@ const uint64_t v_3_torsion[TABLE_V3_LEN][2 * NWORDS64_FIELD] =
 #define fp2div2                       fp2div2_610
 #define fp2correction                 fp2correction610
 #define fp2mul_mont                   fp2mul610_mont
+#define fp2muladd_mont                fp2muladd610_mont
+#define fp2mulsub_mont                fp2mulsub610_mont
 #define fp2sqr_mont                   fp2sqr610_mont
+#define fp2mul_mont_x8                fp2mul610_mont_x8
+#define fp2sqr_mont_x8                fp2sqr610_mont_x8
 #define fp2mul_c0_mont                fp2mul610_c0_mont
 #define fp2mul_c1_mont                fp2mul610_c1_mont
 #define fp2sqr_c0_mont                fp2sqr610_c0_mont
@@ -371,23 +375,41 @@ const uint64_t v_3_torsion[TABLE_V3_LEN][2 * NWORDS64_FIELD] =
 #define mp_add_asm                    mp_add610_asm
 #define mp_subaddx2_asm               mp_subadd610x2_asm
 #define mp_dblsubx2_asm               mp_dblsub610x2_asm
-#define random_mod_order_A            random_mod_order_A_SIDHp610
-#define random_mod_order_B            random_mod_order_B_SIDHp610
+#define random_mod_order_A            random_mod_order_A_SIDHp610_Compressed
+#define random_mod_order_B            random_mod_order_B_SIDHp610_Compressed
 #define EphemeralKeyGeneration_A      EphemeralKeyGeneration_A_SIDHp610_Compressed
 #define EphemeralKeyGeneration_B      EphemeralKeyGeneration_B_SIDHp610_Compressed
 #define EphemeralSecretAgreement_A    EphemeralSecretAgreement_A_SIDHp610_Compressed
 #define EphemeralSecretAgreement_B    EphemeralSecretAgreement_B_SIDHp610_Compressed 
+#define EphemeralKeyGeneration_A_ex   EphemeralKeyGeneration_A_ex_SIDHp610_Compressed
+#define EphemeralKeyGeneration_B_ex   EphemeralKeyGeneration_B_ex_SIDHp610_Compressed
+#define EphemeralSecretAgreement_A_ex EphemeralSecretAgreement_A_ex_SIDHp610_Compressed
+#define EphemeralSecretAgreement_B_ex EphemeralSecretAgreement_B_ex_SIDHp610_Compressed
 #define crypto_kem_keypair            crypto_kem_keypair_SIKEp610_compressed
 #define crypto_kem_enc                crypto_kem_enc_SIKEp610_compressed
+#define crypto_kem_scheme             crypto_kem_scheme_SIKEp610_compressed
 #define crypto_kem_dec                crypto_kem_dec_SIKEp610_compressed
+#define crypto_kem_dec_batch          crypto_kem_dec_batch_SIKEp610_compressed
+#define crypto_kem_keypair_ex         crypto_kem_keypair_ex_SIKEp610_compressed
+#define crypto_kem_enc_ex             crypto_kem_enc_ex_SIKEp610_compressed
+#define crypto_kem_dec_ex             crypto_kem_dec_ex_SIKEp610_compressed
+#define crypto_kem_dec_service_create crypto_kem_dec_service_create_SIKEp610_compressed
+#define crypto_kem_dec_service_submit crypto_kem_dec_service_submit_SIKEp610_compressed
+#define crypto_kem_dec_service_poll   crypto_kem_dec_service_poll_SIKEp610_compressed
+#define crypto_kem_dec_service_stats  crypto_kem_dec_service_stats_SIKEp610_compressed
+#define crypto_kem_dec_service_destroy crypto_kem_dec_service_destroy_SIKEp610_compressed
+#define sidh_load_tables              sidh_load_tables_SIDHp610_Compressed
+#define sidh_write_tables             sidh_write_tables_SIDHp610_Compressed
 
 
 #include "../fpx.c"
 #include "../ec_isogeny.c"
 #include "../compression/torsion_basis.c"
 #include "P610_compressed_pair_tables.c"
-#include "../compression/pairing.c"
 #include "P610_compressed_dlog_tables.c"
+#include "../compression/tables.c"
+#include "../compression/pairing.c"
 #include "../compression/dlog.c"
 #include "../compression/sidh_compressed.c"
 #include "../compression/sike_compressed.c"
+#include "../compression/sike_dec_service.c"
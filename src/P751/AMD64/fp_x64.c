@@ -92,6 +92,7 @@ inline void fpadd751(const digit_t* a, const digit_t* b, digit_t* c)
     fpadd751_asm(a, b, c);    
 
 #endif
+    PROFILE_COUNT(SIDH_OP_FPADD);
 } 
 
 
@@ -119,6 +120,7 @@ inline void fpsub751(const digit_t* a, const digit_t* b, digit_t* c)
     fpsub751_asm(a, b, c);    
 
 #endif
+    PROFILE_COUNT(SIDH_OP_FPSUB);
 }
 
 
@@ -166,6 +168,12 @@ void fpcorrection751(digit_t* a)
 }
 
 
+#if (OS_TARGET == OS_NIX) && defined(_DISPATCH_)
+    // The MULX+ADX entry points below become kernels of the runtime dispatcher
+    #define mp_mul                    mp_mul751_adx
+    #define rdc_mont                  rdc751_mont_adx
+#endif
+
 void mp_mul(const digit_t* a, const digit_t* b, digit_t* c, const unsigned int nwords)
 { // Multiprecision multiply, c = a*b, where lng(a) = lng(b) = nwords.
         
@@ -908,4 +916,28 @@ void rdc_mont(digit_t* ma, digit_t* mc)
     rdc751_asm(ma, mc);    
 
 #endif
-}
\ No newline at end of file
+}
+
+
+#if (OS_TARGET == OS_NIX) && defined(_DISPATCH_)
+// Runtime selection between the portable kernels in fp_generic.c and the MULX or MULX+ADX assembly
+#undef mp_mul
+#undef rdc_mont
+
+static void mp_mul751_mulx(const digit_t* a, const digit_t* b, digit_t* c, const unsigned int nwords)
+{
+    UNREFERENCED_PARAMETER(nwords);
+    mul751_asm_mulx(a, b, c);
+}
+
+#define fpkernel_get                  fpkernel751_get
+#define fpkernel_set                  fpkernel751_set
+#define FP_MUL_GENERIC                mp_mul751_generic
+#define FP_RDC_GENERIC                rdc751_mont_generic
+#define FP_MUL_MULX                   mp_mul751_mulx
+#define FP_RDC_MULX                   rdc751_asm_mulx
+#define FP_MUL_ADX                    mp_mul751_adx
+#define FP_RDC_ADX                    rdc751_mont_adx
+
+#include "../../fpx_dispatch.c"
+#endif
\ No newline at end of file
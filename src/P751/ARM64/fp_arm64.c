@@ -38,6 +38,7 @@ inline void fpadd751(const digit_t* a, const digit_t* b, digit_t* c)
   // Output: c in [0, 2*p751-1]
 
     fpadd751_asm(a, b, c);
+    PROFILE_COUNT(SIDH_OP_FPADD);
 } 
 
 
@@ -47,6 +48,7 @@ inline void fpsub751(const digit_t* a, const digit_t* b, digit_t* c)
   // Output: c in [0, 2*p751-1] 
 
     fpsub751_asm(a, b, c);
+    PROFILE_COUNT(SIDH_OP_FPSUB);
 }
 
 
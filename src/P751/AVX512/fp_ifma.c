@@ -0,0 +1,25 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: 8-way GF(p^2) arithmetic using AVX-512 IFMA for P751
+*********************************************************************************************/
+
+#include "../P751_internal.h"
+#include "../../internal.h"
+
+
+// Global constants
+extern const uint64_t p751[NWORDS64_FIELD];
+extern const uint64_t p751x2[NWORDS64_FIELD];
+
+#define NLIMBS52                15                                 // Number of 52-bit limbs of an element in [0, 4*p751-1]
+#define PRIME_IFMA              p751
+#define PRIMEx2_IFMA            p751x2
+#define fp2mul_mont_x8          fp2mul751_mont_x8
+#define fp2sqr_mont_x8          fp2sqr751_mont_x8
+
+#include "../../fpx_ifma.c"
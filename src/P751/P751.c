@@ -116,7 +116,11 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 #define fp2div2                       fp2div2_751
 #define fp2correction                 fp2correction751
 #define fp2mul_mont                   fp2mul751_mont
+#define fp2muladd_mont                fp2muladd751_mont
+#define fp2mulsub_mont                fp2mulsub751_mont
 #define fp2sqr_mont                   fp2sqr751_mont
+#define fp2mul_mont_x8                fp2mul751_mont_x8
+#define fp2sqr_mont_x8                fp2sqr751_mont_x8
 #define fp2mul_c0_mont                fp2mul751_c0_mont
 #define fp2mul_c1_mont                fp2mul751_c1_mont
 #define fp2sqr_c0_mont                fp2sqr751_c0_mont
@@ -129,6 +133,12 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 #define mp_dblsubx2_asm               mp_dblsub751x2_asm
 #define crypto_kem_keypair            crypto_kem_keypair_SIKEp751
 #define crypto_kem_enc                crypto_kem_enc_SIKEp751
+#define crypto_kem_enc_batch          crypto_kem_enc_batch_SIKEp751
+#define crypto_kem_enc_ctx            crypto_kem_enc_ctx_SIKEp751
+#define sike_pk_ctx                   sike_pk_ctx_SIKEp751
+#define sike_pk_ctx_init              sike_pk_ctx_init_SIKEp751
+#define crypto_kem_ct_validate        crypto_kem_ct_validate_SIKEp751
+#define crypto_kem_scheme             crypto_kem_scheme_SIKEp751
 #define crypto_kem_dec                crypto_kem_dec_SIKEp751
 #define random_mod_order_A            random_mod_order_A_SIDHp751
 #define random_mod_order_B            random_mod_order_B_SIDHp751
@@ -136,6 +146,13 @@ const unsigned int strat_Bob[MAX_Bob-1] = {
 #define EphemeralKeyGeneration_B      EphemeralKeyGeneration_B_SIDHp751
 #define EphemeralSecretAgreement_A    EphemeralSecretAgreement_A_SIDHp751
 #define EphemeralSecretAgreement_B    EphemeralSecretAgreement_B_SIDHp751
+#define EphemeralSecretAgreement_A_ctx EphemeralSecretAgreement_A_ctx_SIDHp751
+#define EphemeralSecretAgreement_B_ctx EphemeralSecretAgreement_B_ctx_SIDHp751
+#define sidh_load_strategies          sidh_load_strategies_SIDHp751
+
+#if defined(SIDH_FIXED_BASE)
+    #include "P751_fixed_base.c"
+#endif
 
 #include "../fpx.c"
 #include "../ec_isogeny.c"
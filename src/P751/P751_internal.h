@@ -105,6 +105,7 @@
 typedef digit_t felm_t[NWORDS_FIELD];                                 // Datatype for representing 751-bit field elements (768-bit max.)
 typedef digit_t dfelm_t[2*NWORDS_FIELD];                              // Datatype for representing double-precision 2x751-bit field elements (2x768-bit max.) 
 typedef felm_t  f2elm_t[2];                                           // Datatype for representing quadratic extension field elements GF(p751^2)
+typedef dfelm_t df2elm_t[2];                                          // Datatype for representing double-precision GF(p751^2) elements, i.e., unreduced products
         
 typedef struct { f2elm_t X; f2elm_t Z; } point_proj;                  // Point representation in projective XZ Montgomery coordinates.
 typedef point_proj point_proj_t[1]; 
@@ -224,6 +225,26 @@ void fp2mul751_c0_asm(const digit_t* a, const digit_t* b, digit_t* c);
 void fp2mul751_c1_mont(const digit_t* a, const digit_t* b, digit_t* c);
 void fp2mul751_c1_asm(const digit_t* a, const digit_t* b, digit_t* c);
 
+// GF(p751^2) sum and difference of products using Montgomery arithmetic with a single reduction, e = a*b + c*d and e = a*b - c*d in GF(p751^2)
+void fp2muladd751_mont(const f2elm_t a, const f2elm_t b, const f2elm_t c, const f2elm_t d, f2elm_t e);
+void fp2mulsub751_mont(const f2elm_t a, const f2elm_t b, const f2elm_t c, const f2elm_t d, f2elm_t e);
+
+#if defined(_AVX512_IFMA_)
+// 8-way GF(p751^2) multiplication and squaring using AVX-512 IFMA, c[i] = a[i]*b[i] and c[i] = a[i]^2 in GF(p751^2) for i = 0..7
+void fp2mul751_mont_x8(const f2elm_t* a, const f2elm_t* b, f2elm_t* c);
+void fp2sqr751_mont_x8(const f2elm_t* a, f2elm_t* c);
+#endif
+
+#if defined(_DISPATCH_)
+// Runtime selection of the field multiplication kernels, see fpx_dispatch.c. The level is one of FP_KERNEL_GENERIC, FP_KERNEL_MULX, FP_KERNEL_MULX_ADX
+int fpkernel751_get(void);
+int fpkernel751_set(const int level);
+void mp_mul751_generic(const digit_t* a, const digit_t* b, digit_t* c, const unsigned int nwords);
+void rdc751_mont_generic(digit_t* ma, digit_t* mc);
+void mul751_asm_mulx(const digit_t* a, const digit_t* b, digit_t* c);
+void rdc751_asm_mulx(digit_t* ma, digit_t* mc);
+#endif
+
 // GF(p751^2) inversion using Montgomery arithmetic, a = (a0-i*a1)/(a0^2+a1^2)
 void fp2inv751_mont(f2elm_t a);
 
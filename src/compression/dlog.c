@@ -92,12 +92,13 @@ void from_base(int *D, digit_t *r, int Dlen, int base)
 
 #ifdef ELL2_TORUS
 
-int ord2w_dlog(const felm_t *r, const int *logT, const felm_t *Texp)
+int ord2w_dlog(const felm_t *r, const int *logT, const felm_t *Texp, felm_t *prods)
 { // Given a generator rho_2 of order 2^w1, input elements r=[x:y] and w1, compute d <- log_{rho_2}r, 
   // where r = [x,y] \equiv [a_k:1] for some k in {1,2,..2^w1-1} or r \equiv [1:0]
+  // prods is a workspace of PH2_DLOG_PRODS elements
   // Output: corresponding digit d in [-2^{w1-1},2^{w1-1}]
     felm_t x, y;
-    felm_t sum = {0}, prods[1<<(W_2_1-1)] = {0};
+    felm_t sum = {0};
 
     fpcopy(r[0], x);
     fpcopy(r[1], y);
@@ -111,7 +112,7 @@ int ord2w_dlog(const felm_t *r, const int *logT, const felm_t *Texp)
     fpneg(sum);
     fpcorrection(sum);
     if (memcmp(x, sum, NBITS_TO_NBYTES(NBITS_FIELD)) == 0) return logT[2];    
-    for (int j = 2; j < W_2; ++j) {
+    for (int j = 2; j < (int)ph_params_active.w2_1; ++j) {    // Levels j < w1 cover the whole Log table
         for (int i = 0; i < (1<<(j-1)); ++i) {
             if ((i % 2) == 0) 
                 fpmul_mont(y, Texp[(1<<(j-2)) + (i/2) - 1], prods[(1<<(j-2)) + (i/2) - 1]);
@@ -138,11 +139,12 @@ int ord2w_dlog(const felm_t *r, const int *logT, const felm_t *Texp)
 
 // Input: h =[x,y] = rho^D in G_{ell=2,w} generated by rho, i.e., |h| <= 2^w
 // Output: The signed digit D in {-ell^(w-1), ..., ell^(w-1)}
-int ord2w_dloghyb(const felm_t *h, const int *logT, const felm_t *Texp, const felm_t *G)
+int ord2w_dloghyb(const felm_t *h, const int *logT, const felm_t *Texp, const felm_t *G, felm_t *prods)
 {
-    int k = 0, d = 0, index = 0, ord = 0, tmp = 0, w = W_2, w2 = w - W_2_1, i_j = 0, t;
+    const int w1 = (int)ph_params_active.w2_1;
+    int k = 0, d = 0, index = 0, ord = 0, tmp = 0, w = (int)ph_params_active.w2, w2 = w - w1, i_j = 0, t;
     uint8_t inv = 0, flag = 0;
-    f2elm_t H[W_2_1+1] = {0}; // Size of H should be max of {W_2_1+1, W_2 - W_2_1}
+    f2elm_t H[PH_W2_MAX] = {0}; // Size of H should be max of {w1+1, w - w1}
     felm_t one = {0};
 
     fpcopy((digit_t*)&Montgomery_one, one);    
@@ -161,19 +163,19 @@ int ord2w_dloghyb(const felm_t *h, const int *logT, const felm_t *Texp, const fe
     }
 
     fpcorrection(H[0][1]);
-    if (is_felm_zero(H[0][1]) && k <= W_2_1) return ord2w_dlog(H[k], logT, Texp) << w2;
+    if (is_felm_zero(H[0][1]) && k <= w1) return ord2w_dlog(H[k], logT, Texp, prods) << w2;
 
     if (!is_felm_zero(H[0][1])) {        
-        d = mod(ord2w_dlog(H[0], logT, Texp), (1 << W_2_1));
+        d = mod(ord2w_dlog(H[0], logT, Texp, prods), (1 << w1));
         index = 0;
     } else {        
-        d = mod(ord2w_dlog(&H[W_2_1][0], logT, Texp), (1 << W_2_1));
-        index = W_2_1;
+        d = mod(ord2w_dlog(&H[w1][0], logT, Texp, prods), (1 << w1));
+        index = w1;
     }
 
     t = highest_t(d);
-    ord = W_2_1 - t;
-    tmp = ((d >> (W_2_1-ord))-1) >> 1;
+    ord = w1 - t;
+    tmp = ((d >> (w1-ord))-1) >> 1;
     i_j = reverse_bits(tmp,ord-1);
     fpcorrection(H[0][0]);
     if (is_felm_zero(H[0][0])) { // check if compressed Fp2 element H[0] is -1
@@ -187,7 +189,7 @@ int ord2w_dloghyb(const felm_t *h, const int *logT, const felm_t *Texp, const fe
     } else {
         if (i_j >= (1 << (ord-2))) {
             i_j = (1 << (ord-1)) - i_j - 1; 
-            d = (1 << (W_2_1)) - d;
+            d = (1 << w1) - d;
             for (int i = 0; i <= k; ++i) inv_Fp2_cycl_proj(H[i]);             
             inv = 1;   
         }
@@ -217,7 +219,7 @@ int ord2w_dloghyb(const felm_t *h, const int *logT, const felm_t *Texp, const fe
 }
 
 
-void Traverse_w_div_e_torus(const felm_t *r, int j, int k, int z, const unsigned int *P, const felm_t *CT, int *D, int Dlen, int ellw, int w)
+void Traverse_w_div_e_torus(const felm_t *r, int j, int k, int z, const unsigned int *P, const felm_t *CT, int *D, int Dlen, int ellw, int w, felm_t *prods)
 {// Traverse a Pohlig-Hellman optimal strategy to solve a discrete log in a group of order 2^e
  // The leaves of the tree will be used to recover the signed digits which are numbers from +/-{0,1... Ceil((2^w-1)/2)}
  // Assume the integer w divides the exponent e
@@ -228,7 +230,7 @@ void Traverse_w_div_e_torus(const felm_t *r, int j, int k, int z, const unsigned
         fp2copy(r, rp);
         for (int i = 0; i < (z-t)*w; i++) sqr_Fp2_cycl_proj(rp);
         
-        Traverse_w_div_e_torus(rp, j + (z - t), k, t, P, CT, D, Dlen, ellw, w);  
+        Traverse_w_div_e_torus(rp, j + (z - t), k, t, P, CT, D, Dlen, ellw, w, prods);  
         
         fp2copy(r, rp);
         for (int h = k; h < k + t; h++) {
@@ -242,12 +244,12 @@ void Traverse_w_div_e_torus(const felm_t *r, int j, int k, int z, const unsigned
                 }
             }
         }
-        Traverse_w_div_e_torus(rp, j, k + t, z - t, P, CT, D, Dlen, ellw, w);
+        Traverse_w_div_e_torus(rp, j, k + t, z - t, P, CT, D, Dlen, ellw, w, prods);
     } else {
         fpcorrection((digit_t*)&r[0]);
         fpcorrection((digit_t*)&r[1]);
 
-        D[k] = ord2w_dloghyb(r, (const int *)&ph2_Log, (const felm_t *)&ph2_Texp, (const felm_t *)&ph2_G);           
+        D[k] = ord2w_dloghyb(r, (const int *)ph2_Log_active, (const felm_t *)ph2_Texp_active, (const felm_t *)ph2_G_active, prods);           
     }
 }
 
@@ -408,23 +410,28 @@ void Traverse_w_notdiv_e_fullsigned(const f2elm_t r, int j, int k, int z, const
 #endif  // Closing COMPRESSED_TABLES
 
 
-void solve_dlog(const f2elm_t r, int *D, digit_t* d, int ell)
+void solve_dlog(const f2elm_t r, int *D, digit_t* d, int ell, felm_t *prods)
 { // Computes the discrete log of input r = g^d where g = e(P,Q)^ell^e, and P,Q are torsion generators in the initial curve
-  // Return the integer d  
+  // Return the integer d. The window sizes and tables are those in use, see sidh_load_tables()
+  // prods is a workspace of PH2_DLOG_PRODS elements for ell = 2, unused for ell = 3
+    const ph_params_t* prm = &ph_params_active;
+
+    PROFILE_PHASE_BEGIN(SIDH_PHASE_DLOG);
     if (ell == 2) {
         felm_t rproj[2];
         toproj(r, rproj);  
-        Traverse_w_div_e_torus(rproj, 0, 0, PLEN_2 - 1, ph2_path, (const felm_t *)&ph2_CT, D, DLEN_2, ELL2_W, W_2);
+        Traverse_w_div_e_torus(rproj, 0, 0, prm->dlen2, ph2_path_active, (const felm_t *)ph2_CT_active, D, prm->dlen2, prm->ellw2, prm->w2, prods);
 
-        from_base(D, d, DLEN_2, ELL2_W);
+        from_base(D, d, prm->dlen2, prm->ellw2);
     } else if (ell == 3) {
-        #if (OBOB_EXPON % W_3 == 0)
-            Traverse_w_div_e_fullsigned(r, 0, 0, PLEN_3 - 1, ph3_path, (const felm_t *)&ph3_T, D, DLEN_3, ELL3_W, W_3);
-        #else          
-            Traverse_w_notdiv_e_fullsigned(r, 0, 0, PLEN_3 - 1, ph3_path, (const felm_t *)&ph3_T1, (const felm_t *)&ph3_T2, D, DLEN_3, ell, ELL3_W, ELL3_EMODW, W_3, OBOB_EXPON);                    
-        #endif     
-        from_base(D, d, DLEN_3, ELL3_W);
+        if (OBOB_EXPON % prm->w3 == 0) {
+            Traverse_w_div_e_fullsigned(r, 0, 0, prm->dlen3, ph3_path_active, (const felm_t *)ph3_T1_active, D, prm->dlen3, prm->ellw3, prm->w3);
+        } else {
+            Traverse_w_notdiv_e_fullsigned(r, 0, 0, prm->dlen3, ph3_path_active, (const felm_t *)ph3_T1_active, (const felm_t *)ph3_T2_active, D, prm->dlen3, ell, prm->ellw3, prm->ell3_emodw, prm->w3, OBOB_EXPON);
+        }
+        from_base(D, d, prm->dlen3, prm->ellw3);
     }    
+    PROFILE_PHASE_END();
 }
 
 
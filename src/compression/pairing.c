@@ -10,51 +10,84 @@
 
 
 #define t_points  2
+#define PAIRING_WORKSPACE    (21*t_points)    // Elements of GF(p^2) of the workspace of the pairing functions
 
 
-static void final_exponentiation_2_torsion(f2elm_t f, const f2elm_t finv, f2elm_t fout)
-{ // The final exponentiation for pairings in the 2^eA-torsion group. Raising the value f to the power (p^2-1)/2^eA.
+static void fp2mul_mont_lanes(f2elm_t* a, f2elm_t* b, f2elm_t* c, const unsigned int nsqr)
+{ // Eight independent GF(p^2) products computed in lockstep, c[i] = a[i]^2 for i < nsqr and c[i] = a[i]*b[i] otherwise
+  // With AVX-512 IFMA the eight lanes are computed with a single 8-way multiplication, b[i] is overwritten for i < nsqr
+#if defined(_AVX512_IFMA_)
+    for (unsigned int i = 0; i < nsqr; i++) {
+        fp2copy(a[i], b[i]);
+    }
+    fp2mul_mont_x8((const f2elm_t*)a, (const f2elm_t*)b, c);
+#else
+    for (unsigned int i = 0; i < 8; i++) {
+        if (i < nsqr) {
+            fp2sqr_mont(a[i], c[i]);
+        } else {
+            fp2mul_mont(a[i], b[i], c[i]);
+        }
+    }
+#endif
+}
+
+
+static void final_exponentiation_2_torsion(f2elm_t* f, const f2elm_t* finv, const unsigned int n)
+{ // The final exponentiation for pairings in the 2^eA-torsion group. Raising the values f[j] to the power (p^2-1)/2^eA, j = 0..n-1.
+  // The cyclotomic cubings of the n independent values are interleaved.
     felm_t one = {0};
-    f2elm_t temp = {0};
-    unsigned int i; 
+    f2elm_t temp;
+    unsigned int i, j; 
 
     fpcopy((digit_t*)&Montgomery_one, one);
     
     // f = f^p
-    fp2_conj(f, temp);
-    fp2mul_mont(temp, finv, temp);              // temp = f^(p-1)
+    for (j = 0; j < n; j++) {
+        fp2_conj(f[j], temp);
+        fp2mul_mont(temp, finv[j], f[j]);       // f = f^(p-1)
+    }
 
     for (i = 0; i < OBOB_EXPON; i++) {
-        cube_Fp2_cycl(temp, one);
+        for (j = 0; j < n; j++) {
+            cube_Fp2_cycl(f[j], one);
+        }
     }
-    fp2copy(temp, fout);
 }
 
 
-static void final_exponentiation_3_torsion(f2elm_t f, const f2elm_t finv, f2elm_t fout)
-{ // The final exponentiation for pairings in the 3-torsion group. Raising the value f to the power (p^2-1)/3^eB.
+static void final_exponentiation_3_torsion(f2elm_t* f, const f2elm_t* finv, const unsigned int n)
+{ // The final exponentiation for pairings in the 3-torsion group. Raising the values f[j] to the power (p^2-1)/3^eB, j = 0..n-1.
+  // The cyclotomic squarings of the n independent values are interleaved.
     felm_t one = {0};
     f2elm_t temp;
-    unsigned int i; 
+    unsigned int i, j; 
 
     fpcopy((digit_t*)&Montgomery_one, one);
     
     // f = f^p
-    fp2_conj(f, temp); 
-    fp2mul_mont(temp, finv, temp);              // temp = f^(p-1)
+    for (j = 0; j < n; j++) {
+        fp2_conj(f[j], temp); 
+        fp2mul_mont(temp, finv[j], f[j]);       // f = f^(p-1)
+    }
 
     for (i = 0; i < OALICE_BITS; i++) {
-        sqr_Fp2_cycl(temp, one);
+        for (j = 0; j < n; j++) {
+            sqr_Fp2_cycl(f[j], one);
+        }
     }
-    fp2copy(temp, fout);
 }
 
 
-void Tate3_pairings(point_full_proj_t *Qj, f2elm_t* f)
-{
+void Tate3_pairings(point_full_proj_t *Qj, f2elm_t* f, f2elm_t* T)
+{ // The 2*t_points pairings of the points Qj in the 3^eB-torsion. T is a workspace of PAIRING_WORKSPACE elements
     felm_t *x, *y, *l1, *l2, *n1, *n2, *x2, *x23, *x2p3;
-    f2elm_t xQ2s[t_points], finv[2*t_points], one = {0};
-    f2elm_t t0, t1, t2, t3, t4, t5, g, h, tf;
+    f2elm_t *xQ2s = T, *finv = T + t_points, one = {0};
+    f2elm_t t0, t1, t2, t4, t5, g, h, tf;
+    f2elm_t *A = T + 3*t_points, *B = T + 7*t_points, *C = T + 11*t_points, *D = T + 15*t_points, *H = T + 19*t_points;
+    PROFILE_PHASE_BEGIN(SIDH_PHASE_PAIRING);
+
+    memset(A, 0, 8*t_points*sizeof(f2elm_t));    // A and B
 
     fpcopy((digit_t*)&Montgomery_one, one[0]);
 
@@ -64,13 +97,18 @@ void Tate3_pairings(point_full_proj_t *Qj, f2elm_t* f)
         fp2sqr_mont(Qj[j]->X, xQ2s[j]);
     }
 
+    // The 2*t_points Miller loops run in lockstep: lanes 0..2*t_points-1 of A hold the Miller values f[j], and the 
+    // remaining lanes hold the line functions of the current step, so that every step takes three rounds of products
+    for (int j = 0; j < 2*t_points; j++) {
+        fp2copy(f[j], A[j]);
+    }
     for (int k = 0; k < OBOB_EXPON - 1; k++) {
-        l1   = (felm_t*)T_tate3 + 6*k + 0;
-        l2   = (felm_t*)T_tate3 + 6*k + 1;
-        n1   = (felm_t*)T_tate3 + 6*k + 2;
-        n2   = (felm_t*)T_tate3 + 6*k + 3;
-        x23  = (felm_t*)T_tate3 + 6*k + 4;
-        x2p3 = (felm_t*)T_tate3 + 6*k + 5;
+        l1   = (felm_t*)T_tate3_active + 6*k + 0;
+        l2   = (felm_t*)T_tate3_active + 6*k + 1;
+        n1   = (felm_t*)T_tate3_active + 6*k + 2;
+        n2   = (felm_t*)T_tate3_active + 6*k + 3;
+        x23  = (felm_t*)T_tate3_active + 6*k + 4;
+        x2p3 = (felm_t*)T_tate3_active + 6*k + 5;
         for (int j = 0; j < t_points; j++) {
             fpmul_mont(Qj[j]->X[0], *l1, t0[0]);
             fpmul_mont(Qj[j]->X[1], *l1, t0[1]);
@@ -81,43 +119,43 @@ void Tate3_pairings(point_full_proj_t *Qj, f2elm_t* f)
             fpmul_mont(Qj[j]->X[0], *x2p3, t5[0]);
             fpmul_mont(Qj[j]->X[1], *x2p3, t5[1]);
 
-            fp2sub(t0, Qj[j]->Y, t1);
-            fpadd(t1[0], *n1, t1[0]);
-            fp2sub(t2, Qj[j]->Y, t3);
-            fpadd(t3[0], *n2, t3[0]);
-            fp2mul_mont(t1, t3, g);
-            fp2sub(t4, t5, h);
-            fp2_conj(h, h);
-            fp2mul_mont(g, h, g);
-
-            fp2sqr_mont(f[j], tf);
-            fp2mul_mont(f[j], tf, f[j]);
-            fp2mul_mont(f[j], g, f[j]);
-
-            fpsub(t0[1], Qj[j]->Y[0], t1[0]);
-            fpadd(t0[0], Qj[j]->Y[1], t1[1]);
-            fpneg(t1[1]);
-            fpadd(t1[1], *n1, t1[1]);
-            fpsub(t2[1], Qj[j]->Y[0], t3[0]);
-            fpadd(t2[0], Qj[j]->Y[1], t3[1]);
-            fpneg(t3[1]);
-            fpadd(t3[1], *n2, t3[1]);
-
-            fp2mul_mont(t1, t3, g);
-            fp2add(t4, t5, h);
-            fp2_conj(h, h);
-            fp2mul_mont(g, h, g);
-
-            fp2sqr_mont(f[j+t_points], tf);
-            fp2mul_mont(f[j+t_points], tf, f[j+t_points]);
-            fp2mul_mont(f[j+t_points], g, f[j+t_points]);
+            fp2sub(t0, Qj[j]->Y, A[2*t_points+j]);
+            fpadd(A[2*t_points+j][0], *n1, A[2*t_points+j][0]);
+            fp2sub(t2, Qj[j]->Y, B[2*t_points+j]);
+            fpadd(B[2*t_points+j][0], *n2, B[2*t_points+j][0]);
+            fp2sub(t4, t5, H[j]);
+            fp2_conj(H[j], H[j]);
+
+            fpsub(t0[1], Qj[j]->Y[0], A[3*t_points+j][0]);
+            fpadd(t0[0], Qj[j]->Y[1], A[3*t_points+j][1]);
+            fpneg(A[3*t_points+j][1]);
+            fpadd(A[3*t_points+j][1], *n1, A[3*t_points+j][1]);
+            fpsub(t2[1], Qj[j]->Y[0], B[3*t_points+j][0]);
+            fpadd(t2[0], Qj[j]->Y[1], B[3*t_points+j][1]);
+            fpneg(B[3*t_points+j][1]);
+            fpadd(B[3*t_points+j][1], *n2, B[3*t_points+j][1]);
+            fp2add(t4, t5, H[j+t_points]);
+            fp2_conj(H[j+t_points], H[j+t_points]);
+        }
+
+        fp2mul_mont_lanes(A, B, C, 2*t_points);                 // C = (f^2, line products)
+        for (int j = 0; j < 2*t_points; j++) {
+            fp2copy(A[j], B[j]);
+            fp2copy(H[j], B[2*t_points+j]);
+        }
+        fp2mul_mont_lanes(C, B, D, 0);                          // D = (f^3, g)
+        for (int j = 0; j < 2*t_points; j++) {
+            fp2mul_mont(D[j], D[2*t_points+j], A[j]);           // f = f^3*g
         }
     }
+    for (int j = 0; j < 2*t_points; j++) {
+        fp2copy(A[j], f[j]);
+    }
     for (int j = 0; j < t_points; j++) {
-        x  = (felm_t*)T_tate3 + 6*(OBOB_EXPON-1) + 0;
-        y  = (felm_t*)T_tate3 + 6*(OBOB_EXPON-1) + 1;
-        l1 = (felm_t*)T_tate3 + 6*(OBOB_EXPON-1) + 2;
-        x2 = (felm_t*)T_tate3 + 6*(OBOB_EXPON-1) + 3;
+        x  = (felm_t*)T_tate3_active + 6*(OBOB_EXPON-1) + 0;
+        y  = (felm_t*)T_tate3_active + 6*(OBOB_EXPON-1) + 1;
+        l1 = (felm_t*)T_tate3_active + 6*(OBOB_EXPON-1) + 2;
+        x2 = (felm_t*)T_tate3_active + 6*(OBOB_EXPON-1) + 3;
         
         fpsub(Qj[j]->X[0], *x, t0[0]);
         fpcopy(Qj[j]->X[1], t0[1]);
@@ -151,17 +189,20 @@ void Tate3_pairings(point_full_proj_t *Qj, f2elm_t* f)
 
     // Final exponentiation:
     mont_n_way_inv(f, 2*t_points, finv);
-    for (int j = 0; j < 2*t_points; j++) {
-        final_exponentiation_3_torsion(f[j], finv[j], f[j]);
-    }
+    final_exponentiation_3_torsion(f, finv, 2*t_points);
+    PROFILE_PHASE_END();
 }
 
 
-void Tate2_pairings(const point_t P, const point_t Q, point_full_proj_t *Qj, f2elm_t* f)
-{
-    felm_t *x, *y, *x_, *y_, *l1;
-    f2elm_t finv[2*t_points], one = {0};
+void Tate2_pairings(const point_t P, const point_t Q, point_full_proj_t *Qj, f2elm_t* f, f2elm_t* T)
+{ // The pairings of the points Qj with P and Q in the 2^eA-torsion. T is a workspace of PAIRING_WORKSPACE elements
+    felm_t *xP, *yP, *xQ, *yQ, *x_, *y_, *l1;
+    f2elm_t *finv = T, one = {0};
     f2elm_t *x_first, *y_first, l1_first, t0, t1, g, h;
+    f2elm_t *A = T + 2*t_points, *B = T + 6*t_points, *C = T + 10*t_points;
+    PROFILE_PHASE_BEGIN(SIDH_PHASE_PAIRING);
+
+    memset(A, 0, 8*t_points*sizeof(f2elm_t));    // A and B
     
     fpcopy((digit_t*)&Montgomery_one, one[0]);
 
@@ -170,14 +211,14 @@ void Tate2_pairings(const point_t P, const point_t Q, point_full_proj_t *Qj, f2e
         fp2copy(one, f[j+t_points]);
     }
 
-    // Pairings with P
+    // First step of the pairings with P
     x_first = (f2elm_t*)P->x;
     y_first = (f2elm_t*)P->y;
 
-    x_ = (felm_t*)T_tate2_firststep_P + 0;
-    y_ = (felm_t*)T_tate2_firststep_P + 1;
-    fpcopy((digit_t*)T_tate2_firststep_P + 2*NWORDS_FIELD, l1_first[0]);         
-    fpcopy((digit_t*)T_tate2_firststep_P + 3*NWORDS_FIELD, l1_first[1]);         
+    xP = (felm_t*)T_tate2_firststep_P_active + 0;
+    yP = (felm_t*)T_tate2_firststep_P_active + 1;
+    fpcopy((digit_t*)T_tate2_firststep_P_active + 2*NWORDS_FIELD, l1_first[0]);         
+    fpcopy((digit_t*)T_tate2_firststep_P_active + 3*NWORDS_FIELD, l1_first[1]);         
     
     for (int j = 0; j < t_points; j++) {
         fp2sub(Qj[j]->X, *x_first, t0);
@@ -185,7 +226,7 @@ void Tate2_pairings(const point_t P, const point_t Q, point_full_proj_t *Qj, f2e
         fp2mul_mont(l1_first, t0, t0);
         fp2sub(t0, t1, g);
 
-        fpsub(Qj[j]->X[0], *x_, h[0]);
+        fpsub(Qj[j]->X[0], *xP, h[0]);
         fpcopy(Qj[j]->X[1], h[1]);
         fpneg(h[1]);
         fp2mul_mont(g, h, g);
@@ -193,46 +234,14 @@ void Tate2_pairings(const point_t P, const point_t Q, point_full_proj_t *Qj, f2e
         fp2sqr_mont(f[j], f[j]);
         fp2mul_mont(f[j], g, f[j]);
     }
-    x = x_;
-    y = y_;
-    
-    for (int k = 0; k < OALICE_BITS - 2; k++) {
-        x_ = (felm_t*)T_tate2_P + 3 * k + 0;
-        y_ = (felm_t*)T_tate2_P + 3 * k + 1;
-        l1 = (felm_t*)T_tate2_P + 3 * k + 2;
-        for (int j = 0; j < t_points; j++) {
-            fpsub(*x, Qj[j]->X[0], t0[1]);
-            fpmul_mont(*l1, t0[1], t0[1]);
-            fpmul_mont(*l1, Qj[j]->X[1], t0[0]);
-            fpsub(Qj[j]->Y[1], *y, t1[1]);
-            fpsub(t0[1], t1[1], g[1]);
-            fpsub(t0[0], Qj[j]->Y[0], g[0]);
-
-            fpsub(Qj[j]->X[0], *x_, h[0]);
-            fpcopy(Qj[j]->X[1], h[1]);
-            fpneg(h[1]);
-            fp2mul_mont(g, h, g);
 
-            fp2sqr_mont(f[j], f[j]);
-            fp2mul_mont(f[j], g, f[j]);
-        }
-        x = x_;
-        y = y_;
-    }
-    for (int j = 0; j < t_points; j++) {
-        fpsub(Qj[j]->X[0], *x, g[0]);
-        fpcopy(Qj[j]->X[1], g[1]);
-        fp2sqr_mont(f[j], f[j]);
-        fp2mul_mont(f[j], g, f[j]);
-    }
-
-    // Pairings with Q
+    // First step of the pairings with Q
     x_first = (f2elm_t*)Q->x;
     y_first = (f2elm_t*)Q->y; 
-    x_ = (felm_t*)T_tate2_firststep_Q + 0;
-    y_ = (felm_t*)T_tate2_firststep_Q + 1;
-    fpcopy(((felm_t*)T_tate2_firststep_Q)[2], l1_first[0]);
-    fpcopy(((felm_t*)T_tate2_firststep_Q)[3], l1_first[1]);
+    xQ = (felm_t*)T_tate2_firststep_Q_active + 0;
+    yQ = (felm_t*)T_tate2_firststep_Q_active + 1;
+    fpcopy(((felm_t*)T_tate2_firststep_Q_active)[2], l1_first[0]);
+    fpcopy(((felm_t*)T_tate2_firststep_Q_active)[3], l1_first[1]);
 
     for (int j = 0; j < t_points; j++) {
         fp2sub(Qj[j]->X, *x_first, t0);
@@ -240,7 +249,7 @@ void Tate2_pairings(const point_t P, const point_t Q, point_full_proj_t *Qj, f2e
         fp2mul_mont(l1_first, t0, t0);
         fp2sub(t0, t1, g);
 
-        fpsub(Qj[j]->X[0], *x_, h[0]);
+        fpsub(Qj[j]->X[0], *xQ, h[0]);
         fpcopy(Qj[j]->X[1], h[1]);
         fpneg(h[1]);
         fp2mul_mont(g, h, g);
@@ -248,45 +257,74 @@ void Tate2_pairings(const point_t P, const point_t Q, point_full_proj_t *Qj, f2e
         fp2sqr_mont(f[j+t_points], f[j+t_points]);
         fp2mul_mont(f[j+t_points], g, f[j+t_points]);
     }
-    x = x_;
-    y = y_;
-    
+
+    // The pairings with P and Q run in lockstep: lanes 0..2*t_points-1 of A hold the Miller values f[j], and the 
+    // remaining lanes of A and B hold the two factors of the line functions of the current step
+    for (int j = 0; j < 2*t_points; j++) {
+        fp2copy(f[j], A[j]);
+    }
     for (int k = 0; k < OALICE_BITS - 2; k++) {
-        x_ = (felm_t*)T_tate2_Q + 3*k + 0;
-        y_ = (felm_t*)T_tate2_Q + 3*k + 1;
-        l1 = (felm_t*)T_tate2_Q + 3*k + 2;
+        x_ = (felm_t*)T_tate2_P_active + 3*k + 0;
+        y_ = (felm_t*)T_tate2_P_active + 3*k + 1;
+        l1 = (felm_t*)T_tate2_P_active + 3*k + 2;
         for (int j = 0; j < t_points; j++) {
-            fpsub(Qj[j]->X[0], *x, t0[0]);
+            fpsub(*xP, Qj[j]->X[0], t0[1]);
+            fpmul_mont(*l1, t0[1], t0[1]);
+            fpmul_mont(*l1, Qj[j]->X[1], t0[0]);
+            fpsub(Qj[j]->Y[1], *yP, t1[1]);
+            fpsub(t0[1], t1[1], A[2*t_points+j][1]);
+            fpsub(t0[0], Qj[j]->Y[0], A[2*t_points+j][0]);
+
+            fpsub(Qj[j]->X[0], *x_, B[2*t_points+j][0]);
+            fpcopy(Qj[j]->X[1], B[2*t_points+j][1]);
+            fpneg(B[2*t_points+j][1]);
+        }
+        xP = x_;
+        yP = y_;
+
+        x_ = (felm_t*)T_tate2_Q_active + 3*k + 0;
+        y_ = (felm_t*)T_tate2_Q_active + 3*k + 1;
+        l1 = (felm_t*)T_tate2_Q_active + 3*k + 2;
+        for (int j = 0; j < t_points; j++) {
+            fpsub(Qj[j]->X[0], *xQ, t0[0]);
             fpmul_mont(*l1, t0[0], t0[0]);
             fpmul_mont(*l1, Qj[j]->X[1], t0[1]);
-            fpsub(Qj[j]->Y[0], *y, t1[0]);
-            fpsub(t0[0], t1[0], g[0]);
-            fpsub(t0[1], Qj[j]->Y[1], g[1]);
+            fpsub(Qj[j]->Y[0], *yQ, t1[0]);
+            fpsub(t0[0], t1[0], A[3*t_points+j][0]);
+            fpsub(t0[1], Qj[j]->Y[1], A[3*t_points+j][1]);
 
-            fpsub(Qj[j]->X[0], *x_, h[0]);
-            fpcopy(Qj[j]->X[1], h[1]);
-            fpneg(h[1]);
-            fp2mul_mont(g, h, g);
+            fpsub(Qj[j]->X[0], *x_, B[3*t_points+j][0]);
+            fpcopy(Qj[j]->X[1], B[3*t_points+j][1]);
+            fpneg(B[3*t_points+j][1]);
+        }
+        xQ = x_;
+        yQ = y_;
 
-            fp2sqr_mont(f[j+t_points], f[j+t_points]);
-            fp2mul_mont(f[j+t_points], g, f[j+t_points]);
+        fp2mul_mont_lanes(A, B, C, 2*t_points);                 // C = (f^2, g)
+        for (int j = 0; j < 2*t_points; j++) {
+            fp2mul_mont(C[j], C[2*t_points+j], A[j]);           // f = f^2*g
         }
-        x = x_;
-        y = y_;
     }
+    for (int j = 0; j < 2*t_points; j++) {
+        fp2copy(A[j], f[j]);
+    }
+
     // Last iteration
     for (int j = 0; j < t_points; j++) {
-        fpsub(Qj[j]->X[0], *x, g[0]);
+        fpsub(Qj[j]->X[0], *xP, g[0]);
         fpcopy(Qj[j]->X[1], g[1]);
+        fp2sqr_mont(f[j], f[j]);
+        fp2mul_mont(f[j], g, f[j]);
 
+        fpsub(Qj[j]->X[0], *xQ, g[0]);
+        fpcopy(Qj[j]->X[1], g[1]);
         fp2sqr_mont(f[j+t_points], f[j+t_points]);
         fp2mul_mont(f[j+t_points], g, f[j+t_points]);
     }
 
     // Final exponentiation:
     mont_n_way_inv(f, 2*t_points, finv);
-    for (int j = 0; j < 2*t_points; j++) {
-        final_exponentiation_2_torsion(f[j], finv[j], f[j]);
-    }
+    final_exponentiation_2_torsion(f, finv, 2*t_points);
+    PROFILE_PHASE_END();
 }
 
@@ -11,7 +11,45 @@
 #include "../random/random.h"
 #include <string.h>
 
-
+#define MAX_INT_POINTS    ((MAX_INT_POINTS_ALICE > MAX_INT_POINTS_BOB) ? MAX_INT_POINTS_ALICE : MAX_INT_POINTS_BOB)
+#define VALIDATE_BATCH_SIZE    4    // Number of ciphertexts of validate_ciphertext_batch, two products each fill the eight lanes
+
+// Large temporaries of the compressed operations. The functions with suffix _ex take them from a caller-supplied 
+// workspace of SIDH_WORKSPACE_BYTES bytes, the other functions from the stack
+typedef struct {
+    f2elm_t As[MAX_Alice+1][5];                // Curves and dual kernels of Alice's 4-isogenies
+    point_proj_t pts[MAX_INT_POINTS_ALICE];    // Points of the tree traversal
+    f2elm_t pairing[PAIRING_WORKSPACE];
+} keygen_A_workspace;
+
+typedef struct {
+    f2elm_t Ds[MAX_Bob][2];                    // Dual kernels of Bob's 3-isogenies
+    point_proj_t pts[MAX_INT_POINTS_BOB];
+    f2elm_t pairing[PAIRING_WORKSPACE];
+    felm_t dlog[PH2_DLOG_PRODS];               // Products of the discrete logs in the 2^eA-torsion
+} keygen_B_workspace;
+
+typedef struct {
+    point_proj_t pts[MAX_INT_POINTS];          // Points of the tree traversals of the shared secrets and the ciphertext validation
+} agreement_workspace;
+
+typedef struct {
+    point_proj_t pts[MAX_INT_POINTS_BOB][VALIDATE_BATCH_SIZE];    // Points of the lockstep tree traversals, by point
+} validate_batch_workspace;
+
+typedef union {                                // The operations of a SIKE call run one after the other and share the workspace
+    keygen_A_workspace keygen_A;
+    keygen_B_workspace keygen_B;
+    agreement_workspace agreement;
+} sidh_workspace;
+
+_Static_assert(sizeof(sidh_workspace) + sizeof(digit_t) - 1 <= SIDH_WORKSPACE_BYTES, "SIDH_WORKSPACE_BYTES is too small");
+
+
+static sidh_workspace* workspace_align(void* workspace)
+{ // Caller-supplied workspaces need not be aligned
+    return (sidh_workspace*)(((uintptr_t)workspace + sizeof(digit_t) - 1) & ~(uintptr_t)(sizeof(digit_t) - 1));
+}
 
 
 static void init_basis(digit_t *gen, f2elm_t XP, f2elm_t XQ, f2elm_t XR)
@@ -54,11 +92,11 @@ void random_mod_order_B(unsigned char* random_digits)
 }
 
 
-static void FullIsogeny_A_dual(unsigned char* PrivateKeyA, f2elm_t As[][5], f2elm_t a24, unsigned int sike)
+static void FullIsogeny_A_dual(unsigned char* PrivateKeyA, f2elm_t As[][5], f2elm_t a24, unsigned int sike, point_proj_t* pts)
 {
   // Input:  a private key PrivateKeyA in the range [0, 2^eA - 1]. 
   // Output: the public key PublicKeyA consisting of 3 elements in GF(p^2) which are encoded by removing leading 0 bytes.
-    point_proj_t R, pts[MAX_INT_POINTS_ALICE];
+    point_proj_t R;
     f2elm_t XPA, XQA, XRA, coeff[5], A24 = {0}, C24 = {0}, A = {0};
     unsigned int i, row, m, index = 0, pts_index[MAX_INT_POINTS_ALICE], npts = 0, ii = 0;
     digit_t SecretKeyA[NWORDS_ORDER] = {0};
@@ -82,6 +120,7 @@ static void FullIsogeny_A_dual(unsigned char* PrivateKeyA, f2elm_t As[][5], f2el
     fpzero(R->Z[1]); 
     if (sike == 1)
         fp2_encode(R->X, &PrivateKeyA[SECRETKEY_A_BYTES + CRYPTO_PUBLICKEYBYTES]);  // privA ||= x(KA) = x(PA + sk_A*QA)
+    PROFILE_PHASE_BEGIN(SIDH_PHASE_TRAVERSAL);
     
 #if (OALICE_BITS % 2 == 1)
     point_proj_t S;
@@ -123,6 +162,7 @@ static void FullIsogeny_A_dual(unsigned char* PrivateKeyA, f2elm_t As[][5], f2el
     fp2copy(C24, As[MAX_Alice-1][1]);
     get_4_isog_dual(R, A24, C24, coeff);
     eval_dual_4_isog_shared(coeff[2], coeff[3], coeff[4], *(As+MAX_Alice-1)+2);
+    PROFILE_PHASE_END();
     fp2copy(A24, As[MAX_Alice][0]);
     fp2copy(C24, As[MAX_Alice][1]);
     fp2inv_mont_bingcd(C24);
@@ -132,10 +172,10 @@ static void FullIsogeny_A_dual(unsigned char* PrivateKeyA, f2elm_t As[][5], f2el
 
 static void Dlogs3_dual(const f2elm_t *f, int *D, digit_t *d0, digit_t *c0, digit_t *d1, digit_t *c1)
 {
-    solve_dlog(f[0], D, d0, 3);    
-    solve_dlog(f[2], D, c0, 3);
-    solve_dlog(f[1], D, d1, 3);     
-    solve_dlog(f[3], D, c1, 3);    
+    solve_dlog(f[0], D, d0, 3, NULL);    
+    solve_dlog(f[2], D, c0, 3, NULL);
+    solve_dlog(f[1], D, d1, 3, NULL);     
+    solve_dlog(f[3], D, c1, 3, NULL);    
     mp_sub((digit_t*)Bob_order, c0, c0, NWORDS_ORDER);    
     mp_sub((digit_t*)Bob_order, c1, c1, NWORDS_ORDER);  
 }
@@ -253,18 +293,18 @@ static void Compress_PKA_dual(digit_t *d0, digit_t *c0, digit_t *d1, digit_t *c1
 }
 
 
-static int EphemeralKeyGeneration_A_extended(unsigned char* PrivateKeyA, unsigned char* CompressedPKA)
-{ // Alice's ephemeral public key generation using compression -- SIKE protocol
-  // Output: PrivateKeyA[MSG_BYTES + SECRETKEY_A_BYTES] <- x(K_A) where K_A = PA + sk_A*Q_A 
+static int EphemeralKeyGeneration_A_extended(unsigned char* PrivateKeyA, unsigned char* CompressedPKA, unsigned int sike, keygen_A_workspace* ws)
+{ // Alice's ephemeral public key generation using compression -- SIKE protocol (sike = 1) or SIDH protocol (sike = 0)
+  // Output (SIKE): PrivateKeyA[MSG_BYTES + SECRETKEY_A_BYTES] <- x(K_A) where K_A = PA + sk_A*Q_A 
     unsigned int rs[3];
     int D[DLEN_3];
-    f2elm_t a24, As[MAX_Alice+1][5], f[4];
+    f2elm_t a24, f[4];
     digit_t c0[NWORDS_ORDER] = {0}, d0[NWORDS_ORDER] = {0}, c1[NWORDS_ORDER] = {0}, d1[NWORDS_ORDER] = {0}; 
     point_full_proj_t Rs[2];
 
-    FullIsogeny_A_dual(PrivateKeyA, As, a24, 1);
-    BuildOrdinary3nBasis_dual(a24, As, Rs, rs, &rs[2]);
-    Tate3_pairings(Rs, f);
+    FullIsogeny_A_dual(PrivateKeyA, ws->As, a24, sike, ws->pts);
+    BuildOrdinary3nBasis_dual(a24, ws->As, Rs, rs, &rs[2]);
+    Tate3_pairings(Rs, f, ws->pairing);
     Dlogs3_dual(f, D, d0, c0, d1, c1);
     Compress_PKA_dual(d0, c0, d1, c1, a24, rs, CompressedPKA);
     return 0;
@@ -273,23 +313,20 @@ static int EphemeralKeyGeneration_A_extended(unsigned char* PrivateKeyA, unsigne
 
 int EphemeralKeyGeneration_A(const unsigned char* PrivateKeyA, unsigned char* CompressedPKA)
 { // Alice's ephemeral public key generation using compression -- SIDH protocol
-  // Output: PrivateKeyA[MSG_BYTES + SECRETKEY_A_BYTES] <- x(K_A) where K_A = PA + sk_A*Q_A 
-    unsigned int rs[3];
-    int D[DLEN_3];
-    f2elm_t a24, As[MAX_Alice+1][5], f[4];
-    digit_t c0[NWORDS_ORDER] = {0}, d0[NWORDS_ORDER] = {0}, c1[NWORDS_ORDER] = {0}, d1[NWORDS_ORDER] = {0}; 
-    point_full_proj_t Rs[2];
+    keygen_A_workspace ws;
 
-    FullIsogeny_A_dual((unsigned char*)PrivateKeyA, As, a24, 0);
-    BuildOrdinary3nBasis_dual(a24, As, Rs, rs, &rs[2]);
-    Tate3_pairings(Rs, f);
-    Dlogs3_dual(f, D, d0, c0, d1, c1);
-    Compress_PKA_dual(d0, c0, d1, c1, a24, rs, CompressedPKA);
-    return 0;
+    return EphemeralKeyGeneration_A_extended((unsigned char*)PrivateKeyA, CompressedPKA, 0, &ws);
 }
 
 
-int EphemeralSecretAgreement_B(const unsigned char* PrivateKeyB, const unsigned char* PKA, unsigned char* SharedSecretB)
+int EphemeralKeyGeneration_A_ex(const unsigned char* PrivateKeyA, unsigned char* CompressedPKA, void* workspace)
+{ // Alice's ephemeral public key generation using compression, with the temporaries in workspace -- SIDH protocol
+
+    return EphemeralKeyGeneration_A_extended((unsigned char*)PrivateKeyA, CompressedPKA, 0, &workspace_align(workspace)->keygen_A);
+}
+
+
+static int EphemeralSecretAgreement_B_extended(const unsigned char* PrivateKeyB, const unsigned char* PKA, unsigned char* SharedSecretB, agreement_workspace* ws)
 { // Bob's ephemeral shared secret computation using compression
   // It produces a shared secret key SharedSecretB using his secret key PrivateKeyB and Alice's decompressed data point_R and param_A
   // Inputs: Bob's PrivateKeyB is an integer in the range [1, oB-1], where oB = 3^OBOB_EXP. 
@@ -297,7 +334,7 @@ int EphemeralSecretAgreement_B(const unsigned char* PrivateKeyB, const unsigned
   // Output: a shared secret SharedSecretB that consists of one element in GF(p^2). 
     unsigned int i, ii = 0, row, m, index = 0, pts_index[MAX_INT_POINTS_BOB], npts = 0;
     f2elm_t A24plus = {0}, A24minus = {0};
-    point_proj_t R, pts[MAX_INT_POINTS_BOB];
+    point_proj_t R, *pts = ws->pts;
     f2elm_t jinv, A, coeff[3];
     f2elm_t param_A = {0};
 
@@ -307,6 +344,7 @@ int EphemeralSecretAgreement_B(const unsigned char* PrivateKeyB, const unsigned
     fpadd((digit_t*)&Montgomery_one, (digit_t*)&Montgomery_one, A24minus[0]);
     fp2add(A, A24minus, A24plus);
     fp2sub(A, A24minus, A24minus);
+    PROFILE_PHASE_BEGIN(SIDH_PHASE_TRAVERSAL);
         
     // Traverse tree
     index = 0;
@@ -332,6 +370,7 @@ int EphemeralSecretAgreement_B(const unsigned char* PrivateKeyB, const unsigned
     }
      
     get_3_isog(R, A24minus, A24plus, coeff);
+    PROFILE_PHASE_END();
     fp2add(A24plus, A24minus, A);
     fp2add(A, A, A);
     fp2sub(A24plus, A24minus, A24plus);
@@ -342,11 +381,26 @@ int EphemeralSecretAgreement_B(const unsigned char* PrivateKeyB, const unsigned
 }
 
 
-static void FullIsogeny_B_dual(const unsigned char* PrivateKeyB, f2elm_t Ds[][2], f2elm_t A)
+int EphemeralSecretAgreement_B(const unsigned char* PrivateKeyB, const unsigned char* PKA, unsigned char* SharedSecretB)
+{ // Bob's ephemeral shared secret computation using compression -- SIDH protocol
+    agreement_workspace ws;
+
+    return EphemeralSecretAgreement_B_extended(PrivateKeyB, PKA, SharedSecretB, &ws);
+}
+
+
+int EphemeralSecretAgreement_B_ex(const unsigned char* PrivateKeyB, const unsigned char* PKA, unsigned char* SharedSecretB, void* workspace)
+{ // Bob's ephemeral shared secret computation using compression, with the temporaries in workspace -- SIDH protocol
+
+    return EphemeralSecretAgreement_B_extended(PrivateKeyB, PKA, SharedSecretB, &workspace_align(workspace)->agreement);
+}
+
+
+static void FullIsogeny_B_dual(const unsigned char* PrivateKeyB, f2elm_t Ds[][2], f2elm_t A, point_proj_t* pts)
 { // Bob's ephemeral public key generation
   // Input:  a private key PrivateKeyB in the range [0, 2^Floor(Log(2,oB)) - 1]. 
   // Output: the public key PublicKeyB consisting of 3 elements in GF(p^2) which are encoded by removing leading 0 bytes.
-    point_proj_t R = {0}, Q3 = {0}, pts[MAX_INT_POINTS_BOB];
+    point_proj_t R = {0}, Q3 = {0};
     f2elm_t XPB, XQB, XRB, coeff[3], A24plus = {0}, A24minus = {0};
     unsigned int i, row, m, index = 0, pts_index[MAX_INT_POINTS_BOB], npts = 0, ii = 0;
     digit_t SecretKeyB[NWORDS_ORDER] = {0};
@@ -367,6 +421,7 @@ static void FullIsogeny_B_dual(const unsigned char* PrivateKeyB, f2elm_t Ds[][2]
     // Retrieve kernel point
     decode_to_digits(PrivateKeyB, SecretKeyB, SECRETKEY_B_BYTES, NWORDS_ORDER);    
     LADDER3PT(XPB, XQB, XRB, SecretKeyB, BOB, R, A);
+    PROFILE_PHASE_BEGIN(SIDH_PHASE_TRAVERSAL);
     
     // Traverse tree
     index = 0;
@@ -396,6 +451,7 @@ static void FullIsogeny_B_dual(const unsigned char* PrivateKeyB, f2elm_t Ds[][2]
     eval_3_isog(Q3, coeff);    // Kernel of dual 
     fp2sub(Q3->X, Q3->Z, Ds[MAX_Bob-1][0]);
     fp2add(Q3->X, Q3->Z, Ds[MAX_Bob-1][1]);
+    PROFILE_PHASE_END();
 
     fp2add(A24plus, A24minus, A);
     fp2sub(A24plus, A24minus, A24plus);
@@ -405,12 +461,12 @@ static void FullIsogeny_B_dual(const unsigned char* PrivateKeyB, f2elm_t Ds[][2]
 }
 
 
-static void Dlogs2_dual(const f2elm_t *f, int *D, digit_t *d0, digit_t *c0, digit_t *d1, digit_t *c1)
+static void Dlogs2_dual(const f2elm_t *f, int *D, digit_t *d0, digit_t *c0, digit_t *d1, digit_t *c1, felm_t *prods)
 {
-    solve_dlog(f[0], D, d0, 2);
-    solve_dlog(f[2], D, c0, 2);
-    solve_dlog(f[1], D, d1, 2);
-    solve_dlog(f[3], D, c1, 2);
+    solve_dlog(f[0], D, d0, 2, prods);
+    solve_dlog(f[2], D, c0, 2, prods);
+    solve_dlog(f[1], D, d1, 2, prods);
+    solve_dlog(f[3], D, c1, 2, prods);
     mp_sub((digit_t*)Alice_order, c0, c0, NWORDS_ORDER);
     mp_sub((digit_t*)Alice_order, c1, c1, NWORDS_ORDER);
 }
@@ -621,17 +677,17 @@ static void Compress_PKB_dual(digit_t *d0, digit_t *c0, digit_t *d1, digit_t *c1
 }
 
 
-static int EphemeralKeyGeneration_B_extended(const unsigned char* PrivateKeyB, unsigned char* CompressedPKB, unsigned int sike)
-{ // Bob's ephemeral public key generation using compression -- SIKE protocol
+static int EphemeralKeyGeneration_B_extended(const unsigned char* PrivateKeyB, unsigned char* CompressedPKB, unsigned int sike, keygen_B_workspace* ws)
+{ // Bob's ephemeral public key generation using compression -- SIKE protocol (sike = 1) or SIDH protocol (sike = 0)
     unsigned char qnr, ind;
     int D[DLEN_2] = {0};
     digit_t c0[NWORDS_ORDER] = {0}, d0[NWORDS_ORDER] = {0}, c1[NWORDS_ORDER] = {0}, d1[NWORDS_ORDER] = {0}; 
-    f2elm_t Ds[MAX_Bob][2] = {0}, f[4] = {0}, A = {0};
+    f2elm_t f[4] = {0}, A = {0};
     point_full_proj_t Rs[2] = {0};
     point_t Pw, Qw;
 
-    FullIsogeny_B_dual(PrivateKeyB, Ds, A);
-    BuildOrdinary2nBasis_dual(A, Ds, Rs, &qnr, &ind);  // Generate a basis in E_A and pulls it back to E_A6. Rs[0] and Rs[1] affinized.
+    FullIsogeny_B_dual(PrivateKeyB, ws->Ds, A, ws->pts);    // Every row of Ds is written
+    BuildOrdinary2nBasis_dual(A, ws->Ds, Rs, &qnr, &ind);  // Generate a basis in E_A and pulls it back to E_A6. Rs[0] and Rs[1] affinized.
 
     // Maps from y^2 = x^3 + 6x^2 + x into y^2 = x^3 -11x + 14
     fpadd((digit_t*)Montgomery_one, (Rs[0]->X)[0], (Rs[0]->X)[0]);
@@ -647,13 +703,13 @@ static int EphemeralKeyGeneration_B_extended(const unsigned char* PrivateKeyB, u
     fpcopy((digit_t*)A_basis_zero + 5*NWORDS_FIELD, Qw->x[1]);
     fpcopy((digit_t*)A_basis_zero + 6*NWORDS_FIELD, Qw->y[0]);
     fpcopy((digit_t*)A_basis_zero + 7*NWORDS_FIELD, Qw->y[1]);
-    Tate2_pairings(Pw, Qw, Rs, f);
+    Tate2_pairings(Pw, Qw, Rs, f, ws->pairing);
     fp2correction(f[0]);
     fp2correction(f[1]);
     fp2correction(f[2]);
     fp2correction(f[3]);
 
-    Dlogs2_dual(f, D, d0, c0, d1, c1);
+    Dlogs2_dual(f, D, d0, c0, d1, c1, ws->dlog);
     if (sike == 1)
         Compress_PKB_dual_extended(d0, c0, d1, c1, A, qnr, ind, CompressedPKB);  
     else
@@ -665,21 +721,31 @@ static int EphemeralKeyGeneration_B_extended(const unsigned char* PrivateKeyB, u
 
 int EphemeralKeyGeneration_B(const unsigned char* PrivateKeyB, unsigned char* CompressedPKB)
 { // Bob's ephemeral public key generation using compression -- SIDH protocol
+    keygen_B_workspace ws;
+
+    return EphemeralKeyGeneration_B_extended(PrivateKeyB, CompressedPKB, 0, &ws);
+}
+
+
+int EphemeralKeyGeneration_B_ex(const unsigned char* PrivateKeyB, unsigned char* CompressedPKB, void* workspace)
+{ // Bob's ephemeral public key generation using compression, with the temporaries in workspace -- SIDH protocol
 
-    return EphemeralKeyGeneration_B_extended(PrivateKeyB, CompressedPKB, 0);
+    return EphemeralKeyGeneration_B_extended(PrivateKeyB, CompressedPKB, 0, &workspace_align(workspace)->keygen_B);
 }
 
 
-static int EphemeralSecretAgreement_A_extended(const unsigned char* PrivateKeyA, const unsigned char* PKB, unsigned char* SharedSecretA, unsigned int sike)
-{ // Alice's ephemeral shared secret computation using compression -- SIKE protocol
+static void SecretAgreement_A_proj(const unsigned char* PrivateKeyA, const unsigned char* PKB, f2elm_t jnum, f2elm_t jden, unsigned char* tphiBKA_t, agreement_workspace* ws)
+{ // Alice's ephemeral shared secret computation using compression, without the final inversion
+  // Outputs: the j-invariant of the shared curve as a fraction jnum/jden. 
+  //          the data tphiBKA_t of the ciphertext validation (SIKE protocol), or nothing if tphiBKA_t is NULL (SIDH protocol).
     unsigned int i, ii = 0, row, m, index = 0, pts_index[MAX_INT_POINTS_ALICE], npts = 0;
     f2elm_t A24plus = {0}, C24 = {0};
-    point_proj_t R, pts[MAX_INT_POINTS_ALICE];
-    f2elm_t jinv, coeff[5], A;
+    point_proj_t R, *pts = ws->pts;
+    f2elm_t coeff[5], A;
     f2elm_t param_A = {0};
 
-    if (sike == 1)
-        PKBDecompression_extended(PrivateKeyA, PKB, R, param_A, SharedSecretA+FP2_ENCODED_BYTES);
+    if (tphiBKA_t != NULL)
+        PKBDecompression_extended(PrivateKeyA, PKB, R, param_A, tphiBKA_t);
     else
         PKBDecompression(PrivateKeyA, PKB, R, param_A);
     
@@ -687,6 +753,7 @@ static int EphemeralSecretAgreement_A_extended(const unsigned char* PrivateKeyA,
     fpadd((digit_t*)&Montgomery_one, (digit_t*)&Montgomery_one, C24[0]);
     fp2add(A, C24, A24plus);
     fpadd(C24[0], C24[0], C24[0]);    
+    PROFILE_PHASE_BEGIN(SIDH_PHASE_TRAVERSAL);
 
 #if (OALICE_BITS % 2 == 1)
     point_proj_t S;
@@ -720,10 +787,21 @@ static int EphemeralSecretAgreement_A_extended(const unsigned char* PrivateKeyA,
     }
 
     get_4_isog(R, A24plus, C24, coeff);
+    PROFILE_PHASE_END();
     fp2add(A24plus, A24plus, A24plus);
     fp2sub(A24plus, C24, A24plus);
     fp2add(A24plus, A24plus, A24plus);
-    j_inv(A24plus, C24, jinv);    
+    j_inv_proj(A24plus, C24, jnum, jden);
+}
+
+
+static int EphemeralSecretAgreement_A_extended(const unsigned char* PrivateKeyA, const unsigned char* PKB, unsigned char* SharedSecretA, unsigned int sike, agreement_workspace* ws)
+{ // Alice's ephemeral shared secret computation using compression -- SIKE protocol (sike = 1) or SIDH protocol (sike = 0)
+    f2elm_t jinv, jnum;
+
+    SecretAgreement_A_proj(PrivateKeyA, PKB, jnum, jinv, (sike == 1) ? SharedSecretA+FP2_ENCODED_BYTES : NULL, ws);
+    fp2inv_mont(jinv);
+    fp2mul_mont(jinv, jnum, jinv);
     fp2_encode(jinv, SharedSecretA);    // Format shared secret
     
     return 0;
@@ -736,14 +814,22 @@ int EphemeralSecretAgreement_A(const unsigned char* PrivateKeyA, const unsigned
   // Inputs: Alice's PrivateKeyA is an even integer in the range [2, oA-2], where oA = 2^OALICE_BITS. 
   //         Bob's decompressed data consists of point_R in (X:Z) coordinates and the curve parameter param_A in GF(p^2).
   // Output: a shared secret SharedSecretA that consists of one element in GF(p^2).
+    agreement_workspace ws;
+
+    return EphemeralSecretAgreement_A_extended(PrivateKeyA, PKB, SharedSecretA, 0, &ws);
+}
+
+
+int EphemeralSecretAgreement_A_ex(const unsigned char* PrivateKeyA, const unsigned char* PKB, unsigned char* SharedSecretA, void* workspace)
+{ // Alice's ephemeral shared secret computation using compression, with the temporaries in workspace -- SIDH protocol
 
-    return EphemeralSecretAgreement_A_extended(PrivateKeyA, PKB, SharedSecretA, 0);
+    return EphemeralSecretAgreement_A_extended(PrivateKeyA, PKB, SharedSecretA, 0, &workspace_align(workspace)->agreement);
 }
 
 
-int8_t validate_ciphertext(const unsigned char* ephemeralsk_, const unsigned char* CompressedPKB, const unsigned char* xKA, const unsigned char* tphiBKA_t)
+int8_t validate_ciphertext(const unsigned char* ephemeralsk_, const unsigned char* CompressedPKB, const unsigned char* xKA, const unsigned char* tphiBKA_t, agreement_workspace* ws)
 { // If ct validation passes returns 0, otherwise returns -1.
-    point_proj_t phis[3] = {0}, R, S, pts[MAX_INT_POINTS_BOB];
+    point_proj_t phis[3] = {0}, R, S, *pts = ws->pts;
     f2elm_t XPB, XQB, XRB, coeff[3], A24plus = {0}, A24minus = {0}, A = {0}, comp1 = {0}, comp2 = {0}, one = {0};
     digit_t temp[NWORDS_ORDER] = {0}, sk[NWORDS_ORDER] = {0};
     unsigned int i, row, m, index = 0, pts_index[MAX_INT_POINTS_BOB], npts = 0, ii = 0;
@@ -766,6 +852,7 @@ int8_t validate_ciphertext(const unsigned char* ephemeralsk_, const unsigned cha
     // Retrieve kernel point
     decode_to_digits(ephemeralsk_, sk, SECRETKEY_B_BYTES, NWORDS_ORDER);
     LADDER3PT(XPB, XQB, XRB, sk, BOB, R, A);
+    PROFILE_PHASE_BEGIN(SIDH_PHASE_TRAVERSAL);
     
     // Traverse tree
     index = 0;
@@ -791,6 +878,7 @@ int8_t validate_ciphertext(const unsigned char* ephemeralsk_, const unsigned cha
     }    
     get_3_isog(R, A24minus, A24plus, coeff);         
     eval_3_isog(phis[0], coeff);  // phis[0] <- phiB(PA + skA*QA)
+    PROFILE_PHASE_END();
 
     fp2_decode(&CompressedPKB[4*ORDER_A_ENCODED_BYTES], A);
     
@@ -805,3 +893,122 @@ int8_t validate_ciphertext(const unsigned char* ephemeralsk_, const unsigned cha
     fp2mul_mont(R->Z, S->X, comp2);             
     return (cmp_f2elm(comp1, comp2));
 }
+
+
+static void eval_3_isog_batch(point_proj_t* Q, const f2elm_t (*coeff)[3], const unsigned int n)
+{ // Evaluation Q[k] <- phi_k(Q[k]) of the 3-isogenies with coefficients coeff[k], for k < n <= VALIDATE_BATCH_SIZE, as in eval_3_isog
+  // With AVX-512 IFMA the two products of each step of the n evaluations run in the eight lanes of fp2mul_mont_lanes
+#if defined(_AVX512_IFMA_)
+    f2elm_t a[8] = {0}, b[8] = {0}, c[8];
+    unsigned int k;
+
+    for (k = 0; k < n; k++) {
+        fp2copy(coeff[k][0], a[2*k]);
+        fp2copy(coeff[k][1], a[2*k+1]);
+        fp2add(Q[k]->X, Q[k]->Z, b[2*k]);             // X+Z
+        fp2sub(Q[k]->X, Q[k]->Z, b[2*k+1]);           // X-Z
+    }
+    fp2mul_mont_lanes(a, b, c, 0);                    // coeff0*(X+Z), coeff1*(X-Z)
+    for (k = 0; k < n; k++) {
+        fp2add(c[2*k], c[2*k+1], a[2*k]);
+        fp2sub(c[2*k+1], c[2*k], a[2*k+1]);
+    }
+    fp2mul_mont_lanes(a, b, c, 8);                    // [coeff0*(X+Z) + coeff1*(X-Z)]^2, [coeff1*(X-Z) - coeff0*(X+Z)]^2
+    for (k = 0; k < n; k++) {
+        fp2copy(Q[k]->X, a[2*k]);
+        fp2copy(Q[k]->Z, a[2*k+1]);
+        fp2copy(c[2*k], b[2*k]);
+        fp2copy(c[2*k+1], b[2*k+1]);
+    }
+    fp2mul_mont_lanes(a, b, c, 0);
+    for (k = 0; k < n; k++) {
+        fp2copy(c[2*k], Q[k]->X);
+        fp2copy(c[2*k+1], Q[k]->Z);
+    }
+#else
+    for (unsigned int k = 0; k < n; k++) {
+        eval_3_isog(Q[k], coeff[k]);
+    }
+#endif
+}
+
+
+static void validate_ciphertext_batch(const unsigned char* const* ephemeralsk_, const unsigned char* const* CompressedPKB, const unsigned char* const* xKA, const unsigned char* const* tphiBKA_t, int8_t* selector, const unsigned int n, validate_batch_workspace* ws)
+{ // validate_ciphertext for n <= VALIDATE_BATCH_SIZE ciphertexts: selector[k] = 0 if the k-th ciphertext passes, -1 otherwise.
+  // The kernel points are computed with LADDER3PT_A24_batch, which doubles the common generator once for all the ladders. The n
+  // walks run on different curves but follow strat_Bob in lockstep, so that their isogeny evaluations and the products of the
+  // final comparisons are interleaved.
+    point_proj_t R[VALIDATE_BATCH_SIZE], phis[VALIDATE_BATCH_SIZE];
+    f2elm_t XPB, XQB, XRB, A24 = {0}, A, one = {0};
+    f2elm_t A24plus[VALIDATE_BATCH_SIZE], A24minus[VALIDATE_BATCH_SIZE], coeff[VALIDATE_BATCH_SIZE][3];
+    f2elm_t a[8] = {0}, b[8] = {0}, c[8];
+    digit_t sk[VALIDATE_BATCH_SIZE*NWORDS_ORDER] = {0}, temp[NWORDS_ORDER] = {0};
+    unsigned int i, k, row, m, index = 0, pts_index[MAX_INT_POINTS_BOB], npts = 0, ii = 0;
+
+    fpcopy((digit_t*)&Montgomery_one, one[0]);
+
+    // Initialize basis points and constants on E0: A24 = (A+2)/4 = 2, A24minus = A-2C = 4, A24plus = A+2C = 8, where A=6, C=1
+    init_basis((digit_t*)B_gen, XPB, XQB, XRB);
+    fp2add(one, one, A24);
+    for (k = 0; k < n; k++) {
+        fp2add(A24, A24, A24minus[k]);
+        fp2add(A24minus[k], A24minus[k], A24plus[k]);
+        fp2_decode(xKA[k], phis[k]->X);
+        fp2copy(one, phis[k]->Z);                      // phis[k] <- PA + skA*QA
+        decode_to_digits(ephemeralsk_[k], sk + k*NWORDS_ORDER, SECRETKEY_B_BYTES, NWORDS_ORDER);
+    }
+
+    // Retrieve kernel points
+    LADDER3PT_A24_batch(XPB, XQB, XRB, sk, BOB, R, A24, n);
+    PROFILE_PHASE_BEGIN(SIDH_PHASE_TRAVERSAL);
+
+    // Traverse trees
+    for (row = 1; row < MAX_Bob; row++) {
+        while (index < MAX_Bob-row) {
+            for (k = 0; k < n; k++) {
+                fp2copy(R[k]->X, ws->pts[npts][k]->X);
+                fp2copy(R[k]->Z, ws->pts[npts][k]->Z);
+            }
+            pts_index[npts++] = index;
+            m = strat_Bob[ii++];
+            for (k = 0; k < n; k++) {
+                xTPLe(R[k], R[k], A24minus[k], A24plus[k], (int)m);
+            }
+            index += m;
+        }
+        for (k = 0; k < n; k++) {
+            get_3_isog(R[k], A24minus[k], A24plus[k], coeff[k]);
+        }
+        for (i = 0; i < npts; i++) {
+            eval_3_isog_batch(ws->pts[i], (const f2elm_t (*)[3])coeff, n);
+        }
+        eval_3_isog_batch(phis, (const f2elm_t (*)[3])coeff, n);
+
+        for (k = 0; k < n; k++) {
+            fp2copy(ws->pts[npts-1][k]->X, R[k]->X);
+            fp2copy(ws->pts[npts-1][k]->Z, R[k]->Z);
+        }
+        index = pts_index[npts-1];
+        npts -= 1;
+    }
+    for (k = 0; k < n; k++) {
+        get_3_isog(R[k], A24minus[k], A24plus[k], coeff[k]);
+    }
+    eval_3_isog_batch(phis, (const f2elm_t (*)[3])coeff, n);    // phis[k] <- phiB(PA + skA*QA)
+    PROFILE_PHASE_END();
+
+    // Single equation checks as in validate_ciphertext, with the 2n products of the comparisons in lockstep
+    for (k = 0; k < n; k++) {
+        fp2_decode(&CompressedPKB[k][4*ORDER_A_ENCODED_BYTES], A);
+        decode_to_digits(&tphiBKA_t[k][2*FP2_ENCODED_BYTES], temp, ORDER_A_ENCODED_BYTES, NWORDS_ORDER);
+        Ladder(phis[k], temp, A, OALICE_BITS, R[k]);
+        fp2copy(R[k]->X, a[2*k]);
+        fp2_decode(&tphiBKA_t[k][FP2_ENCODED_BYTES], b[2*k]);
+        fp2copy(R[k]->Z, a[2*k+1]);
+        fp2_decode(tphiBKA_t[k], b[2*k+1]);
+    }
+    fp2mul_mont_lanes(a, b, c, 0);
+    for (k = 0; k < n; k++) {
+        selector[k] = cmp_f2elm(c[2*k], c[2*k+1]);
+    }
+}
@@ -10,9 +10,15 @@
 
 #include <string.h>
 #include "../sha3/fips202.h"
+#include "../sike_scheme.h"
 
 
-int crypto_kem_keypair(unsigned char *pk, unsigned char *sk)
+#define KEM_DEC_BATCH_SIZE    8    // Maximum number of decapsulations whose shared secret inversions are merged
+
+_Static_assert(sizeof(sidh_workspace) + sizeof(digit_t) - 1 <= CRYPTO_WORKSPACE_BYTES, "CRYPTO_WORKSPACE_BYTES is too small");
+
+
+static int crypto_kem_keypair_extended(unsigned char *pk, unsigned char *sk, keygen_A_workspace* ws)
 { // SIKE's key generation using compression
   // Outputs: secret key sk (CRYPTO_SECRETKEYBYTES = MSG_BYTES + SECRETKEY_A_BYTES + CRYPTO_PUBLICKEYBYTES + FP2_ENCODED_BYTES bytes)
   //          public key pk_comp (CRYPTO_PUBLICKEYBYTES bytes) 
@@ -22,7 +28,7 @@ int crypto_kem_keypair(unsigned char *pk, unsigned char *sk)
     random_mod_order_A(sk + MSG_BYTES);    // Even random number
 
     // Generate public key pk
-    EphemeralKeyGeneration_A_extended(sk + MSG_BYTES, pk);
+    EphemeralKeyGeneration_A_extended(sk + MSG_BYTES, pk, 1, ws);
 
     // Append public key pk to secret key sk
     memcpy(&sk[MSG_BYTES + SECRETKEY_A_BYTES], pk, CRYPTO_PUBLICKEYBYTES);
@@ -31,7 +37,7 @@ int crypto_kem_keypair(unsigned char *pk, unsigned char *sk)
 }
 
 
-int crypto_kem_enc(unsigned char *ct, unsigned char *ss, const unsigned char *pk)
+static int crypto_kem_enc_extended(unsigned char *ct, unsigned char *ss, const unsigned char *pk, keygen_B_workspace* ws_keygen, agreement_workspace* ws_agreement)
 { // SIKE's encapsulation using compression
   // Input:   public key pk              (CRYPTO_PUBLICKEYBYTES bytes)
   // Outputs: shared secret ss           (CRYPTO_BYTES bytes)
@@ -48,8 +54,8 @@ int crypto_kem_enc(unsigned char *ct, unsigned char *ss, const unsigned char *pk
     FormatPrivKey_B(ephemeralsk);
     
     // Encrypt
-    EphemeralKeyGeneration_B_extended(ephemeralsk, ct, 1); 
-    EphemeralSecretAgreement_B(ephemeralsk, pk, jinvariant);  
+    EphemeralKeyGeneration_B_extended(ephemeralsk, ct, 1, ws_keygen); 
+    EphemeralSecretAgreement_B_extended(ephemeralsk, pk, jinvariant, ws_agreement);  
     shake256(h, MSG_BYTES, jinvariant, FP2_ENCODED_BYTES);          
     for (int i = 0; i < MSG_BYTES; i++) {
         ct[i + PARTIALLY_COMPRESSED_CHUNK_CT] = temp[i] ^ h[i];
@@ -63,7 +69,7 @@ int crypto_kem_enc(unsigned char *ct, unsigned char *ss, const unsigned char *pk
 }
 
 
-int crypto_kem_dec(unsigned char *ss, const unsigned char *ct, const unsigned char *sk)
+static int crypto_kem_dec_extended(unsigned char *ss, const unsigned char *ct, const unsigned char *sk, agreement_workspace* ws)
 { // SIKE's decapsulation using compression 
   // Input:   secret key sk                         (CRYPTO_SECRETKEYBYTES = MSG_BYTES + SECRETKEY_A_BYTES + CRYPTO_PUBLICKEYBYTES + FP2_ENCODED_BYTES bytes)
   //          compressed ciphertext message ct      (CRYPTO_CIPHERTEXTBYTES = PARTIALLY_COMPRESSED_CHUNK_CT + MSG_BYTES bytes) 
@@ -74,7 +80,7 @@ int crypto_kem_dec(unsigned char *ss, const unsigned char *ct, const unsigned ch
     unsigned char* tphiBKA_t = &jinvariant_[FP2_ENCODED_BYTES];
     
     // Decrypt 
-    EphemeralSecretAgreement_A_extended(sk + MSG_BYTES, ct, jinvariant_, 1);  
+    EphemeralSecretAgreement_A_extended(sk + MSG_BYTES, ct, jinvariant_, 1, ws);  
     shake256(h_, MSG_BYTES, jinvariant_, FP2_ENCODED_BYTES);   
     
     for (int i = 0; i < MSG_BYTES; i++) {
@@ -88,7 +94,7 @@ int crypto_kem_dec(unsigned char *ss, const unsigned char *ct, const unsigned ch
     
     // Generate shared secret ss <- H(m||ct), or output ss <- H(s||ct) in case of ct verification failure
     // No need to recompress, just check if x(phi(P) + t*phi(Q)) == x((a0 + t*a1)*R1 + (b0 + t*b1)*R2)    
-    int8_t selector = validate_ciphertext(ephemeralsk_, ct, &sk[MSG_BYTES + SECRETKEY_A_BYTES + CRYPTO_PUBLICKEYBYTES], tphiBKA_t);
+    int8_t selector = validate_ciphertext(ephemeralsk_, ct, &sk[MSG_BYTES + SECRETKEY_A_BYTES + CRYPTO_PUBLICKEYBYTES], tphiBKA_t, ws);
     // If ct validation passes (selector = 0) then do ss = H(m||ct), otherwise (selector = -1) load s to do ss = H(s||ct)
     ct_cmov(temp, sk, MSG_BYTES, selector);
     memcpy(&temp[MSG_BYTES], ct, CRYPTO_CIPHERTEXTBYTES);  
@@ -97,3 +103,149 @@ int crypto_kem_dec(unsigned char *ss, const unsigned char *ct, const unsigned ch
     return 0;
 }
 
+
+static void crypto_kem_dec_recover_batch(const unsigned char* const* ct, const unsigned char* const* sk, unsigned char* const* ephemeralsk_, unsigned char* const* tphiBKA_t, unsigned char* const* temp, const unsigned int n, agreement_workspace* ws)
+{ // First stage of the decapsulation of n <= KEM_DEC_BATCH_SIZE ciphertexts ct[k] with secret keys sk[k], as in crypto_kem_dec:
+  // temp[k] <- m||pk with m = ct ^ H(j), ephemeralsk_[k] <- G(m||pk) mod oB, and the data tphiBKA_t[k] of the validation.
+  // The final inversions of the n j-invariants are merged into one.
+    f2elm_t jnum[KEM_DEC_BATCH_SIZE], jden[KEM_DEC_BATCH_SIZE], jinv[KEM_DEC_BATCH_SIZE];
+    unsigned char jinvariant_[FP2_ENCODED_BYTES], h_[MSG_BYTES];
+    unsigned int i, k;
+
+    for (k = 0; k < n; k++) {
+        SecretAgreement_A_proj(sk[k] + MSG_BYTES, ct[k], jnum[k], jden[k], tphiBKA_t[k], ws);
+    }
+    mont_n_way_inv_ct((const f2elm_t*)jden, (int)n, jinv);
+
+    for (k = 0; k < n; k++) {
+        fp2mul_mont(jnum[k], jinv[k], jinv[k]);
+        fp2_encode(jinv[k], jinvariant_);
+        shake256(h_, MSG_BYTES, jinvariant_, FP2_ENCODED_BYTES);
+        for (i = 0; i < MSG_BYTES; i++) {
+            temp[k][i] = ct[k][i + PARTIALLY_COMPRESSED_CHUNK_CT] ^ h_[i];
+        }
+        memcpy(&temp[k][MSG_BYTES], &sk[k][MSG_BYTES + SECRETKEY_A_BYTES], CRYPTO_PUBLICKEYBYTES);
+        shake256(ephemeralsk_[k], SECRETKEY_B_BYTES, temp[k], MSG_BYTES + CRYPTO_PUBLICKEYBYTES);
+        FormatPrivKey_B(ephemeralsk_[k]);
+    }
+    memset(jinv, 0, sizeof(jinv));
+    memset(jinvariant_, 0, sizeof(jinvariant_));
+}
+
+
+static void crypto_kem_dec_validate_batch(unsigned char* const* ss, const unsigned char* const* ct, const unsigned char* const* sk, const unsigned char* const* ephemeralsk_, const unsigned char* const* tphiBKA_t, unsigned char* const* temp, const unsigned int n, validate_batch_workspace* ws)
+{ // Second stage of the decapsulation of n <= VALIDATE_BATCH_SIZE ciphertexts, after crypto_kem_dec_recover_batch: 
+  // ss[k] <- H(m||ct) if the k-th ciphertext passes the validation, or H(s||ct) otherwise
+    const unsigned char* xKA[VALIDATE_BATCH_SIZE] = {0};
+    int8_t selector[VALIDATE_BATCH_SIZE];
+    unsigned int k;
+
+    for (k = 0; k < n; k++) {
+        xKA[k] = &sk[k][MSG_BYTES + SECRETKEY_A_BYTES + CRYPTO_PUBLICKEYBYTES];
+    }
+    validate_ciphertext_batch(ephemeralsk_, ct, xKA, tphiBKA_t, selector, n, ws);
+    for (k = 0; k < n; k++) {
+        ct_cmov(temp[k], sk[k], MSG_BYTES, selector[k]);
+        memcpy(&temp[k][MSG_BYTES], ct[k], CRYPTO_CIPHERTEXTBYTES);
+        shake256(ss[k], CRYPTO_BYTES, temp[k], CRYPTO_CIPHERTEXTBYTES + MSG_BYTES);
+    }
+}
+
+
+int crypto_kem_keypair(unsigned char *pk, unsigned char *sk)
+{ // SIKE's key generation using compression
+    keygen_A_workspace ws;
+
+    return crypto_kem_keypair_extended(pk, sk, &ws);
+}
+
+
+int crypto_kem_enc(unsigned char *ct, unsigned char *ss, const unsigned char *pk)
+{ // SIKE's encapsulation using compression
+    keygen_B_workspace ws_keygen;
+    agreement_workspace ws_agreement;
+
+    return crypto_kem_enc_extended(ct, ss, pk, &ws_keygen, &ws_agreement);
+}
+
+
+int crypto_kem_dec(unsigned char *ss, const unsigned char *ct, const unsigned char *sk)
+{ // SIKE's decapsulation using compression
+    agreement_workspace ws;
+
+    return crypto_kem_dec_extended(ss, ct, sk, &ws);
+}
+
+
+int crypto_kem_dec_batch(unsigned char *ss, const unsigned char *ct, const unsigned char *sk, unsigned int n)
+{ // SIKE's decapsulation using compression for a batch of n ciphertexts under the same secret key
+  // Input:   secret key sk         (CRYPTO_SECRETKEYBYTES bytes)
+  //          ciphertexts ct        (n*CRYPTO_CIPHERTEXTBYTES bytes, the i-th ciphertext at ct + i*CRYPTO_CIPHERTEXTBYTES)
+  // Outputs: shared secrets ss     (n*CRYPTO_BYTES bytes, the i-th secret at ss + i*CRYPTO_BYTES)
+  // The shared secret recoveries of up to KEM_DEC_BATCH_SIZE ciphertexts merge their final inversions, and the validations
+  // of up to VALIDATE_BATCH_SIZE ciphertexts run in lockstep with validate_ciphertext_batch.
+    unsigned char ephemeralsk_[KEM_DEC_BATCH_SIZE][SECRETKEY_B_BYTES];
+    unsigned char tphiBKA_t[KEM_DEC_BATCH_SIZE][2*FP2_ENCODED_BYTES + SECRETKEY_A_BYTES];
+    unsigned char temp[KEM_DEC_BATCH_SIZE][CRYPTO_CIPHERTEXTBYTES + MSG_BYTES];
+    const unsigned char *ct_k[KEM_DEC_BATCH_SIZE], *sk_k[KEM_DEC_BATCH_SIZE];
+    unsigned char *ss_k[KEM_DEC_BATCH_SIZE], *ephemeralsk_k[KEM_DEC_BATCH_SIZE], *tphiBKA_t_k[KEM_DEC_BATCH_SIZE], *temp_k[KEM_DEC_BATCH_SIZE];
+    unsigned int i, k, batch, part;
+    agreement_workspace ws_agreement;
+    validate_batch_workspace ws_validate;
+
+    for (k = 0; k < KEM_DEC_BATCH_SIZE; k++) {
+        sk_k[k] = sk;
+        ephemeralsk_k[k] = ephemeralsk_[k];
+        tphiBKA_t_k[k] = tphiBKA_t[k];
+        temp_k[k] = temp[k];
+    }
+
+    for (i = 0; i < n; i += batch) {
+        batch = (n - i < KEM_DEC_BATCH_SIZE) ? (n - i) : KEM_DEC_BATCH_SIZE;
+        for (k = 0; k < batch; k++) {
+            ct_k[k] = ct + (i + k)*CRYPTO_CIPHERTEXTBYTES;
+            ss_k[k] = ss + (i + k)*CRYPTO_BYTES;
+        }
+        crypto_kem_dec_recover_batch(ct_k, sk_k, ephemeralsk_k, tphiBKA_t_k, temp_k, batch, &ws_agreement);
+        for (k = 0; k < batch; k += part) {
+            part = (batch - k < VALIDATE_BATCH_SIZE) ? (batch - k) : VALIDATE_BATCH_SIZE;
+            crypto_kem_dec_validate_batch(ss_k + k, ct_k + k, sk_k + k, (const unsigned char* const*)ephemeralsk_k + k, 
+                                          (const unsigned char* const*)tphiBKA_t_k + k, temp_k + k, part, &ws_validate);
+        }
+    }
+    memset(ephemeralsk_, 0, sizeof(ephemeralsk_));
+    memset(temp, 0, sizeof(temp));
+
+    return 0;
+}
+
+
+int crypto_kem_keypair_ex(unsigned char *pk, unsigned char *sk, void *workspace)
+{ // SIKE's key generation using compression, with the temporaries in workspace
+
+    return crypto_kem_keypair_extended(pk, sk, &workspace_align(workspace)->keygen_A);
+}
+
+
+int crypto_kem_enc_ex(unsigned char *ct, unsigned char *ss, const unsigned char *pk, void *workspace)
+{ // SIKE's encapsulation using compression, with the temporaries in workspace
+  // The key generation and the shared secret run one after the other and share the workspace
+    sidh_workspace* ws = workspace_align(workspace);
+
+    return crypto_kem_enc_extended(ct, ss, pk, &ws->keygen_B, &ws->agreement);
+}
+
+
+int crypto_kem_dec_ex(unsigned char *ss, const unsigned char *ct, const unsigned char *sk, void *workspace)
+{ // SIKE's decapsulation using compression, with the temporaries in workspace
+
+    return crypto_kem_dec_extended(ss, ct, sk, &workspace_align(workspace)->agreement);
+}
+
+
+
+// Sizes and functions of this parameter set, for runtime selection with sike_get_scheme()
+const sike_scheme crypto_kem_scheme = {
+    CRYPTO_ALGNAME, CRYPTO_PUBLICKEYBYTES, CRYPTO_SECRETKEYBYTES, CRYPTO_CIPHERTEXTBYTES, CRYPTO_BYTES,
+    crypto_kem_keypair, crypto_kem_enc, crypto_kem_dec, NULL, NULL
+};
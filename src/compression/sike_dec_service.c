@@ -0,0 +1,370 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: asynchronous decapsulation service of SIKE using compression
+*
+* Requests wait in two queues, one per stage of crypto_kem_dec: the shared secret recovery, and the
+* ciphertext validation by re-encryption. An idle worker takes a batch of the oldest requests of
+* the second queue if any, so that requests in flight complete first, and otherwise of the first
+* queue. The j-invariants of a first-stage batch are inverted together with Montgomery's trick, and
+* the validations of a second-stage batch run in lockstep. A batch holds a share of the pending
+* requests among the idle workers, so that batches only grow under load.
+*********************************************************************************************/
+
+#if defined(__NIX__)
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../sike_dec_service.h"
+
+
+typedef struct {
+    unsigned char ss[CRYPTO_BYTES];
+    unsigned char ct[CRYPTO_CIPHERTEXTBYTES];
+    unsigned char sk[CRYPTO_SECRETKEYBYTES];
+    unsigned char ephemeralsk_[SECRETKEY_B_BYTES];
+    unsigned char tphiBKA_t[2*FP2_ENCODED_BYTES + SECRETKEY_A_BYTES];
+    unsigned char temp[CRYPTO_CIPHERTEXTBYTES + MSG_BYTES];
+    unsigned char* ss_out;
+    sike_dec_callback_t callback;
+    void* ctx;
+    unsigned long long submitted;          // Submission time in nanoseconds
+} dec_request;
+
+typedef struct {                           // FIFO of request indices
+    unsigned int* items;
+    unsigned int head, count;
+} dec_queue;
+
+typedef struct {
+    pthread_t thread;
+    sike_dec_service* service;
+    union {                                // The stages of a worker run one after the other
+        agreement_workspace agreement;
+        validate_batch_workspace validate;
+    } ws;
+} dec_worker;
+
+struct sike_dec_service {
+    pthread_mutex_t lock;
+    pthread_cond_t work;                   // Signaled when a queue gets requests or the service stops
+    pthread_cond_t done;                   // Signaled when a request completes
+    dec_worker* workers;
+    unsigned int started, idle, capacity, stopping;
+    dec_request* requests;
+    dec_queue free, stage1, stage2, completed;
+    sike_dec_stats stats;
+};
+
+
+static void queue_push(dec_queue* q, unsigned int capacity, unsigned int index)
+{
+    q->items[(q->head + q->count) % capacity] = index;
+    q->count++;
+}
+
+
+static unsigned int queue_pop(dec_queue* q, unsigned int capacity)
+{
+    unsigned int index = q->items[q->head];
+
+    q->head = (q->head + 1) % capacity;
+    q->count--;
+    return index;
+}
+
+
+static unsigned long long dec_service_time(void)
+{ // Monotonic time in nanoseconds
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec*1000000000ULL + (unsigned long long)ts.tv_nsec;
+}
+
+
+static unsigned int histogram_bucket(unsigned long long value)
+{ // Returns floor(log2(value)), or 0 if value = 0, capped to the last bucket
+    unsigned int bucket = 0;
+
+    while (value > 1 && bucket < SIKE_DEC_HISTOGRAM_BUCKETS-1) {
+        value >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+
+static void dec_stage1(sike_dec_service* s, const unsigned int* index, const unsigned int n, agreement_workspace* ws)
+{ // Shared secret recovery of the requests index[0..n-1], with one inversion for the batch
+    const unsigned char *ct[KEM_DEC_BATCH_SIZE], *sk[KEM_DEC_BATCH_SIZE];
+    unsigned char *ephemeralsk_[KEM_DEC_BATCH_SIZE], *tphiBKA_t[KEM_DEC_BATCH_SIZE], *temp[KEM_DEC_BATCH_SIZE];
+    unsigned int k;
+
+    for (k = 0; k < n; k++) {
+        dec_request* r = &s->requests[index[k]];
+
+        ct[k] = r->ct;
+        sk[k] = r->sk;
+        ephemeralsk_[k] = r->ephemeralsk_;
+        tphiBKA_t[k] = r->tphiBKA_t;
+        temp[k] = r->temp;
+    }
+    crypto_kem_dec_recover_batch(ct, sk, ephemeralsk_, tphiBKA_t, temp, n, ws);
+}
+
+
+static void dec_stage2(sike_dec_service* s, const unsigned int* index, const unsigned int n, validate_batch_workspace* ws)
+{ // Ciphertext validation of the requests index[0..n-1] in lockstep, then ss <- H(m||ct), or ss <- H(s||ct) in case of failure
+    const unsigned char *ct[VALIDATE_BATCH_SIZE], *sk[VALIDATE_BATCH_SIZE], *ephemeralsk_[VALIDATE_BATCH_SIZE], *tphiBKA_t[VALIDATE_BATCH_SIZE];
+    unsigned char *ss[VALIDATE_BATCH_SIZE], *temp[VALIDATE_BATCH_SIZE];
+    unsigned int k;
+
+    for (k = 0; k < n; k++) {
+        dec_request* r = &s->requests[index[k]];
+
+        ss[k] = r->ss;
+        ct[k] = r->ct;
+        sk[k] = r->sk;
+        ephemeralsk_[k] = r->ephemeralsk_;
+        tphiBKA_t[k] = r->tphiBKA_t;
+        temp[k] = r->temp;
+    }
+    crypto_kem_dec_validate_batch(ss, ct, sk, ephemeralsk_, tphiBKA_t, temp, n, ws);
+    for (k = 0; k < n; k++) {
+        memcpy(s->requests[index[k]].ss_out, ss[k], CRYPTO_BYTES);
+    }
+}
+
+
+static void dec_request_clear(dec_request* r)
+{ // Wipes the secrets of a request before its slot is reused
+    memset(r->ss, 0, sizeof(r->ss));
+    memset(r->sk, 0, sizeof(r->sk));
+    memset(r->ephemeralsk_, 0, sizeof(r->ephemeralsk_));
+    memset(r->tphiBKA_t, 0, sizeof(r->tphiBKA_t));
+    memset(r->temp, 0, sizeof(r->temp));
+}
+
+
+static void dec_service_complete(sike_dec_service* s, unsigned int index)
+{ // Completion of a request, called with the lock held
+    dec_request* r = &s->requests[index];
+
+    s->stats.completed++;
+    s->stats.latency[histogram_bucket((dec_service_time() - r->submitted) / 1000)]++;
+    s->stats.in_flight--;
+
+    if (r->callback != NULL) {
+        pthread_mutex_unlock(&s->lock);
+        r->callback(r->ctx, r->ss_out);
+        pthread_mutex_lock(&s->lock);
+        dec_request_clear(r);
+        queue_push(&s->free, s->capacity, index);
+    } else {
+        dec_request_clear(r);
+        queue_push(&s->completed, s->capacity, index);
+    }
+    pthread_cond_broadcast(&s->done);
+}
+
+
+static unsigned int dec_service_take(sike_dec_service* s, dec_queue* q, unsigned int* index, const unsigned int max)
+{ // Takes a share of the requests of q among the idle workers, rounded up and at most max. Called with the lock held
+    unsigned int k, n = (q->count + s->idle) / (s->idle + 1);
+
+    if (n > max) n = max;
+    for (k = 0; k < n; k++) {
+        index[k] = queue_pop(q, s->capacity);
+    }
+    if (q->count > 0) {
+        pthread_cond_signal(&s->work);
+    }
+    return n;
+}
+
+
+static void* dec_service_worker(void* arg)
+{ // Worker loop, runs until the service stops and both queues are empty
+    dec_worker* w = (dec_worker*)arg;
+    sike_dec_service* s = w->service;
+    unsigned int index[KEM_DEC_BATCH_SIZE];
+    unsigned int k, n;
+
+    pthread_mutex_lock(&s->lock);
+    for (;;) {
+        if (s->stage2.count > 0) {
+            n = dec_service_take(s, &s->stage2, index, VALIDATE_BATCH_SIZE);
+            pthread_mutex_unlock(&s->lock);
+            dec_stage2(s, index, n, &w->ws.validate);
+            pthread_mutex_lock(&s->lock);
+            for (k = 0; k < n; k++) {
+                dec_service_complete(s, index[k]);
+            }
+        } else if (s->stage1.count > 0) {
+            n = dec_service_take(s, &s->stage1, index, KEM_DEC_BATCH_SIZE);
+            s->stats.batches++;
+            pthread_mutex_unlock(&s->lock);
+            dec_stage1(s, index, n, &w->ws.agreement);
+            pthread_mutex_lock(&s->lock);
+            for (k = 0; k < n; k++) {
+                queue_push(&s->stage2, s->capacity, index[k]);
+            }
+            if (n > 1) {
+                pthread_cond_broadcast(&s->work);
+            }
+        } else if (s->stopping) {
+            break;
+        } else {
+            s->idle++;
+            pthread_cond_wait(&s->work, &s->lock);
+            s->idle--;
+        }
+    }
+    pthread_mutex_unlock(&s->lock);
+
+    return NULL;
+}
+
+
+void crypto_kem_dec_service_destroy(sike_dec_service* service)
+{ // Stops the service once the submitted requests are completed, and releases it. Completions not yet polled are dropped
+    unsigned int i;
+
+    if (service == NULL) {
+        return;
+    }
+    pthread_mutex_lock(&service->lock);
+    service->stopping = 1;
+    pthread_cond_broadcast(&service->work);
+    pthread_mutex_unlock(&service->lock);
+    for (i = 0; i < service->started; i++) {
+        pthread_join(service->workers[i].thread, NULL);
+    }
+
+    pthread_cond_destroy(&service->done);
+    pthread_cond_destroy(&service->work);
+    pthread_mutex_destroy(&service->lock);
+    if (service->requests != NULL) {
+        memset(service->requests, 0, service->capacity*sizeof(dec_request));
+    }
+    if (service->workers != NULL) {
+        memset(service->workers, 0, service->started*sizeof(dec_worker));
+    }
+    free(service->requests);
+    free(service->free.items);
+    free(service->stage1.items);
+    free(service->stage2.items);
+    free(service->completed.items);
+    free(service->workers);
+    free(service);
+}
+
+
+sike_dec_service* crypto_kem_dec_service_create(unsigned int workers, unsigned int capacity)
+{ // Starts a service with the given number of worker threads and at most capacity requests submitted and not yet released.
+  // Returns NULL if workers or capacity is 0, or on failure to allocate memory or start the threads
+    sike_dec_service* s;
+    unsigned int i;
+
+    if (workers == 0 || capacity == 0 || (s = (sike_dec_service*)calloc(1, sizeof(sike_dec_service))) == NULL) {
+        return NULL;
+    }
+    pthread_mutex_init(&s->lock, NULL);
+    pthread_cond_init(&s->work, NULL);
+    pthread_cond_init(&s->done, NULL);
+    s->capacity = capacity;
+    s->workers = (dec_worker*)calloc(workers, sizeof(dec_worker));
+    s->requests = (dec_request*)calloc(capacity, sizeof(dec_request));
+    s->free.items = (unsigned int*)calloc(capacity, sizeof(unsigned int));
+    s->stage1.items = (unsigned int*)calloc(capacity, sizeof(unsigned int));
+    s->stage2.items = (unsigned int*)calloc(capacity, sizeof(unsigned int));
+    s->completed.items = (unsigned int*)calloc(capacity, sizeof(unsigned int));
+    if (s->workers == NULL || s->requests == NULL || s->free.items == NULL || s->stage1.items == NULL ||
+        s->stage2.items == NULL || s->completed.items == NULL) {
+        crypto_kem_dec_service_destroy(s);
+        return NULL;
+    }
+    for (i = 0; i < capacity; i++) {
+        queue_push(&s->free, capacity, i);
+    }
+
+    for (i = 0; i < workers; i++) {
+        s->workers[i].service = s;
+        if (pthread_create(&s->workers[i].thread, NULL, dec_service_worker, &s->workers[i]) != 0) {
+            crypto_kem_dec_service_destroy(s);
+            return NULL;
+        }
+        s->started++;
+    }
+    return s;
+}
+
+
+int crypto_kem_dec_service_submit(sike_dec_service* service, unsigned char *ss, const unsigned char *ct, const unsigned char *sk, sike_dec_callback_t callback, void* ctx)
+{ // Queues the decapsulation of ct with sk, which are copied. The shared secret is written to ss when the request completes,
+  // which is then reported to callback, or by crypto_kem_dec_service_poll if callback is NULL.
+  // Returns 0, or -1 if the service has no free request slot or is stopping
+    dec_request* r;
+    unsigned int index;
+
+    pthread_mutex_lock(&service->lock);
+    if (service->free.count == 0 || service->stopping) {
+        service->stats.rejected++;
+        pthread_mutex_unlock(&service->lock);
+        return -1;
+    }
+    service->stats.submitted++;
+    service->stats.queue_depth[(service->stats.in_flight == 0) ? 0 : histogram_bucket(service->stats.in_flight) + 1]++;
+    service->stats.in_flight++;
+
+    index = queue_pop(&service->free, service->capacity);
+    r = &service->requests[index];
+    memcpy(r->ct, ct, CRYPTO_CIPHERTEXTBYTES);
+    memcpy(r->sk, sk, CRYPTO_SECRETKEYBYTES);
+    r->ss_out = ss;
+    r->callback = callback;
+    r->ctx = ctx;
+    r->submitted = dec_service_time();
+    queue_push(&service->stage1, service->capacity, index);
+    pthread_cond_signal(&service->work);
+    pthread_mutex_unlock(&service->lock);
+
+    return 0;
+}
+
+
+unsigned int crypto_kem_dec_service_poll(sike_dec_service* service, void** ctx, unsigned int max, int wait)
+{ // Releases up to max completed requests submitted without callback and writes their contexts to ctx. If wait is nonzero
+  // and no such request has completed, it first waits for one, or until no request is in flight. Returns the number of requests
+    unsigned int n = 0, index;
+
+    pthread_mutex_lock(&service->lock);
+    while (wait && service->completed.count == 0 && service->stats.in_flight > 0) {
+        pthread_cond_wait(&service->done, &service->lock);
+    }
+    while (n < max && service->completed.count > 0) {
+        index = queue_pop(&service->completed, service->capacity);
+        ctx[n++] = service->requests[index].ctx;
+        queue_push(&service->free, service->capacity, index);
+    }
+    pthread_mutex_unlock(&service->lock);
+
+    return n;
+}
+
+
+void crypto_kem_dec_service_stats(sike_dec_service* service, sike_dec_stats* stats)
+{ // Snapshot of the counters and histograms of the service
+
+    pthread_mutex_lock(&service->lock);
+    *stats = service->stats;
+    pthread_mutex_unlock(&service->lock);
+}
+
+#endif
@@ -0,0 +1,338 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: loading of the pairing and discrete log tables for compression from a table file
+*
+* Table file layout (version 2, native byte order, all offsets in bytes from the start of the file):
+*   header:    magic "SIDHTBL", version, byte order mark, field size in bits, words per field element, the Pohlig-Hellman 
+*              window sizes w2 and w3, number of sections, and the SHAKE256 checksum of everything that follows the header
+*   directory: one entry (id, offset, size) per section, in the order of the TABLE_* identifiers below. The sizes of the 
+*              discrete log sections follow from w2 and w3
+*   data:      the tables, each starting at a multiple of TABLES_ALIGN
+*********************************************************************************************/
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../sha3/fips202.h"
+#if defined(__NIX__)
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+#define TABLES_VERSION       2
+#define TABLES_BOM           0x01020304
+#define TABLES_ALIGN         64
+#define TABLES_CHECKSUM      32
+
+// Largest Pohlig-Hellman window sizes accepted in a table file
+#define PH_W2_MAX            10
+#define PH_W3_MAX            6
+#define PH2_DLOG_PRODS       (1 << (PH_W2_MAX-3))    // Products of ord2w_dlog(), 2^(w1-2) for w1 = w2-1 <= PH_W2_MAX-1
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t bom;
+    uint32_t nbits_field;
+    uint32_t nwords_field;
+    uint32_t w2;
+    uint32_t w3;
+    uint32_t nsections;
+    uint32_t reserved;
+    unsigned char checksum[TABLES_CHECKSUM];
+} tables_header_t;
+
+typedef struct {
+    uint32_t id;
+    uint32_t reserved;
+    uint64_t offset;
+    uint64_t size;
+} tables_entry_t;
+
+// Pohlig-Hellman parameters derived from the window sizes w2 and w3
+typedef struct {
+    unsigned int w2;                // Window size for ell=2, dividing OALICE_BITS
+    unsigned int w2_1;              // Window size of the ord2w_dlog lookup, w2_1 = w2-1
+    unsigned int w3;                // Window size for ell=3
+    unsigned int dlen2;             // Number of digits for ell=2, ceil(OALICE_BITS/w2)
+    unsigned int dlen3;             // Number of digits for ell=3, ceil(OBOB_EXPON/w3)
+    unsigned int ellw2;             // 2^w2
+    unsigned int ellw3;             // 3^w3
+    unsigned int ell3_emodw;        // 3^(OBOB_EXPON mod w3)
+} ph_params_t;
+
+enum {
+    TABLE_TATE3, TABLE_TATE2_FIRSTSTEP_P, TABLE_TATE2_P, TABLE_TATE2_FIRSTSTEP_Q, TABLE_TATE2_Q,
+    TABLE_PH2_PATH, TABLE_PH2_TEXP, TABLE_PH2_LOG, TABLE_PH2_G, TABLE_PH2_CT,
+    TABLE_PH3_PATH, TABLE_PH3_T1, TABLE_PH3_T2,
+    TABLES_NSECTIONS
+};
+
+#if (OBOB_EXPON % W_3 == 0)
+    #define PH3_T1_BUILTIN   ph3_T     // With w3 dividing OBOB_EXPON a single table is used, held in the T1 section
+    #define PH3_T2_BUILTIN   NULL
+#else
+    #define PH3_T1_BUILTIN   ph3_T1
+    #define PH3_T2_BUILTIN   ph3_T2
+#endif
+
+
+static void ph_params_init(ph_params_t* params, unsigned int w2, unsigned int w3)
+{ // Pohlig-Hellman parameters for window sizes w2 and w3
+    params->w2 = w2;
+    params->w2_1 = w2 - 1;
+    params->w3 = w3;
+    params->dlen2 = (OALICE_BITS + w2 - 1) / w2;
+    params->dlen3 = (OBOB_EXPON + w3 - 1) / w3;
+    params->ellw2 = 1 << w2;
+    params->ellw3 = 1;
+    for (unsigned int i = 0; i < w3; i++) params->ellw3 *= 3;
+    params->ell3_emodw = 1;
+    for (unsigned int i = 0; i < OBOB_EXPON % w3; i++) params->ell3_emodw *= 3;
+}
+
+
+static int ph_windows_supported(unsigned int w2, unsigned int w3)
+{ // Window sizes usable with this library: not smaller than the built-in ones (digit buffers are sized for those), 
+  // up to PH_W2_MAX and PH_W3_MAX, and w2 dividing OALICE_BITS as required by the torus traversal
+    return (w2 >= W_2 && w2 <= PH_W2_MAX && (OALICE_BITS % w2) == 0 && w3 >= W_3 && w3 <= PH_W3_MAX);
+}
+
+
+// Discrete log parameters and tables in use by the pairings and discrete logs, either the built-in ones or those mapped 
+// by sidh_load_tables()
+static ph_params_t ph_params_active = { W_2, W_2_1, W_3, DLEN_2, DLEN_3, ELL2_W, ELL3_W, ELL3_EMODW };
+static const void* T_tate3_active = T_tate3;
+static const void* T_tate2_firststep_P_active = T_tate2_firststep_P;
+static const void* T_tate2_P_active = T_tate2_P;
+static const void* T_tate2_firststep_Q_active = T_tate2_firststep_Q;
+static const void* T_tate2_Q_active = T_tate2_Q;
+static const void* ph2_path_active = ph2_path;
+static const void* ph2_Texp_active = ph2_Texp;
+static const void* ph2_Log_active = ph2_Log;
+static const void* ph2_G_active = ph2_G;
+static const void* ph2_CT_active = ph2_CT;
+static const void* ph3_path_active = ph3_path;
+static const void* ph3_T1_active = PH3_T1_BUILTIN;
+static const void* ph3_T2_active = PH3_T2_BUILTIN;
+
+static const struct {
+    const void* builtin;
+    const void** active;
+} table_sections[TABLES_NSECTIONS] = {
+    { T_tate3,             &T_tate3_active },
+    { T_tate2_firststep_P, &T_tate2_firststep_P_active },
+    { T_tate2_P,           &T_tate2_P_active },
+    { T_tate2_firststep_Q, &T_tate2_firststep_Q_active },
+    { T_tate2_Q,           &T_tate2_Q_active },
+    { ph2_path,            &ph2_path_active },
+    { ph2_Texp,            &ph2_Texp_active },
+    { ph2_Log,             &ph2_Log_active },
+    { ph2_G,               &ph2_G_active },
+    { ph2_CT,              &ph2_CT_active },
+    { ph3_path,            &ph3_path_active },
+    { PH3_T1_BUILTIN,      &ph3_T1_active },
+    { PH3_T2_BUILTIN,      &ph3_T2_active },
+};
+
+#define TABLES_DATA_OFFSET   (((sizeof(tables_header_t) + TABLES_NSECTIONS*sizeof(tables_entry_t)) + TABLES_ALIGN-1) & ~(uint64_t)(TABLES_ALIGN-1))
+
+// Mapping of the loaded table file, released when other tables are loaded
+static void* tables_map = NULL;
+static size_t tables_map_size = 0;
+
+
+static void tables_sizes(const ph_params_t* params, uint64_t* size)
+{ // Sizes in bytes of the table sections for the window sizes in params
+    const uint64_t felm = NWORDS64_FIELD*sizeof(uint64_t);
+
+    size[TABLE_TATE3] = sizeof(T_tate3);
+    size[TABLE_TATE2_FIRSTSTEP_P] = sizeof(T_tate2_firststep_P);
+    size[TABLE_TATE2_P] = sizeof(T_tate2_P);
+    size[TABLE_TATE2_FIRSTSTEP_Q] = sizeof(T_tate2_firststep_Q);
+    size[TABLE_TATE2_Q] = sizeof(T_tate2_Q);
+    size[TABLE_PH2_PATH] = (params->dlen2 + 1)*sizeof(unsigned int);
+    size[TABLE_PH2_TEXP] = ((1 << (params->w2_1 - 2)) - 1)*felm;
+    size[TABLE_PH2_LOG] = ((1 << params->w2_1) - 1)*sizeof(int);
+    size[TABLE_PH2_G] = (1 << (params->w2 - 2))*felm;
+    size[TABLE_PH2_CT] = params->dlen2*(params->ellw2 >> 1)*felm;
+    size[TABLE_PH3_PATH] = (params->dlen3 + 1)*sizeof(unsigned int);
+    size[TABLE_PH3_T1] = params->dlen3*(params->ellw3 >> 1)*2*felm;
+    size[TABLE_PH3_T2] = (OBOB_EXPON % params->w3 == 0) ? 0 : size[TABLE_PH3_T1];
+}
+
+
+static void tables_header_init(tables_header_t* header, const ph_params_t* params)
+{ // Header of a table file for the parameters of this library and the window sizes in params, without checksum
+    memset(header, 0, sizeof(tables_header_t));
+    memcpy(header->magic, "SIDHTBL", 8);
+    header->version = TABLES_VERSION;
+    header->bom = TABLES_BOM;
+    header->nbits_field = NBITS_FIELD;
+    header->nwords_field = NWORDS64_FIELD;
+    header->w2 = params->w2;
+    header->w3 = params->w3;
+    header->nsections = (uint32_t)TABLES_NSECTIONS;
+}
+
+
+static uint64_t tables_layout(tables_entry_t* entries, const ph_params_t* params)
+{ // Directory of a table file for the parameters of this library and the window sizes in params. Returns the total size of the file
+    uint64_t offset = TABLES_DATA_OFFSET, size[TABLES_NSECTIONS];
+
+    tables_sizes(params, size);
+    memset(entries, 0, TABLES_NSECTIONS*sizeof(tables_entry_t));
+    for (unsigned int i = 0; i < TABLES_NSECTIONS; i++) {
+        entries[i].id = i;
+        entries[i].offset = offset;
+        entries[i].size = size[i];
+        offset = (offset + size[i] + TABLES_ALIGN-1) & ~(uint64_t)(TABLES_ALIGN-1);
+    }
+    return offset;
+}
+
+
+static void tables_unmap(void)
+{ // Releasing the mapping of a previously loaded table file
+    if (tables_map == NULL) return;
+#if defined(__NIX__)
+    munmap(tables_map, tables_map_size);
+#else
+    free(tables_map);
+#endif
+    tables_map = NULL;
+    tables_map_size = 0;
+}
+
+
+static void* tables_map_file(const char* path, size_t* size)
+{ // Read-only mapping of a table file, shared with other processes mapping the same file. Returns NULL on error
+    void* map = NULL;
+#if defined(__NIX__)
+    struct stat st;
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0) return NULL;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        *size = (size_t)st.st_size;
+        map = mmap(NULL, *size, PROT_READ, MAP_SHARED, fd, 0);
+        if (map == MAP_FAILED) map = NULL;
+    }
+    close(fd);
+#else
+    FILE* f = fopen(path, "rb");
+    long n;
+
+    if (f == NULL) return NULL;
+    if (fseek(f, 0, SEEK_END) == 0 && (n = ftell(f)) > 0 && fseek(f, 0, SEEK_SET) == 0) {
+        *size = (size_t)n;
+        map = malloc(*size);
+        if (map != NULL && fread(map, 1, *size, f) != *size) {
+            free(map);
+            map = NULL;
+        }
+    }
+    fclose(f);
+#endif
+    return map;
+}
+
+
+int sidh_write_tables(const char* path)
+{ // Writing of the tables in use to a table file that can be loaded with sidh_load_tables()
+  // Returns 0 on success, or -1 if the file cannot be written
+    tables_header_t header;
+    tables_entry_t entries[TABLES_NSECTIONS];
+    unsigned char* buf;
+    uint64_t size;
+    FILE* f;
+    int ok;
+
+    tables_header_init(&header, &ph_params_active);
+    size = tables_layout(entries, &ph_params_active);
+    buf = (unsigned char*)calloc(1, (size_t)size);
+    if (buf == NULL) return -1;
+
+    memcpy(buf + sizeof(tables_header_t), entries, sizeof(entries));
+    for (unsigned int i = 0; i < TABLES_NSECTIONS; i++) {
+        if (entries[i].size > 0) memcpy(buf + entries[i].offset, *table_sections[i].active, (size_t)entries[i].size);
+    }
+    shake256(header.checksum, TABLES_CHECKSUM, buf + sizeof(tables_header_t), size - sizeof(tables_header_t));
+    memcpy(buf, &header, sizeof(tables_header_t));
+
+    f = fopen(path, "wb");
+    ok = (f != NULL && fwrite(buf, 1, (size_t)size, f) == (size_t)size);
+    if (f != NULL && fclose(f) != 0) ok = 0;
+    free(buf);
+    return ok ? 0 : -1;
+}
+
+
+int sidh_load_tables(const char* path)
+{ // Loading of the pairing and discrete log tables from a table file written by sidh_write_tables(), or restoring
+  // the built-in tables if path is NULL. The file is mapped read-only, so that its pages are shared by all processes
+  // using it. The Pohlig-Hellman window sizes of the file are used for the discrete logs, they must be supported by
+  // the library (see ph_windows_supported()). Returns 0 on success, or -1 if the file cannot be mapped or does not match
+  // the parameters of this library (field, window sizes or layout) or its checksum, in which case the tables in use are 
+  // left unchanged. The file must not be modified while it is in use (new tables should be installed by renaming a new file).
+  // Not thread-safe, to be called at initialization
+    tables_header_t header;
+    tables_entry_t entries[TABLES_NSECTIONS];
+    unsigned char checksum[TABLES_CHECKSUM];
+    unsigned char* map;
+    ph_params_t params;
+    size_t size = 0;
+    uint64_t expected;
+
+    if (path == NULL) {
+        for (unsigned int i = 0; i < TABLES_NSECTIONS; i++) {
+            *table_sections[i].active = table_sections[i].builtin;
+        }
+        ph_params_init(&ph_params_active, W_2, W_3);
+        tables_unmap();
+        return 0;
+    }
+
+    map = (unsigned char*)tables_map_file(path, &size);
+    if (map == NULL) return -1;
+    if (size < sizeof(tables_header_t)) goto fail;
+
+    memcpy(&header, map, sizeof(tables_header_t));
+    if (!ph_windows_supported(header.w2, header.w3)) goto fail;
+    ph_params_init(&params, header.w2, header.w3);
+    tables_header_init(&header, &params);
+    expected = tables_layout(entries, &params);
+    if (size != expected || memcmp(map, &header, offsetof(tables_header_t, checksum)) != 0 ||
+        memcmp(map + sizeof(tables_header_t), entries, sizeof(entries)) != 0) {
+        goto fail;
+    }
+    shake256(checksum, TABLES_CHECKSUM, map + sizeof(tables_header_t), size - sizeof(tables_header_t));
+    if (memcmp(checksum, map + offsetof(tables_header_t, checksum), TABLES_CHECKSUM) != 0) {
+        goto fail;
+    }
+
+    for (unsigned int i = 0; i < TABLES_NSECTIONS; i++) {
+        *table_sections[i].active = map + entries[i].offset;
+    }
+    ph_params_active = params;
+    tables_unmap();
+    tables_map = map;
+    tables_map_size = size;
+    return 0;
+
+fail:
+#if defined(__NIX__)
+    munmap(map, size);
+#else
+    free(map);
+#endif
+    return -1;
+}
@@ -351,6 +351,7 @@ static void BuildOrdinary3nBasis_dual(const f2elm_t a24, const f2elm_t As[][5],
     point_proj_t D;
     f2elm_t xs[2];
     unsigned char ind, bit;
+    PROFILE_PHASE_BEGIN(SIDH_PHASE_BASIS);
 
     FirstPoint3n(a24, As, xs[0], R[0], r, &ind, &bit);
     *bitsEll = (unsigned int)bit;
@@ -362,12 +363,14 @@ static void BuildOrdinary3nBasis_dual(const f2elm_t a24, const f2elm_t As[][5],
     BiQuad_affine(a24, xs[0], xs[1], D);
     eval_full_dual_4_isog(As, D);    // Move x over to A = 0
     makeDiff(R[0], R[1], D);
+    PROFILE_PHASE_END();
 }
 
 
 static void BuildOrdinary3nBasis_Decomp_dual(const f2elm_t A24, point_proj_t *Rs, unsigned char *r, const unsigned char bitsEll)
 {
     unsigned char bitEll[2];
+    PROFILE_PHASE_BEGIN(SIDH_PHASE_BASIS);
     
     bitEll[0] = bitsEll & 0x1;
     bitEll[1] = (bitsEll >> 1) & 0x1;    
@@ -377,6 +380,7 @@ static void BuildOrdinary3nBasis_Decomp_dual(const f2elm_t A24, point_proj_t *Rs
     Elligator2(A24, (unsigned int)r[1]-1, Rs[1]->X, &bitEll[1], DECOMPRESSION);
     // Get x-coordinate of difference
     BiQuad_affine(A24, Rs[0]->X, Rs[1]->X, Rs[2]);
+    PROFILE_PHASE_END();
 }
 
 
@@ -454,6 +458,7 @@ static void BuildOrdinary2nBasis_dual(const f2elm_t A, const f2elm_t Ds[][2], po
     felm_t t0;
     f2elm_t A6 = {0};
     point_proj_t xs[3] = {0};    
+    PROFILE_PHASE_BEGIN(SIDH_PHASE_BASIS);
 
     // Generate x-only entangled basis 
     BuildEntangledXonly(A, xs, qnr, ind);
@@ -476,6 +481,7 @@ static void BuildOrdinary2nBasis_dual(const f2elm_t A, const f2elm_t Ds[][2], po
 
     CompleteMPoint(A6, xs[0]->X, xs[0]->Z, Rs[0]);
     RecoverY(A6, xs, Rs);
+    PROFILE_PHASE_END();
 }
 
 
@@ -514,6 +520,7 @@ static void getrvOf2mPoint_Decomp(const unsigned char vqnr, const unsigned char
 static void BuildEntangledXonly_Decomp(const f2elm_t A, point_proj_t *R, unsigned char qnr, unsigned char ind)
 {
     f2elm_t r, t, v;
+    PROFILE_PHASE_BEGIN(SIDH_PHASE_BASIS);
 
     getrvOf2mPoint_Decomp(qnr, ind, r[0], v);
 
@@ -569,4 +576,5 @@ static void BuildEntangledXonly_Decomp(const f2elm_t A, point_proj_t *R, unsigne
         fp2sqr_mont(r, r);
         fp2mul_mont(R[2]->Z, r, R[2]->Z);
     }
+    PROFILE_PHASE_END();
 }
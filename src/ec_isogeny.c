@@ -132,10 +132,8 @@ void xTPL(const point_proj_t P, point_proj_t Q, const f2elm_t A24minus, const f2
     mp2_sub_p2(t1, t3, t1);                         // t1 = 4*X^2 - (X+Z)^2 
     mp2_sub_p2(t1, t2, t1);                         // t1 = 4*X^2 - (X+Z)^2 - (X-Z)^2
     fp2mul_mont(A24plus, t3, t5);                   // t5 = A24plus*(X+Z)^2 
-    fp2mul_mont(t3, t5, t3);                        // t3 = A24plus*(X+Z)^4
     fp2mul_mont(A24minus, t2, t6);                  // t6 = A24minus*(X-Z)^2
-    fp2mul_mont(t2, t6, t2);                        // t2 = A24minus*(X-Z)^4
-    mp2_sub_p2(t2, t3, t3);                         // t3 = A24minus*(X-Z)^4 - A24plus*(X+Z)^4
+    fp2mulsub_mont(t2, t6, t3, t5, t3);            // t3 = A24minus*(X-Z)^4 - A24plus*(X+Z)^4
     mp2_sub_p2(t5, t6, t2);                         // t2 = A24plus*(X+Z)^2 - A24minus*(X-Z)^2
     fp2mul_mont(t1, t2, t1);                        // t1 = [4*X^2 - (X+Z)^2 - (X-Z)^2]*[A24plus*(X+Z)^2 - A24minus*(X-Z)^2]
     fp2add(t3, t1, t2);                             // t2 = [4*X^2 - (X+Z)^2 - (X-Z)^2]*[A24plus*(X+Z)^2 - A24minus*(X-Z)^2] + A24minus*(X-Z)^4 - A24plus*(X+Z)^4
@@ -246,26 +244,36 @@ void get_A(const f2elm_t xP, const f2elm_t xQ, const f2elm_t xR, f2elm_t A)
 }
 
 
+void j_inv_proj(const f2elm_t A, const f2elm_t C, f2elm_t jnum, f2elm_t jden)
+{ // Computes the j-invariant of a Montgomery curve with projective constant as a fraction jnum/jden, without inversion.
+  // Input: A,C in GF(p^2).
+  // Output: jnum=256*(A^2-3*C^2)^3 and jden=C^4*(A^2-4*C^2), such that j=jnum/jden.
+    f2elm_t t1;
+    
+    fp2sqr_mont(A, jden);                           // jden = A^2        
+    fp2sqr_mont(C, t1);                             // t1 = C^2
+    fp2add(t1, t1, jnum);                           // jnum = t1+t1
+    fp2sub(jden, jnum, jnum);                       // jnum = jden-jnum
+    fp2sub(jnum, t1, jnum);                         // jnum = jnum-t1
+    fp2sub(jnum, t1, jden);                         // jden = jnum-t1
+    fp2sqr_mont(t1, t1);                            // t1 = t1^2
+    fp2mul_mont(jden, t1, jden);                    // jden = jden*t1
+    fp2add(jnum, jnum, jnum);                       // jnum = jnum+jnum
+    fp2add(jnum, jnum, jnum);                       // jnum = jnum+jnum
+    fp2sqr_mont(jnum, t1);                          // t1 = jnum^2
+    fp2mul_mont(jnum, t1, jnum);                    // jnum = jnum*t1
+    fp2add(jnum, jnum, jnum);                       // jnum = jnum+jnum
+    fp2add(jnum, jnum, jnum);                       // jnum = jnum+jnum
+}
+
+
 void j_inv(const f2elm_t A, const f2elm_t C, f2elm_t jinv)
 { // Computes the j-invariant of a Montgomery curve with projective constant.
   // Input: A,C in GF(p^2).
   // Output: j=256*(A^2-3*C^2)^3/(C^4*(A^2-4*C^2)), which is the j-invariant of the Montgomery curve B*y^2=x^3+(A/C)*x^2+x or (equivalently) j-invariant of B'*y^2=C*x^3+A*x^2+C*x.
-    f2elm_t t0, t1;
+    f2elm_t t0;
     
-    fp2sqr_mont(A, jinv);                           // jinv = A^2        
-    fp2sqr_mont(C, t1);                             // t1 = C^2
-    fp2add(t1, t1, t0);                             // t0 = t1+t1
-    fp2sub(jinv, t0, t0);                           // t0 = jinv-t0
-    fp2sub(t0, t1, t0);                             // t0 = t0-t1
-    fp2sub(t0, t1, jinv);                           // jinv = t0-t1
-    fp2sqr_mont(t1, t1);                            // t1 = t1^2
-    fp2mul_mont(jinv, t1, jinv);                    // jinv = jinv*t1
-    fp2add(t0, t0, t0);                             // t0 = t0+t0
-    fp2add(t0, t0, t0);                             // t0 = t0+t0
-    fp2sqr_mont(t0, t1);                            // t1 = t0^2
-    fp2mul_mont(t0, t1, t0);                        // t0 = t0*t1
-    fp2add(t0, t0, t0);                             // t0 = t0+t0
-    fp2add(t0, t0, t0);                             // t0 = t0+t0
+    j_inv_proj(A, C, t0, jinv);                     // j = t0/jinv
     fp2inv_mont(jinv);                              // jinv = 1/jinv 
     fp2mul_mont(jinv, t0, jinv);                    // jinv = t0*jinv
 }
@@ -322,12 +330,12 @@ static void swap_points(point_proj_t P, point_proj_t Q, const digit_t option)
 }
 
 
-static void LADDER3PT(const f2elm_t xP, const f2elm_t xQ, const f2elm_t xPQ, const digit_t* m, const unsigned int AliceOrBob, point_proj_t R, const f2elm_t A)
-{
+static void LADDER3PT_A24(const f2elm_t xP, const f2elm_t xQ, const f2elm_t xPQ, const digit_t* m, const unsigned int AliceOrBob, point_proj_t R, const f2elm_t A24)
+{ // Three-point ladder computing R = P + m*Q on the Montgomery curve with constant A24 = (A+2)/4
     point_proj_t R0 = {0}, R2 = {0};
-    f2elm_t A24 = {0};
     digit_t mask;
     int i, nbits, bit, swap, prevbit = 0;
+    PROFILE_PHASE_BEGIN(SIDH_PHASE_LADDER);
 
     if (AliceOrBob == ALICE) {
         nbits = OALICE_BITS;
@@ -335,13 +343,6 @@ static void LADDER3PT(const f2elm_t xP, const f2elm_t xQ, const f2elm_t xPQ, con
         nbits = OBOB_BITS - 1;
     }
 
-    // Initializing constant
-    fpcopy((digit_t*)&Montgomery_one, A24[0]);
-    mp2_add(A24, A24, A24);
-    mp2_add(A, A24, A24);
-    fp2div2(A24, A24);  
-    fp2div2(A24, A24);  // A24 = (A+2)/4
-
     // Initializing points
     fp2copy(xQ, R0->X);
     fpcopy((digit_t*)&Montgomery_one, (digit_t*)R0->Z);
@@ -364,8 +365,186 @@ static void LADDER3PT(const f2elm_t xP, const f2elm_t xQ, const f2elm_t xPQ, con
     swap = 0 ^ prevbit;
     mask = 0 - (digit_t)swap;
     swap_points(R, R2, mask);
+    PROFILE_PHASE_END();
+}
+
+
+#if defined(COMPRESS) || !defined(SIDH_FIXED_BASE)
+
+static void LADDER3PT(const f2elm_t xP, const f2elm_t xQ, const f2elm_t xPQ, const digit_t* m, const unsigned int AliceOrBob, point_proj_t R, const f2elm_t A)
+{ // Three-point ladder computing R = P + m*Q on the Montgomery curve with coefficient A
+    f2elm_t A24 = {0};
+
+    // Initializing constant
+    fpcopy((digit_t*)&Montgomery_one, A24[0]);
+    mp2_add(A24, A24, A24);
+    mp2_add(A, A24, A24);
+    fp2div2(A24, A24);  
+    fp2div2(A24, A24);  // A24 = (A+2)/4
+
+    LADDER3PT_A24(xP, xQ, xPQ, m, AliceOrBob, R, A24);
+}
+
+#endif
+
+#define LADDER_BATCH_SIZE    8    // Number of scalars of a pass of LADDER3PT_A24_batch
+
+
+static void xADD_shared(const f2elm_t S0, const f2elm_t S1, point_proj_t Q, const point_proj_t D)
+{ // Differential addition Q <- P+Q of xDBLADD, for S0 = XP+ZP and S1 = XP-ZP computed once for all the points Q added to P.
+  // Input: S0, S1 of a projective Montgomery point P=(XP:ZP), projective Montgomery point Q=(XQ:ZQ) and difference D = P-Q.
+  // Output: Q <- P+Q = (XQP:ZQP) such that = x(Q+P)=XQP/ZQP.
+    f2elm_t t0, t1, t2;
+
+    mp2_sub_p2(Q->X, Q->Z, t2);                     // t2 = XQ-ZQ
+    mp2_add(Q->X, Q->Z, Q->X);                      // XQ = XQ+ZQ
+    fp2mul_mont(S0, t2, t0);                        // t0 = (XP+ZP)*(XQ-ZQ)
+    fp2mul_mont(S1, Q->X, t1);                      // t1 = (XP-ZP)*(XQ+ZQ)
+    mp2_sub_p2(t0, t1, Q->Z);                       // ZQ = (XP+ZP)*(XQ-ZQ)-(XP-ZP)*(XQ+ZQ)
+    mp2_add(t0, t1, Q->X);                          // XQ = (XP+ZP)*(XQ-ZQ)+(XP-ZP)*(XQ+ZQ)
+    fp2sqr_mont(Q->Z, Q->Z);                        // ZQ = [(XP+ZP)*(XQ-ZQ)-(XP-ZP)*(XQ+ZQ)]^2
+    fp2sqr_mont(Q->X, Q->X);                        // XQ = [(XP+ZP)*(XQ-ZQ)+(XP-ZP)*(XQ+ZQ)]^2
+    fp2mul_mont(Q->Z, D->X, Q->Z);                  // ZQ = xPQ*[(XP+ZP)*(XQ-ZQ)-(XP-ZP)*(XQ+ZQ)]^2
+    fp2mul_mont(Q->X, D->Z, Q->X);                  // XQ = ZPQ*[(XP+ZP)*(XQ-ZQ)+(XP-ZP)*(XQ+ZQ)]^2
+}
+
+
+static void xDBL_shared(point_proj_t P, f2elm_t S0, const f2elm_t S1, const f2elm_t A24)
+{ // Doubling P <- 2*P of xDBLADD, for S0 = XP+ZP and S1 = XP-ZP. S0 is overwritten.
+    f2elm_t t2;
+
+    fp2sqr_mont(S0, P->X);                          // XP = (XP+ZP)^2
+    fp2sqr_mont(S1, P->Z);                          // ZP = (XP-ZP)^2
+    mp2_sub_p2(P->X, P->Z, t2);                     // t2 = (XP+ZP)^2-(XP-ZP)^2
+    fp2mul_mont(P->X, P->Z, P->X);                  // XP = (XP+ZP)^2*(XP-ZP)^2
+    fp2mul_mont(A24, t2, S0);                       // S0 = A24*[(XP+ZP)^2-(XP-ZP)^2]
+    mp2_add(S0, P->Z, P->Z);                        // ZP = A24*[(XP+ZP)^2-(XP-ZP)^2]+(XP-ZP)^2
+    fp2mul_mont(P->Z, t2, P->Z);                    // ZP = [A24*[(XP+ZP)^2-(XP-ZP)^2]+(XP-ZP)^2]*[(XP+ZP)^2-(XP-ZP)^2]
+}
+
+
+static void LADDER3PT_A24_batch(const f2elm_t xP, const f2elm_t xQ, const f2elm_t xPQ, const digit_t* m, const unsigned int AliceOrBob, point_proj_t* R, const f2elm_t A24, const unsigned int n)
+{ // Three-point ladders computing R[k] = P + m_k*Q for n scalars m_k = m[k*NWORDS_ORDER .. (k+1)*NWORDS_ORDER-1] on the same
+  // Montgomery curve with constant A24 = (A+2)/4. The ladders of up to LADDER_BATCH_SIZE scalars run in lockstep: the point
+  // doubled at step i is 2^i*Q in every ladder, independently of the scalar, so it is doubled once per step for the whole
+  // batch and only the differential additions are computed per scalar. The sequence of operations does not depend on the
+  // scalars, so every ladder is constant-time.
+    point_proj_t R0 = {0}, R2[LADDER_BATCH_SIZE] = {0};
+    f2elm_t S0, S1;
+    digit_t mask;
+    int i, nbits, bit, swap, prevbit[LADDER_BATCH_SIZE];
+    unsigned int k, first, batch;
+    PROFILE_PHASE_BEGIN(SIDH_PHASE_LADDER);
+
+    if (AliceOrBob == ALICE) {
+        nbits = OALICE_BITS;
+    } else {
+        nbits = OBOB_BITS - 1;
+    }
+
+    for (first = 0; first < n; first += batch) {
+        batch = (n - first < LADDER_BATCH_SIZE) ? (n - first) : LADDER_BATCH_SIZE;
+        point_proj_t* Rb = R + first;
+        const digit_t* mb = m + first*NWORDS_ORDER;
+
+        // Initializing points
+        fp2copy(xQ, R0->X);
+        fpcopy((digit_t*)&Montgomery_one, (digit_t*)R0->Z);
+        fpzero((digit_t*)(R0->Z)[1]);
+        for (k = 0; k < batch; k++) {
+            fp2copy(xPQ, R2[k]->X);
+            fpcopy((digit_t*)&Montgomery_one, (digit_t*)R2[k]->Z);
+            fpzero((digit_t*)(R2[k]->Z)[1]);
+            fp2copy(xP, Rb[k]->X);
+            fpcopy((digit_t*)&Montgomery_one, (digit_t*)Rb[k]->Z);
+            fpzero((digit_t*)(Rb[k]->Z)[1]);
+            prevbit[k] = 0;
+        }
+
+        // Main loop
+        for (i = 0; i < nbits; i++) {
+            for (k = 0; k < batch; k++) {
+                bit = (mb[k*NWORDS_ORDER + (i >> LOG2RADIX)] >> (i & (RADIX-1))) & 1;
+                swap = bit ^ prevbit[k];
+                prevbit[k] = bit;
+                mask = 0 - (digit_t)swap;
+                swap_points(Rb[k], R2[k], mask);
+            }
+            mp2_add(R0->X, R0->Z, S0);                  // S0 = XP+ZP
+            mp2_sub_p2(R0->X, R0->Z, S1);               // S1 = XP-ZP
+            for (k = 0; k < batch; k++) {
+                xADD_shared(S0, S1, R2[k], Rb[k]);
+            }
+            xDBL_shared(R0, S0, S1, A24);
+        }
+        for (k = 0; k < batch; k++) {
+            swap = 0 ^ prevbit[k];
+            mask = 0 - (digit_t)swap;
+            swap_points(Rb[k], R2[k], mask);
+        }
+    }
+    PROFILE_PHASE_END();
+}
+
+#ifndef COMPRESS
+
+#if defined(SIDH_FIXED_BASE)
+
+static void LADDER3PT_fixed(const digit_t* gen, const digit_t* gen_dbl, const digit_t* m, const unsigned int AliceOrBob, point_proj_t* R, const unsigned int n)
+{ // Three-point ladders computing R[k] = P + m_k*Q for n scalars m_k = m[k*NWORDS_ORDER .. (k+1)*NWORDS_ORDER-1], where
+  // gen = {xP, xQ, xPQ} are the generators A_gen or B_gen. The point doubled at step i is 2^i*Q, so its affine x-coordinate
+  // is read from the precomputed table gen_dbl (x(2^i*Q) in GF(p^2), in Montgomery representation) and every step only
+  // computes a differential addition. The table is read in the same order for all scalars, so the ladders are constant-time.
+    point_proj_t R2 = {0};
+    f2elm_t xP, xPQ, one = {0}, S0, S1;
+    digit_t mask;
+    int i, nbits, bit, swap, prevbit;
+    unsigned int k;
+    PROFILE_PHASE_BEGIN(SIDH_PHASE_LADDER);
+
+    if (AliceOrBob == ALICE) {
+        nbits = OALICE_BITS;
+    } else {
+        nbits = OBOB_BITS - 1;
+    }
+
+    fpcopy(gen,                  xP[0]);
+    fpcopy(gen +   NWORDS_FIELD, xP[1]);
+    fpcopy(gen + 4*NWORDS_FIELD, xPQ[0]);
+    fpcopy(gen + 5*NWORDS_FIELD, xPQ[1]);
+    fpcopy((digit_t*)&Montgomery_one, one[0]);
+
+    for (k = 0; k < n; k++) {
+        // Initializing points
+        fp2copy(xPQ, R2->X);
+        fp2copy(one, R2->Z);
+        fp2copy(xP, R[k]->X);
+        fp2copy(one, R[k]->Z);
+        prevbit = 0;
+
+        // Main loop
+        for (i = 0; i < nbits; i++) {
+            bit = (m[k*NWORDS_ORDER + (i >> LOG2RADIX)] >> (i & (RADIX-1))) & 1;
+            swap = bit ^ prevbit;
+            prevbit = bit;
+            mask = 0 - (digit_t)swap;
+
+            swap_points(R[k], R2, mask);
+            mp2_add((const felm_t*)(gen_dbl + 2*i*NWORDS_FIELD), one, S0);       // S0 = x(2^i*Q)+1
+            mp2_sub_p2((const felm_t*)(gen_dbl + 2*i*NWORDS_FIELD), one, S1);    // S1 = x(2^i*Q)-1
+            xADD_shared(S0, S1, R2, R[k]);
+        }
+        swap = 0 ^ prevbit;
+        mask = 0 - (digit_t)swap;
+        swap_points(R[k], R2, mask);
+    }
+    PROFILE_PHASE_END();
 }
 
+#endif
+
+#endif
+
 #ifdef COMPRESS
 
 
@@ -380,7 +559,6 @@ static void RecoverY(const f2elm_t A, const point_proj_t *xs, point_full_proj_t
     fp2sqr_mont(xs[1]->X, t4);
     fp2sqr_mont(xs[1]->Z, Rs[1]->X);
     fp2sub(t2, t3, Rs[1]->Y);
-    fp2mul_mont(xs[1]->X, Rs[1]->Y, Rs[1]->Y);
     fp2add(t4, Rs[1]->X, t4);
     fp2mul_mont(xs[2]->Z, t4, t4);
     fp2mul_mont(A, t1, Rs[1]->X);
@@ -392,8 +570,7 @@ static void RecoverY(const f2elm_t A, const point_proj_t *xs, point_full_proj_t
     fp2sub(t0, t1, t0);
     fp2mul_mont(xs[1]->Z, t0, t0);
     fp2sub(t0, t4, t0);
-    fp2mul_mont(Rs[0]->X, t0, t0);
-    fp2add(t0, Rs[1]->Y, Rs[1]->Y);
+    fp2muladd_mont(Rs[0]->X, t0, xs[1]->X, Rs[1]->Y, Rs[1]->Y);
     fp2mul_mont(Rs[0]->Y, t3, t0);
     fp2mul_mont(xs[1]->X, t0, Rs[1]->X);
     fp2add(Rs[1]->X, Rs[1]->X, Rs[1]->X);
@@ -430,7 +607,7 @@ static void CompletePoint(const point_proj_t P, point_full_proj_t R)
 
 void CompleteMPoint(const f2elm_t A, const f2elm_t PX, const f2elm_t PZ, point_full_proj_t R)
 { // Given an xz-only representation on a montgomery curve, compute its affine representation
-    f2elm_t zero = {0}, one = {0}, xz, yz, s2, r2, invz, temp0, temp1;
+    f2elm_t zero = {0}, one = {0}, xz, yz, r2, invz, temp0, temp1;
 
     fpcopy((digit_t*)&Montgomery_one, one[0]);    
     if (memcmp(PZ[0], zero, NBITS_TO_NBYTES(NBITS_FIELD)) != 0 || memcmp(PZ[1], zero, NBITS_TO_NBYTES(NBITS_FIELD)) != 0) {
@@ -439,9 +616,7 @@ void CompleteMPoint(const f2elm_t A, const f2elm_t PX, const f2elm_t PZ, point_f
         fpadd(PX[1], PZ[0], temp0[1]);
         fpadd(PX[0], PZ[1], temp1[0]);
         fpsub(PX[1], PZ[0], temp1[1]);        
-        fp2mul_mont(temp0, temp1, s2);     // s2 = (x + i*z)*(x - i*z);
-        fp2mul_mont(A, xz, temp0);
-        fp2add(temp0, s2, temp1);
+        fp2muladd_mont(A, xz, temp0, temp1, temp1);   // temp1 = A*xz + s2, where s2 = (x + i*z)*(x - i*z);
         fp2mul_mont(xz, temp1, r2);        // r2 = xz*(A*xz + s2);
         sqrt_Fp2(r2, yz);
         fp2copy(PZ, invz);
@@ -571,9 +746,7 @@ static void eval_dual_4_isog(const f2elm_t A24, const f2elm_t C24, const f2elm_t
     fp2sub(t2, t3, t2);
     fp2mul_mont(t2, t0, P->X);
     fp2mul_mont(t3, t1, P->Z);
-    fp2mul_mont(coeff[0], P->X, P->X);
-    fp2mul_mont(coeff[1], P->Z, t0);
-    fp2add(P->X, t0, P->X);
+    fp2muladd_mont(coeff[0], P->X, coeff[1], P->Z, P->X);
     fp2mul_mont(coeff[2], P->Z, P->Z);
 }
 
@@ -651,6 +824,7 @@ void Ladder(const point_proj_t P, const digit_t* m, const f2elm_t A, const unsig
     f2elm_t A24 = {0};
     digit_t mask;
     unsigned int bit = 0, prevbit = 0, j, swap;
+    PROFILE_PHASE_BEGIN(SIDH_PHASE_LADDER);
         
     fpcopy((digit_t*)&Montgomery_one, A24[0]);
     fpadd(A24[0], A24[0], A24[0]);
@@ -682,6 +856,7 @@ void Ladder(const point_proj_t P, const digit_t* m, const f2elm_t A, const unsig
     
     fp2copy(R0->X, R->X);
     fp2copy(R0->Z, R->Z);
+    PROFILE_PHASE_END();
 }
 
 
@@ -690,6 +865,7 @@ static void Ladder3pt_dual(const point_proj_t *Rs, const digit_t* m, const unsig
     point_proj_t R0 = {0}, R2 = {0};
     digit_t mask;
     int i, nbits, bit, swap, prevbit = 0;
+    PROFILE_PHASE_BEGIN(SIDH_PHASE_LADDER);
 
     if (AliceOrBob == ALICE) {
         nbits = OALICE_BITS;
@@ -717,6 +893,7 @@ static void Ladder3pt_dual(const point_proj_t *Rs, const digit_t* m, const unsig
     swap = 0 ^ prevbit;
     mask = 0 - (digit_t)swap;
     swap_points(R, R2, mask);
+    PROFILE_PHASE_END();
 }
 
 #endif
\ No newline at end of file
@@ -140,6 +140,7 @@ void copy_words(const digit_t* a, digit_t* c, const unsigned int nwords)
 
 void fpmul_mont(const digit_t* ma, const digit_t* mb, digit_t* mc)
 { // Multiprecision multiplication, c = a*b mod p.
+    PROFILE_COUNT(SIDH_OP_FPMUL);
 #if defined(_MULX_) && defined(_ADX_) && (OS_TARGET == OS_NIX) && (NBITS_FIELD != 751)
     fpmul(ma, mb, mc);
 #else
@@ -153,6 +154,7 @@ void fpmul_mont(const digit_t* ma, const digit_t* mb, digit_t* mc)
 
 void fpsqr_mont(const digit_t* ma, digit_t* mc)
 { // Multiprecision squaring, c = a^2 mod p.
+    PROFILE_COUNT(SIDH_OP_FPSQR);
 #if defined(_MULX_) && defined(_ADX_) && (OS_TARGET == OS_NIX) && (NBITS_FIELD != 751)
     fpmul(ma, ma, mc);
 #else
@@ -168,11 +170,13 @@ void fpinv_mont(digit_t* a)
 { // Field inversion using Montgomery arithmetic, a = a^(-1)*R mod p.
     felm_t tt;
 
+    PROFILE_ENTER(SIDH_OP_FPINV);
     fpcopy(a, tt);
     fpinv_chain_mont(tt);
     fpsqr_mont(tt, tt);
     fpsqr_mont(tt, tt);
     fpmul_mont(a, tt, a);
+    PROFILE_LEAVE();
 }
 
 
@@ -199,15 +203,19 @@ void fp2neg(f2elm_t a)
 
 inline void fp2add(const f2elm_t a, const f2elm_t b, f2elm_t c)           
 { // GF(p^2) addition, c = a+b in GF(p^2).
+    PROFILE_ENTER(SIDH_OP_FP2ADD);
     fpadd(a[0], b[0], c[0]);
     fpadd(a[1], b[1], c[1]);
+    PROFILE_LEAVE();
 }
 
 
 inline void fp2sub(const f2elm_t a, const f2elm_t b, f2elm_t c)          
 { // GF(p^2) subtraction, c = a-b in GF(p^2).
+    PROFILE_ENTER(SIDH_OP_FP2SUB);
     fpsub(a[0], b[0], c[0]);
     fpsub(a[1], b[1], c[1]);
+    PROFILE_LEAVE();
 }
 
 
@@ -269,6 +277,7 @@ void fp2sqr_mont(const f2elm_t a, f2elm_t c)
 { // GF(p^2) squaring using Montgomery arithmetic, c = a^2 in GF(p^2).
   // Inputs: a = a0+a1*i, where a0, a1 are in [0, 2*p-1] 
   // Output: c = c0+c1*i, where c0, c1 are in [0, 2*p-1]  
+    PROFILE_ENTER(SIDH_OP_FP2SQR);
 #if defined(_MULX_) && defined(_ADX_) && (OS_TARGET == OS_NIX) && (NBITS_FIELD != 751)
     dfelm_t tt1; 
     
@@ -284,6 +293,7 @@ void fp2sqr_mont(const f2elm_t a, f2elm_t c)
     fpmul_mont(t1, t2, c[0]);                        // c0 = (a0+a1)(a0-a1)
     fpmul_mont(t3, a[1], c[1]);                      // c1 = 2a0*a1
 #endif
+    PROFILE_LEAVE();
 }
 
 
@@ -335,6 +345,7 @@ void fp2mul_mont(const f2elm_t a, const f2elm_t b, f2elm_t c)
 { // GF(p^2) multiplication using Montgomery arithmetic, c = a*b in GF(p^2).
   // Inputs: a = a0+a1*i and b = b0+b1*i, where a0, a1, b0, b1 are in [0, 2*p-1] 
   // Output: c = c0+c1*i, where c0, c1 are in [0, 2*p-1] 
+    PROFILE_COUNT(SIDH_OP_FP2MUL);
 #if defined(_MULX_) && defined(_ADX_) && (OS_TARGET == OS_NIX) && (NBITS_FIELD != 751)
     felm_t t1;
     
@@ -357,6 +368,102 @@ void fp2mul_mont(const f2elm_t a, const f2elm_t b, f2elm_t c)
 #endif
 }
 
+#if !(defined(_MULX_) && defined(_ADX_) && (OS_TARGET == OS_NIX) && (NBITS_FIELD != 751))
+
+inline static void fp2mul_unreduced(const f2elm_t a, const f2elm_t b, df2elm_t c)
+{ // GF(p^2) multiplication without reduction, c = a*b in GF(p^2) as a double-precision element.
+  // Inputs: a = a0+a1*i and b = b0+b1*i, where a0, a1, b0, b1 are in [0, 2*p-1] 
+  // Output: c = c0+c1*i, where c0, c1 are in [0, p*2^MAXBITS_FIELD-1]
+    felm_t t1, t2;
+    dfelm_t tt2; 
+    
+    mp_addfast(a[0], a[1], t1);                      // t1 = a0+a1
+    mp_addfast(b[0], b[1], t2);                      // t2 = b0+b1
+    mp_mul(a[0], b[0], c[0], NWORDS_FIELD);          // c0 = a0*b0
+    mp_mul(a[1], b[1], tt2, NWORDS_FIELD);           // tt2 = a1*b1
+    mp_mul(t1, t2, c[1], NWORDS_FIELD);              // c1 = (a0+a1)*(b0+b1)
+    mp_dblsubfast(c[0], tt2, c[1]);                  // c1 = (a0+a1)*(b0+b1) - a0*b0 - a1*b1
+    mp_subaddfast(c[0], tt2, c[0]);                  // c0 = a0*b0 - a1*b1 + p*2^MAXBITS_FIELD if a0*b0 - a1*b1 < 0, else c0 = a0*b0 - a1*b1
+}
+
+
+inline static void mp2_addx2(const df2elm_t a, const df2elm_t b, df2elm_t c)
+{ // Double-precision addition of two outputs of fp2mul_unreduced(), c0 = a0+b0-(p*2^MAXBITS_FIELD) if a0+b0 >= p*2^MAXBITS_FIELD, 
+  // otherwise c0 = a0+b0, and c1 = a1+b1. Output components are in [0, p*2^MAXBITS_FIELD-1], so that the result can go through 
+  // rdc_mont(): a0, b0 are in [0, p*2^MAXBITS_FIELD-1], and a1, b1 are in [0, 8*p^2-1] with 16*p < 2^MAXBITS_FIELD
+    felm_t t1;
+    digit_t mask;
+    
+    mp_add(a[0], b[0], c[0], 2*NWORDS_FIELD);
+    mask = 0 - (digit_t)mp_sub(&c[0][NWORDS_FIELD], (digit_t*)PRIME, &c[0][NWORDS_FIELD], NWORDS_FIELD);
+    for (int i = 0; i < NWORDS_FIELD; i++)
+        t1[i] = ((digit_t*)PRIME)[i] & mask;
+    mp_add(&c[0][NWORDS_FIELD], t1, &c[0][NWORDS_FIELD], NWORDS_FIELD);
+    mp_add(a[1], b[1], c[1], 2*NWORDS_FIELD);
+}
+
+
+inline static void mp2_subx2(const df2elm_t a, const df2elm_t b, df2elm_t c)
+{ // Double-precision GF(p^2) subtraction, c = a-b+(p*2^MAXBITS_FIELD) if a-b < 0, otherwise c = a-b.
+  // Inputs and output components are in [0, p*2^MAXBITS_FIELD-1], so that the result can go through rdc_mont().
+    mp_subaddfast(a[0], b[0], c[0]);
+    mp_subaddfast(a[1], b[1], c[1]);
+}
+
+
+inline static void fp2rdc_mont(df2elm_t a, f2elm_t c)
+{ // GF(p^2) Montgomery reduction of a double-precision element, c = a*R^-1 in GF(p^2).
+  // Input: a = a0+a1*i, where a0, a1 are in [0, p*2^MAXBITS_FIELD-1]. Output: c0, c1 are in [0, 2*p-1]
+    rdc_mont(a[0], c[0]);
+    rdc_mont(a[1], c[1]);
+}
+
+#endif
+
+
+void fp2muladd_mont(const f2elm_t a, const f2elm_t b, const f2elm_t c, const f2elm_t d, f2elm_t e)
+{ // GF(p^2) sum of products, e = a*b + c*d in GF(p^2), with a single reduction of the accumulated products when 
+  // fp2mul_mont() is not the fused x64 assembly.
+  // Inputs: a, b, c, d with components in [0, 2*p-1]. Output: e with components in [0, 2*p-1]
+#if defined(_MULX_) && defined(_ADX_) && (OS_TARGET == OS_NIX) && (NBITS_FIELD != 751)
+    f2elm_t t1;
+
+    fp2mul_mont(a, b, t1);
+    fp2mul_mont(c, d, e);
+    fp2add(t1, e, e);
+#else
+    df2elm_t tt1, tt2;
+
+    PROFILE_COUNT_N(SIDH_OP_FP2MUL, 2);
+    fp2mul_unreduced(a, b, tt1);
+    fp2mul_unreduced(c, d, tt2);
+    mp2_addx2(tt1, tt2, tt1);
+    fp2rdc_mont(tt1, e);
+#endif
+}
+
+
+void fp2mulsub_mont(const f2elm_t a, const f2elm_t b, const f2elm_t c, const f2elm_t d, f2elm_t e)
+{ // GF(p^2) difference of products, e = a*b - c*d in GF(p^2), with a single reduction of the accumulated products when 
+  // fp2mul_mont() is not the fused x64 assembly.
+  // Inputs: a, b, c, d with components in [0, 2*p-1]. Output: e with components in [0, 2*p-1]
+#if defined(_MULX_) && defined(_ADX_) && (OS_TARGET == OS_NIX) && (NBITS_FIELD != 751)
+    f2elm_t t1;
+
+    fp2mul_mont(a, b, t1);
+    fp2mul_mont(c, d, e);
+    fp2sub(t1, e, e);
+#else
+    df2elm_t tt1, tt2;
+
+    PROFILE_COUNT_N(SIDH_OP_FP2MUL, 2);
+    fp2mul_unreduced(a, b, tt1);
+    fp2mul_unreduced(c, d, tt2);
+    mp2_subx2(tt1, tt2, tt1);
+    fp2rdc_mont(tt1, e);
+#endif
+}
+
 
 void fpinv_chain_mont(digit_t* a)
 { // Chain to compute a^((p-3)/4) using Montgomery arithmetic.
@@ -851,6 +958,7 @@ void fp2inv_mont(f2elm_t a)
 {// GF(p^2) inversion using Montgomery arithmetic, a = (a0-i*a1)/(a0^2+a1^2).
     f2elm_t t1;
 
+    PROFILE_ENTER(SIDH_OP_FP2INV);
     fpsqr_mont(a[0], t1[0]);                         // t10 = a0^2
     fpsqr_mont(a[1], t1[1]);                         // t11 = a1^2
     fpadd(t1[0], t1[1], t1[0]);                      // t10 = a0^2+a1^2
@@ -858,6 +966,7 @@ void fp2inv_mont(f2elm_t a)
     fpneg(a[1]);                                     // a = a0-i*a1
     fpmul_mont(a[0], t1[0], a[0]);
     fpmul_mont(a[1], t1[0], a[1]);                   // a = (a0-i*a1)*(a0^2+a1^2)^-1
+    PROFILE_LEAVE();
 }
 
 
@@ -919,6 +1028,29 @@ void mp_shiftl1(digit_t* x, const unsigned int nwords)
     x[0] <<= 1;
 }
 
+
+void mont_n_way_inv_ct(const f2elm_t* vec, const int n, f2elm_t* out)
+{ // n-way simultaneous inversion using Montgomery's trick and a constant-time GF(p^2) inversion.
+  // All inputs must be nonzero, otherwise every output is zero.
+  // Also, vec and out CANNOT be the same variable!
+    f2elm_t t1;
+    int i;
+
+    fp2copy(vec[0], out[0]);                      // out[0] = vec[0]
+    for (i = 1; i < n; i++) {
+        fp2mul_mont(out[i-1], vec[i], out[i]);    // out[i] = out[i-1]*vec[i]
+    }
+
+    fp2copy(out[n-1], t1);                        // t1 = 1/out[n-1]
+    fp2inv_mont(t1);
+    
+    for (i = n-1; i >= 1; i--) {
+        fp2mul_mont(out[i-1], t1, out[i]);        // out[i] = t1*out[i-1]
+        fp2mul_mont(t1, vec[i], t1);              // t1 = t1*vec[i]
+    }
+    fp2copy(t1, out[0]);                          // out[0] = t1
+}
+
 #ifdef COMPRESS
 
 static inline unsigned int is_felm_zero(const felm_t x)
@@ -1245,6 +1377,7 @@ void fpinv_mont_bingcd(digit_t* a)
     if (is_felm_zero(a) == true)
         return;
 
+    PROFILE_ENTER(SIDH_OP_FPINV_BINGCD);
     fpinv_mont_bingcd_partial(a, x, &k);
     if (k <= MAXBITS_FIELD) { 
         fpmul_mont(x, (digit_t*)&Montgomery_R2, x);
@@ -1253,6 +1386,7 @@ void fpinv_mont_bingcd(digit_t* a)
     fpmul_mont(x, (digit_t*)&Montgomery_R2, x);
     power2_setup(t, 2*MAXBITS_FIELD - k, NWORDS_FIELD);
     fpmul_mont(x, t, a);
+    PROFILE_LEAVE();
 }
 
 
@@ -1261,6 +1395,7 @@ void fp2inv_mont_bingcd(f2elm_t a)
  // This uses the binary GCD for inversion in fp and is NOT constant time!!!
     f2elm_t t1;
 
+    PROFILE_ENTER(SIDH_OP_FP2INV_BINGCD);
     fpsqr_mont(a[0], t1[0]);             // t10 = a0^2
     fpsqr_mont(a[1], t1[1]);             // t11 = a1^2
     fpadd(t1[0], t1[1], t1[0]);          // t10 = a0^2+a1^2
@@ -1268,6 +1403,7 @@ void fp2inv_mont_bingcd(f2elm_t a)
     fpneg(a[1]);                         // a = a0-i*a1
     fpmul_mont(a[0], t1[0], a[0]);
     fpmul_mont(a[1], t1[0], a[1]);       // a = (a0-i*a1)*(a0^2+a1^2)^-1
+    PROFILE_LEAVE();
 }
 
 
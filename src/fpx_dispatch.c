@@ -0,0 +1,226 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: runtime selection of the x64 field multiplication kernels
+*
+* The kernel set is chosen once at load time from cpuid, so that the same library runs the portable
+* C code from fp_generic.c on any x64 processor and the MULX (BMI2) or MULX+ADX assembly where supported.
+* For p751 the assembly exists in MULX and MULX+ADX flavors and the dispatched functions are mp_mul
+* and rdc_mont. For the other primes the assembly requires MULX+ADX, and the dispatched functions
+* are the fused GF(p^2) multiplication/squaring halves and fpmul used by fpx.c.
+*
+* Requires: FP_MUL_GENERIC, FP_RDC_GENERIC and either FP_PRIMEx2 or, for p751, FP_MUL_MULX,
+*           FP_RDC_MULX, FP_MUL_ADX, FP_RDC_ADX.
+*********************************************************************************************/
+
+#include <cpuid.h>
+
+
+static int fpkernel_detect(void)
+{ // Best kernel supported by the processor. MULX is part of BMI2
+    unsigned int eax, ebx, ecx, edx;
+
+    if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) == 0 || (ebx & bit_BMI2) == 0) {
+        return FP_KERNEL_GENERIC;
+    }
+    if ((ebx & bit_ADX) == 0) {
+        return FP_KERNEL_MULX;
+    }
+    return FP_KERNEL_MULX_ADX;
+}
+
+
+#if (NBITS_FIELD == 751)
+
+typedef struct {
+    void (*mul)(const digit_t* a, const digit_t* b, digit_t* c, const unsigned int nwords);
+    void (*rdc)(digit_t* ma, digit_t* mc);
+} fpkernels_t;
+
+static const fpkernels_t fpkernels[3] = {
+    { FP_MUL_GENERIC, FP_RDC_GENERIC },               // FP_KERNEL_GENERIC
+    { FP_MUL_MULX,    FP_RDC_MULX },                  // FP_KERNEL_MULX
+    { FP_MUL_ADX,     FP_RDC_ADX }                    // FP_KERNEL_MULX_ADX
+};
+
+#else
+
+typedef struct {
+    void (*fp2mul_c0)(const digit_t* a, const digit_t* b, digit_t* c);
+    void (*fp2mul_c1)(const digit_t* a, const digit_t* b, digit_t* c);
+    void (*fp2sqr_c0)(const digit_t* a, digit_t* c);
+    void (*fp2sqr_c1)(const digit_t* a, digit_t* c);
+    void (*fpmul)(const digit_t* a, const digit_t* b, digit_t* c);
+} fpkernels_t;
+
+
+static void mp_add2x_generic(const digit_t* a, const digit_t* b, digit_t* c)
+{ // Double-length multiprecision addition, c = a+b
+    unsigned int i, carry = 0;
+
+    for (i = 0; i < 2*NWORDS_FIELD; i++) {
+        ADDC(carry, a[i], b[i], carry, c[i]);
+    }
+}
+
+
+static void mp_sub_p2_generic(const digit_t* a, const digit_t* b, digit_t* c)
+{ // Multiprecision subtraction with correction with 2*p, c = a-b+2p
+    unsigned int i, borrow = 0;
+
+    for (i = 0; i < NWORDS_FIELD; i++) {
+        SUBC(borrow, a[i], b[i], borrow, c[i]);
+    }
+    borrow = 0;
+    for (i = 0; i < NWORDS_FIELD; i++) {
+        ADDC(borrow, c[i], ((digit_t*)FP_PRIMEx2)[i], borrow, c[i]);
+    }
+}
+
+
+static void fpmul_generic(const digit_t* a, const digit_t* b, digit_t* c)
+{ // Field multiplication using Montgomery arithmetic, c = a*b*R^-1 mod p, with c in [0, 2*p-1]
+    dfelm_t tt;
+
+    FP_MUL_GENERIC(a, b, tt, NWORDS_FIELD);
+    FP_RDC_GENERIC(tt, c);
+}
+
+
+static void fp2mul_c0_generic(const digit_t* a, const digit_t* b, digit_t* c)
+{ // Non-complex part of the GF(p^2) multiplication, c = a0*b0 - a1*b1 = a0*b0 + a1*(2p-b1)
+    felm_t zero = {0}, t;
+    dfelm_t tt1, tt2;
+
+    mp_sub_p2_generic(zero, &b[NWORDS_FIELD], t);
+    FP_MUL_GENERIC(a, b, tt1, NWORDS_FIELD);
+    FP_MUL_GENERIC(&a[NWORDS_FIELD], t, tt2, NWORDS_FIELD);
+    mp_add2x_generic(tt1, tt2, tt1);
+    FP_RDC_GENERIC(tt1, c);
+}
+
+
+static void fp2mul_c1_generic(const digit_t* a, const digit_t* b, digit_t* c)
+{ // Complex part of the GF(p^2) multiplication, c = a0*b1 + a1*b0
+    dfelm_t tt1, tt2;
+
+    FP_MUL_GENERIC(a, &b[NWORDS_FIELD], tt1, NWORDS_FIELD);
+    FP_MUL_GENERIC(&a[NWORDS_FIELD], b, tt2, NWORDS_FIELD);
+    mp_add2x_generic(tt1, tt2, tt1);
+    FP_RDC_GENERIC(tt1, c);
+}
+
+
+static void fp2sqr_c0_generic(const digit_t* a, digit_t* c)
+{ // Non-complex part of the GF(p^2) squaring, c = (a0+a1)*(a0-a1+2p)
+    unsigned int i, carry = 0;
+    felm_t t1, t2;
+
+    for (i = 0; i < NWORDS_FIELD; i++) {
+        ADDC(carry, a[i], a[NWORDS_FIELD+i], carry, t1[i]);
+    }
+    mp_sub_p2_generic(a, &a[NWORDS_FIELD], t2);
+    fpmul_generic(t1, t2, c);
+}
+
+
+static void fp2sqr_c1_generic(const digit_t* a, digit_t* c)
+{ // Complex part of the GF(p^2) squaring, c = 2*a0*a1
+    unsigned int i, carry = 0;
+    felm_t t;
+
+    for (i = 0; i < NWORDS_FIELD; i++) {
+        ADDC(carry, a[i], a[i], carry, t[i]);
+    }
+    fpmul_generic(t, &a[NWORDS_FIELD], c);
+}
+
+
+static const fpkernels_t fpkernels[3] = {
+    { fp2mul_c0_generic, fp2mul_c1_generic, fp2sqr_c0_generic, fp2sqr_c1_generic, fpmul_generic },   // FP_KERNEL_GENERIC
+    { fp2mul_c0_generic, fp2mul_c1_generic, fp2sqr_c0_generic, fp2sqr_c1_generic, fpmul_generic },   // FP_KERNEL_MULX, no MULX-only assembly
+    { fp2mul_c0_asm,     fp2mul_c1_asm,     fp2sqr_c0_asm,     fp2sqr_c1_asm,     fpmul_asm }        // FP_KERNEL_MULX_ADX
+};
+
+#endif
+
+
+// Active kernel set. Starts on the portable code until fpkernel_init() has run at load time
+static const fpkernels_t* fpkernel_active = &fpkernels[FP_KERNEL_GENERIC];
+static int fpkernel_level = FP_KERNEL_GENERIC;
+
+
+__attribute__((constructor)) static void fpkernel_init(void)
+{
+    fpkernel_level = fpkernel_detect();
+    fpkernel_active = &fpkernels[fpkernel_level];
+}
+
+
+int fpkernel_get(void)
+{ // Returns the kernel currently in use, one of FP_KERNEL_GENERIC, FP_KERNEL_MULX or FP_KERNEL_MULX_ADX
+    return fpkernel_level;
+}
+
+
+int fpkernel_set(const int level)
+{ // Forces the use of a given kernel, e.g., for testing. Not thread-safe
+  // Returns 0 on success, or -1 if the kernel is not supported by the processor
+    if (level < FP_KERNEL_GENERIC || level > fpkernel_detect()) {
+        return -1;
+    }
+    fpkernel_level = level;
+    fpkernel_active = &fpkernels[level];
+    return 0;
+}
+
+
+#if (NBITS_FIELD == 751)
+
+void mp_mul(const digit_t* a, const digit_t* b, digit_t* c, const unsigned int nwords)
+{ // Multiprecision multiply, c = a*b, where lng(a) = lng(b) = nwords.
+    fpkernel_active->mul(a, b, c, nwords);
+}
+
+
+void rdc_mont(digit_t* ma, digit_t* mc)
+{ // Montgomery reduction, mc = ma*R^-1 mod p, with mc in [0, 2*p-1] for ma < R*p
+    fpkernel_active->rdc(ma, mc);
+}
+
+#else
+
+void fp2mul_c0_mont(const digit_t* a, const digit_t* b, digit_t* c)
+{
+    fpkernel_active->fp2mul_c0(a, b, c);
+}
+
+
+void fp2mul_c1_mont(const digit_t* a, const digit_t* b, digit_t* c)
+{
+    fpkernel_active->fp2mul_c1(a, b, c);
+}
+
+
+void fp2sqr_c0_mont(const digit_t* a, digit_t* c)
+{
+    fpkernel_active->fp2sqr_c0(a, c);
+}
+
+
+void fp2sqr_c1_mont(const digit_t* a, digit_t* c)
+{
+    fpkernel_active->fp2sqr_c1(a, c);
+}
+
+
+void fpmul(const digit_t* a, const digit_t* b, digit_t* c)
+{
+    fpkernel_active->fpmul(a, b, c);
+}
+
+#endif
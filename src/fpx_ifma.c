@@ -0,0 +1,219 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: 8-way GF(p^2) arithmetic using AVX-512 IFMA in radix 2^52
+*
+* Each 512-bit register holds the same 52-bit limb of eight independent field elements, so that
+* the eight multiplications run in lockstep using vpmadd52luq/vpmadd52huq. Inputs and outputs use
+* the library's representation, i.e., Montgomery form with R = 2^(64*NWORDS64_FIELD) and values in
+* [0, 2*p-1], so these functions are drop-in replacements for eight calls to fp2mul_mont/fp2sqr_mont.
+*
+* Requires: NLIMBS52 (number of 52-bit limbs of an element in [0, 4*p-1]) and PRIME_IFMA, PRIMEx2_IFMA.
+*********************************************************************************************/
+
+#include <immintrin.h>
+
+#define MASK52            0xFFFFFFFFFFFFFULL
+#define NRED52            ((64*NWORDS64_FIELD)/52)        // Number of full 52-bit Montgomery reduction steps
+#define NREM52            ((64*NWORDS64_FIELD)%52)        // Number of bits reduced by the final partial step
+#define NPROD52           (2*NLIMBS52+2)                  // Number of limbs of the accumulator
+
+
+static inline void to_radix52(const digit_t* a, uint64_t* r)
+{ // Conversion of a field element from 64-bit words to 52-bit limbs, r[8*k] = bits [52k, 52k+52) of a
+
+    for (unsigned int k = 0; k < NLIMBS52; k++) {
+        unsigned int w = (52*k) >> 6, s = (52*k) & 63;
+        uint64_t v = 0;
+
+        if (w < NWORDS64_FIELD) v = (uint64_t)a[w] >> s;
+        if (s > 12 && w+1 < NWORDS64_FIELD) v |= (uint64_t)a[w+1] << (64 - s);
+        r[8*k] = v & MASK52;
+    }
+}
+
+
+static inline void from_radix52(const uint64_t* r, digit_t* a)
+{ // Conversion of a field element from 52-bit limbs r[8*k] back to 64-bit words
+
+    for (unsigned int i = 0; i < NWORDS64_FIELD; i++) a[i] = 0;
+    for (unsigned int k = 0; k < NLIMBS52; k++) {
+        unsigned int w = (52*k) >> 6, s = (52*k) & 63;
+
+        if (w < NWORDS64_FIELD) a[w] |= (digit_t)(r[8*k] << s);
+        if (s > 12 && w+1 < NWORDS64_FIELD) a[w+1] |= (digit_t)(r[8*k] >> (64 - s));
+    }
+}
+
+
+static inline void load_x8(const f2elm_t* a, const unsigned int j, __m512i* A)
+{ // Loading coordinate j of eight GF(p^2) elements into vertical 52-bit limbs
+    uint64_t t[8*NLIMBS52] __attribute__((aligned(64)));
+
+    for (unsigned int i = 0; i < 8; i++) {
+        to_radix52(a[i][j], &t[i]);
+    }
+    for (unsigned int k = 0; k < NLIMBS52; k++) {
+        A[k] = _mm512_load_si512((const void*)&t[8*k]);
+    }
+}
+
+
+static inline void store_x8(const __m512i* A, const unsigned int j, f2elm_t* c)
+{ // Storing vertical 52-bit limbs into coordinate j of eight GF(p^2) elements
+    uint64_t t[8*NLIMBS52] __attribute__((aligned(64)));
+
+    for (unsigned int k = 0; k < NLIMBS52; k++) {
+        _mm512_store_si512((void*)&t[8*k], A[k]);
+    }
+    for (unsigned int i = 0; i < 8; i++) {
+        from_radix52(&t[i], c[i][j]);
+    }
+}
+
+
+static inline void load_const_x8(const uint64_t* a, __m512i* A)
+{ // Broadcasting a constant field element into vertical 52-bit limbs
+    uint64_t t[8*NLIMBS52];
+
+    to_radix52((const digit_t*)a, t);
+    for (unsigned int k = 0; k < NLIMBS52; k++) {
+        A[k] = _mm512_set1_epi64((long long)t[8*k]);
+    }
+}
+
+
+static inline void carry_x8(__m512i* A, const unsigned int first, const unsigned int last)
+{ // Carry propagation on limbs A[first..last], leaving limbs A[first..last-1] in [0, 2^52-1]
+  // Limbs may be negative, the carry is computed with an arithmetic shift
+    const __m512i mask = _mm512_set1_epi64((long long)MASK52);
+
+    for (unsigned int k = first; k < last; k++) {
+        A[k+1] = _mm512_add_epi64(A[k+1], _mm512_srai_epi64(A[k], 52));
+        A[k] = _mm512_and_si512(A[k], mask);
+    }
+}
+
+
+static inline void mul_acc_x8(const __m512i* A, const __m512i* B, __m512i* T)
+{ // Schoolbook multiplication with accumulation, T = T + A*B, with unnormalized limbs in T
+
+    for (unsigned int i = 0; i < NLIMBS52; i++) {
+        for (unsigned int j = 0; j < NLIMBS52; j++) {
+            T[i+j]   = _mm512_madd52lo_epu64(T[i+j],   A[i], B[j]);
+            T[i+j+1] = _mm512_madd52hi_epu64(T[i+j+1], A[i], B[j]);
+        }
+    }
+}
+
+
+static inline void rdc_x8(__m512i* T, const __m512i* P, __m512i* C)
+{ // Montgomery reduction, C = T*2^(-64*NWORDS64_FIELD) mod p, for T < 16*p^2. Output in [0, 2*p-1]
+  // Since p = -1 mod 2^52, the Montgomery quotient of each step is simply the lowest limb of T
+    const __m512i mask = _mm512_set1_epi64((long long)MASK52);
+    __m512i q;
+    unsigned int i, j;
+
+    for (i = 0; i < NRED52; i++) {
+        q = _mm512_and_si512(T[i], mask);
+        for (j = 0; j < NLIMBS52; j++) {
+            T[i+j]   = _mm512_madd52lo_epu64(T[i+j],   q, P[j]);
+            T[i+j+1] = _mm512_madd52hi_epu64(T[i+j+1], q, P[j]);
+        }
+        T[i+1] = _mm512_add_epi64(T[i+1], _mm512_srli_epi64(T[i], 52));
+    }
+
+#if (NREM52 != 0)
+    q = _mm512_and_si512(T[NRED52], _mm512_set1_epi64((long long)((1ULL << NREM52) - 1)));
+    for (j = 0; j < NLIMBS52; j++) {
+        T[NRED52+j]   = _mm512_madd52lo_epu64(T[NRED52+j],   q, P[j]);
+        T[NRED52+j+1] = _mm512_madd52hi_epu64(T[NRED52+j+1], q, P[j]);
+    }
+    carry_x8(T, NRED52, NPROD52-1);
+    for (j = 0; j < NLIMBS52; j++) {   // C = T >> NREM52
+        C[j] = _mm512_or_si512(_mm512_srli_epi64(T[NRED52+j], NREM52),
+                               _mm512_and_si512(_mm512_slli_epi64(T[NRED52+j+1], 52-NREM52), mask));
+    }
+#else
+    carry_x8(T, NRED52, NPROD52-1);
+    for (j = 0; j < NLIMBS52; j++) {
+        C[j] = T[NRED52+j];
+    }
+#endif
+}
+
+
+void fp2mul_mont_x8(const f2elm_t* a, const f2elm_t* b, f2elm_t* c)
+{ // 8-way GF(p^2) multiplication using Montgomery arithmetic, c[i] = a[i]*b[i] in GF(p^2) for i = 0..7
+  // Inputs: a[i] = a0+a1*i and b[i] = b0+b1*i, with coordinates in [0, 2*p-1]
+  // Output: c[i] = c0+c1*i, where c0 = a0*b0+a1*(2p-b1) and c1 = a0*b1+a1*b0, with coordinates in [0, 2*p-1]
+    __m512i A0[NLIMBS52], A1[NLIMBS52], B0[NLIMBS52], B1[NLIMBS52], P[NLIMBS52], P2[NLIMBS52];
+    __m512i T0[NPROD52], T1[NPROD52];
+    unsigned int k;
+
+    PROFILE_COUNT_N(SIDH_OP_FP2MUL, 8);
+    load_const_x8(PRIME_IFMA, P);
+    load_const_x8(PRIMEx2_IFMA, P2);
+    load_x8(a, 0, A0);
+    load_x8(a, 1, A1);
+    load_x8(b, 0, B0);
+    load_x8(b, 1, B1);
+    for (k = 0; k < NPROD52; k++) {
+        T0[k] = _mm512_setzero_si512();
+        T1[k] = _mm512_setzero_si512();
+    }
+
+    mul_acc_x8(A0, B1, T1);
+    mul_acc_x8(A1, B0, T1);                           // T1 = a0*b1+a1*b0 < 8*p^2
+    for (k = 0; k < NLIMBS52; k++) {
+        B1[k] = _mm512_sub_epi64(P2[k], B1[k]);       // B1 = 2p-b1 in (0, 2p]
+    }
+    carry_x8(B1, 0, NLIMBS52-1);
+    mul_acc_x8(A0, B0, T0);
+    mul_acc_x8(A1, B1, T0);                           // T0 = a0*b0+a1*(2p-b1) < 8*p^2
+
+    rdc_x8(T0, P, A0);
+    rdc_x8(T1, P, A1);
+    store_x8(A0, 0, c);
+    store_x8(A1, 1, c);
+}
+
+
+void fp2sqr_mont_x8(const f2elm_t* a, f2elm_t* c)
+{ // 8-way GF(p^2) squaring using Montgomery arithmetic, c[i] = a[i]^2 in GF(p^2) for i = 0..7
+  // Input:  a[i] = a0+a1*i, with coordinates in [0, 2*p-1]
+  // Output: c[i] = c0+c1*i, where c0 = (a0+a1)*(a0-a1+2p) and c1 = 2*a0*a1, with coordinates in [0, 2*p-1]
+    __m512i A0[NLIMBS52], A1[NLIMBS52], S[NLIMBS52], D[NLIMBS52], P[NLIMBS52], P2[NLIMBS52];
+    __m512i T0[NPROD52], T1[NPROD52];
+    unsigned int k;
+
+    PROFILE_COUNT_N(SIDH_OP_FP2SQR, 8);
+    load_const_x8(PRIME_IFMA, P);
+    load_const_x8(PRIMEx2_IFMA, P2);
+    load_x8(a, 0, A0);
+    load_x8(a, 1, A1);
+    for (k = 0; k < NPROD52; k++) {
+        T0[k] = _mm512_setzero_si512();
+        T1[k] = _mm512_setzero_si512();
+    }
+
+    for (k = 0; k < NLIMBS52; k++) {
+        S[k] = _mm512_add_epi64(A0[k], A1[k]);                          // S = a0+a1 < 4p
+        D[k] = _mm512_add_epi64(_mm512_sub_epi64(A0[k], A1[k]), P2[k]); // D = a0-a1+2p in (0, 4p)
+        A1[k] = _mm512_add_epi64(A1[k], A1[k]);                         // A1 = 2*a1 < 4p
+    }
+    carry_x8(S, 0, NLIMBS52-1);
+    carry_x8(D, 0, NLIMBS52-1);
+    carry_x8(A1, 0, NLIMBS52-1);
+    mul_acc_x8(S, D, T0);                             // T0 = (a0+a1)*(a0-a1+2p) < 16*p^2
+    mul_acc_x8(A0, A1, T1);                           // T1 = 2*a0*a1 < 8*p^2
+
+    rdc_x8(T0, P, A0);
+    rdc_x8(T1, P, A1);
+    store_x8(A0, 0, c);
+    store_x8(A1, 1, c);
+}
@@ -11,6 +11,8 @@
 #ifndef INTERNAL_H
 #define INTERNAL_H
 
+#include "profile.h"
+
 
 /**************** Function prototypes ****************/
 /************* Multiprecision functions **************/ 
@@ -48,6 +50,13 @@ void digit_x_digit(const digit_t a, const digit_t b, digit_t* c);
 // Multiprecision comba multiply, c = a*b, where lng(a) = lng(b) = nwords.
 void mp_mul(const digit_t* a, const digit_t* b, digit_t* c, const unsigned int nwords);
 
+#if defined(_DISPATCH_)
+// Field multiplication kernels selectable at runtime
+#define FP_KERNEL_GENERIC       0       // Portable C
+#define FP_KERNEL_MULX          1       // x64 assembly using MULX (BMI2)
+#define FP_KERNEL_MULX_ADX      2       // x64 assembly using MULX and ADX
+#endif
+
 /************ Montgomery reduction and conversion functions *************/
 
 // Montgomery reduction, c = a mod p
@@ -68,11 +77,17 @@ void from_fp2mont(const f2elm_t ma, f2elm_t c);
 // n-way Montgomery inversion
 void mont_n_way_inv(const f2elm_t* vec, const int n, f2elm_t* out);
 
+// n-way Montgomery inversion in constant time
+void mont_n_way_inv_ct(const f2elm_t* vec, const int n, f2elm_t* out);
+
 /************ Elliptic curve and isogeny functions *************/
 
 // Computes the j-invariant of a Montgomery curve with projective constant.
 void j_inv(const f2elm_t A, const f2elm_t C, f2elm_t jinv);
 
+// Computes the j-invariant of a Montgomery curve with projective constant as a fraction jnum/jden.
+void j_inv_proj(const f2elm_t A, const f2elm_t C, f2elm_t jnum, f2elm_t jden);
+
 // Simultaneous doubling and differential addition.
 void xDBLADD(point_proj_t P, point_proj_t Q, const f2elm_t XPQ, const f2elm_t ZPQ, const f2elm_t A24);
 
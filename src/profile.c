@@ -0,0 +1,81 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: operation counters of the profiling build (SIDH_PROFILE)
+*********************************************************************************************/
+
+#include <string.h>
+#include "profile.h"
+
+
+SIDH_TLS sidh_profile_t sidh_profile_counters;
+SIDH_TLS unsigned int sidh_profile_phase = SIDH_PHASE_OTHER, sidh_profile_depth = 0;
+
+static const char* const op_names[SIDH_PROFILE_OPS] = {
+    "fpadd", "fpsub", "fpmul", "fpsqr", "fpinv", "fpinv_bingcd",
+    "fp2add", "fp2sub", "fp2mul", "fp2sqr", "fp2inv", "fp2inv_bingcd"
+};
+
+static const char* const phase_names[SIDH_PROFILE_PHASES] = {
+    "other", "ladder", "traversal", "basis", "pairing", "dlog"
+};
+
+
+void sidh_profile_reset(void)
+{ // Resets the counters of the calling thread
+    memset(&sidh_profile_counters, 0, sizeof(sidh_profile_t));
+}
+
+
+void sidh_profile_get(sidh_profile_t* profile)
+{ // Copies the counters of the calling thread
+    memcpy(profile, &sidh_profile_counters, sizeof(sidh_profile_t));
+}
+
+
+const char* sidh_profile_op_name(unsigned int op)
+{
+    return (op < SIDH_PROFILE_OPS) ? op_names[op] : NULL;
+}
+
+
+const char* sidh_profile_phase_name(unsigned int phase)
+{
+    return (phase < SIDH_PROFILE_PHASES) ? phase_names[phase] : NULL;
+}
+
+
+static void write_counts(FILE* f, const uint64_t* count)
+{ // Writing of counts as a JSON object
+    unsigned int op;
+
+    fprintf(f, "{ ");
+    for (op = 0; op < SIDH_PROFILE_OPS; op++) {
+        fprintf(f, "\"%s\": %llu%s", op_names[op], (unsigned long long)count[op], (op == SIDH_PROFILE_OPS-1) ? " }" : ", ");
+    }
+}
+
+
+int sidh_profile_write_json(FILE* f, const sidh_profile_t* profile)
+{ // Writing of the counters in JSON format, per phase and in total
+    uint64_t total[SIDH_PROFILE_OPS] = {0};
+    unsigned int phase, op;
+
+    fprintf(f, "{\n  \"phases\": {\n");
+    for (phase = 0; phase < SIDH_PROFILE_PHASES; phase++) {
+        fprintf(f, "    \"%s\": ", phase_names[phase]);
+        write_counts(f, profile->count[phase]);
+        fprintf(f, "%s\n", (phase == SIDH_PROFILE_PHASES-1) ? "" : ",");
+        for (op = 0; op < SIDH_PROFILE_OPS; op++) {
+            total[op] += profile->count[phase][op];
+        }
+    }
+    fprintf(f, "  },\n  \"total\": ");
+    write_counts(f, total);
+    fprintf(f, "\n}\n");
+    return ferror(f) ? -1 : 0;
+}
@@ -0,0 +1,100 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: operation counters of the profiling build (SIDH_PROFILE)
+*
+* Calls to the GF(p) and GF(p^2) functions are counted per thread and per phase of the computation.
+* Only top-level calls are counted: the operations run inside a counted function (e.g., the
+* multiplications of an inversion, or the GF(p) operations of a GF(p^2) operation) are not, so
+* that the counts do not depend on the field backend. Operations run by the worker pool of the
+* SIDH_THREADS build are counted in the counters of the workers.
+*********************************************************************************************/
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+
+// Counted operations
+#define SIDH_OP_FPADD             0
+#define SIDH_OP_FPSUB             1
+#define SIDH_OP_FPMUL             2
+#define SIDH_OP_FPSQR             3
+#define SIDH_OP_FPINV             4       // Constant-time inversion
+#define SIDH_OP_FPINV_BINGCD      5       // Variable-time inversion
+#define SIDH_OP_FP2ADD            6
+#define SIDH_OP_FP2SUB            7
+#define SIDH_OP_FP2MUL            8
+#define SIDH_OP_FP2SQR            9
+#define SIDH_OP_FP2INV           10
+#define SIDH_OP_FP2INV_BINGCD    11
+#define SIDH_PROFILE_OPS         12
+
+// Phases
+#define SIDH_PHASE_OTHER          0
+#define SIDH_PHASE_LADDER         1       // Three-point ladders computing the kernel points
+#define SIDH_PHASE_TRAVERSAL      2       // Isogeny tree traversal
+#define SIDH_PHASE_BASIS          3       // Torsion basis generation with Elligator 2 (compression)
+#define SIDH_PHASE_PAIRING        4       // Tate pairings (compression)
+#define SIDH_PHASE_DLOG           5       // Discrete logarithms (compression)
+#define SIDH_PROFILE_PHASES       6
+
+typedef struct {
+    uint64_t count[SIDH_PROFILE_PHASES][SIDH_PROFILE_OPS];
+} sidh_profile_t;
+
+
+// Resets the counters of the calling thread
+void sidh_profile_reset(void);
+
+// Copies the counters of the calling thread
+void sidh_profile_get(sidh_profile_t* profile);
+
+// Names of the operations and phases, as used in the JSON output
+const char* sidh_profile_op_name(unsigned int op);
+const char* sidh_profile_phase_name(unsigned int phase);
+
+// Writing of the counters in JSON format, per phase and in total. Returns 0 on success
+int sidh_profile_write_json(FILE* f, const sidh_profile_t* profile);
+
+
+#if defined(SIDH_PROFILE)
+
+#if defined(_MSC_VER)
+    #define SIDH_TLS    __declspec(thread)
+#else
+    #define SIDH_TLS    _Thread_local
+#endif
+
+extern SIDH_TLS sidh_profile_t sidh_profile_counters;
+extern SIDH_TLS unsigned int sidh_profile_phase, sidh_profile_depth;
+
+// Counting of a call to operation op, or of n operations at once
+#define PROFILE_COUNT(op)            do { if (sidh_profile_depth == 0) sidh_profile_counters.count[sidh_profile_phase][op]++; } while (0)
+#define PROFILE_COUNT_N(op, n)       do { if (sidh_profile_depth == 0) sidh_profile_counters.count[sidh_profile_phase][op] += (n); } while (0)
+// Counting of a call to operation op, without counting the operations it runs until PROFILE_LEAVE()
+#define PROFILE_ENTER(op)            do { PROFILE_COUNT(op); sidh_profile_depth++; } while (0)
+#define PROFILE_LEAVE()              do { sidh_profile_depth--; } while (0)
+// Attribution of the operations to phase p until PROFILE_PHASE_END(), which restores the previous phase. At most once per block
+#define PROFILE_PHASE_BEGIN(p)       const unsigned int profile_phase_saved = sidh_profile_phase; sidh_profile_phase = (p)
+#define PROFILE_PHASE_END()          do { sidh_profile_phase = profile_phase_saved; } while (0)
+
+#else
+
+#define PROFILE_COUNT(op)
+#define PROFILE_COUNT_N(op, n)
+#define PROFILE_ENTER(op)
+#define PROFILE_LEAVE()
+#define PROFILE_PHASE_BEGIN(p)
+#define PROFILE_PHASE_END()
+
+#endif
+
+
+#endif
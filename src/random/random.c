@@ -1,23 +1,61 @@
 /********************************************************************************************
-* Hardware-based random number generation function
+* Random number generation function
 *
-* It uses /dev/urandom in Linux and CNG's BCryptGenRandom function in Windows
-*********************************************************************************************/ 
+* Every thread draws from its own SHAKE256-based generator with an output buffer. The generators
+* are seeded from getrandom() (or /dev/urandom) in Linux and CNG's BCryptGenRandom function in
+* Windows, or from a source set with randombytes_set_source(), and are reseeded after a fork
+*********************************************************************************************/
 
 #include "random.h"
+#include "../sha3/fips202.h"
 #include <stdlib.h>
+#include <string.h>
 #if defined(__WINDOWS__)
     #include <windows.h>
     #include <bcrypt.h>
+    #define THREAD_LOCAL                __declspec(thread)
+    static volatile long generation = 1;
+    #define GENERATION_LOAD()           generation
+    #define GENERATION_INCREMENT()      InterlockedIncrement(&generation)
 #elif defined(__NIX__)
     #include <unistd.h>
     #include <fcntl.h>
-    static int lock = -1;
+    #include <errno.h>
+    #include <pthread.h>
+    #include <stdatomic.h>
+    #if defined(__linux__)
+        #include <sys/syscall.h>
+    #endif
+    #define THREAD_LOCAL                __thread
+    static atomic_long generation = 1;
+    static atomic_int lock = -1;
+    static atomic_flag atfork_registered = ATOMIC_FLAG_INIT;
+    #define GENERATION_LOAD()           atomic_load_explicit(&generation, memory_order_acquire)
+    #define GENERATION_INCREMENT()      atomic_fetch_add_explicit(&generation, 1, memory_order_acq_rel)
 #endif
 
-#define passed 0 
+#define passed 0
 #define failed 1
 
+#define DRBG_KEY_BYTES       32                                      // Key of a generator, replaced at every refill
+#define DRBG_BUFFER_BYTES    (4*SHAKE256_RATE - DRBG_KEY_BYTES)      // Output bytes of a refill
+#define DRBG_RESEED_BYTES    (1 << 20)                               // Output bytes between two reseeds from the source
+
+typedef struct {
+    unsigned char key[DRBG_KEY_BYTES];
+    unsigned char buffer[DRBG_BUFFER_BYTES];
+    unsigned int available;                  // Number of unused bytes at the end of buffer
+    unsigned long long counter;              // Number of refills since the last reseed
+    unsigned long long output;               // Number of bytes output since the last reseed
+    long generation;                         // Value of generation at the last reseed, 0 if the generator is not seeded
+} drbg_state;
+
+static THREAD_LOCAL drbg_state drbg;
+
+static int os_entropy(void* ctx, unsigned char* random_array, unsigned long long nbytes);
+static randombytes_source_t source = os_entropy;
+static void* source_ctx = NULL;
+
 
 static inline void delay(unsigned int count)
 {
@@ -25,29 +63,55 @@ static inline void delay(unsigned int count)
 }
 
 
-int randombytes(unsigned char* random_array, unsigned long long nbytes)
-{ // Generation of "nbytes" of random values
-    
-#if defined(__WINDOWS__)   
+static void clear_bytes(void* mem, size_t nbytes)
+{ // Clear bytes from memory. The volatile type qualifier keeps the compiler from optimizing out the clearing.
+    volatile unsigned char *v = mem;
+
+    for (size_t i = 0; i < nbytes; i++)
+        v[i] = 0;
+}
+
+
+static int os_entropy(void* ctx, unsigned char* random_array, unsigned long long nbytes)
+{ // Generation of "nbytes" of random values by the operating system
+    (void)ctx;
+
+#if defined(__WINDOWS__)
     if (!BCRYPT_SUCCESS(BCryptGenRandom(NULL, random_array, (unsigned long)nbytes, BCRYPT_USE_SYSTEM_PREFERRED_RNG))) {
         return failed;
     }
 
 #elif defined(__NIX__)
-    int r, n = (int)nbytes, count = 0;
-    
-    if (lock == -1) {
+    int fd, expected = -1;
+    long r, n = (long)nbytes, count = 0;
+
+#if defined(__linux__) && defined(SYS_getrandom)
+    while (n > 0) {
+        r = syscall(SYS_getrandom, random_array+count, (size_t)n, 0);
+        if (r == -1) {
+            if (errno == EINTR) continue;
+            break;                           // Kernels older than 3.17, fall back to /dev/urandom
+        }
+        count += r;
+        n -= r;
+    }
+#endif
+
+    if (n > 0 && atomic_load(&lock) == -1) {
         do {
-            lock = open("/dev/urandom", O_RDONLY);
-            if (lock == -1) {
+            fd = open("/dev/urandom", O_RDONLY);
+            if (fd == -1) {
                 delay(0xFFFFF);
             }
-        } while (lock == -1);
+        } while (fd == -1);
+        if (!atomic_compare_exchange_strong(&lock, &expected, fd)) {
+            close(fd);                       // Opened concurrently by another thread
+        }
     }
 
     while (n > 0) {
         do {
-            r = read(lock, random_array+count, n);
+            r = read(atomic_load(&lock), random_array+count, (size_t)n);
             if (r == -1) {
                 delay(0xFFFF);
             }
@@ -58,4 +122,99 @@ int randombytes(unsigned char* random_array, unsigned long long nbytes)
 #endif
 
     return passed;
-}
\ No newline at end of file
+}
+
+
+#if defined(__NIX__)
+
+static void drbg_atfork_child(void)
+{ // Forces the generators of the child to reseed, so that it does not repeat the output of the parent
+    GENERATION_INCREMENT();
+}
+
+#endif
+
+
+static int drbg_reseed(long current)
+{ // Seeding of the generator of the calling thread with DRBG_KEY_BYTES bytes of the entropy source
+
+#if defined(__NIX__)
+    if (!atomic_flag_test_and_set(&atfork_registered)) {
+        pthread_atfork(NULL, NULL, drbg_atfork_child);
+    }
+#endif
+    if (source(source_ctx, drbg.key, DRBG_KEY_BYTES) != passed) {
+        memset(&drbg, 0, sizeof(drbg));
+        return failed;
+    }
+    memset(drbg.buffer, 0, DRBG_BUFFER_BYTES);
+    drbg.available = 0;
+    drbg.counter = 0;
+    drbg.output = 0;
+    drbg.generation = current;
+
+    return passed;
+}
+
+
+static void drbg_refill(void)
+{ // Refill of the output buffer: key || buffer <- SHAKE256(key || counter)
+    uint64_t s[25] = {0};
+    unsigned char input[DRBG_KEY_BYTES + 8], output[4*SHAKE256_RATE];
+    unsigned int i;
+
+    memcpy(input, drbg.key, DRBG_KEY_BYTES);
+    for (i = 0; i < 8; i++) {
+        input[DRBG_KEY_BYTES + i] = (unsigned char)(drbg.counter >> (8*i));
+    }
+    shake256_absorb(s, input, sizeof(input));
+    shake256_squeezeblocks(output, 4, s);
+
+    memcpy(drbg.key, output, DRBG_KEY_BYTES);
+    memcpy(drbg.buffer, output + DRBG_KEY_BYTES, DRBG_BUFFER_BYTES);
+    drbg.available = DRBG_BUFFER_BYTES;
+    drbg.counter++;
+
+    clear_bytes(input, sizeof(input));
+    clear_bytes(output, sizeof(output));
+    clear_bytes(s, sizeof(s));
+}
+
+
+int randombytes(unsigned char* random_array, unsigned long long nbytes)
+{ // Generation of "nbytes" of random values
+    unsigned long long n = nbytes, count = 0, len;
+    unsigned char* p;
+    long current = GENERATION_LOAD();
+
+    if (drbg.generation != current || drbg.output >= DRBG_RESEED_BYTES) {
+        if (drbg_reseed(current) != passed) {
+            return failed;
+        }
+    }
+
+    while (n > 0) {
+        if (drbg.available == 0) {
+            drbg_refill();
+        }
+        len = (n < drbg.available) ? n : drbg.available;
+        p = drbg.buffer + DRBG_BUFFER_BYTES - drbg.available;
+        memcpy(random_array+count, p, (size_t)len);
+        memset(p, 0, (size_t)len);           // Output bytes are not kept
+        drbg.available -= (unsigned int)len;
+        count += len;
+        n -= len;
+    }
+    drbg.output += nbytes;
+
+    return passed;
+}
+
+
+void randombytes_set_source(randombytes_source_t new_source, void* ctx)
+{ // Sets the entropy source of the generators, or the operating system if new_source is NULL
+
+    source = (new_source != NULL) ? new_source : os_entropy;
+    source_ctx = ctx;
+    GENERATION_INCREMENT();
+}
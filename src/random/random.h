@@ -2,8 +2,18 @@
 #define RANDOM_H
 
 
+// Entropy source of the random number generators: writes nbytes random bytes to random_array and returns 0, or returns 1 on failure
+typedef int (*randombytes_source_t)(void* ctx, unsigned char* random_array, unsigned long long nbytes);
+
 // Generate random bytes and output the result to random_array
+// Each thread uses its own generator, seeded from the entropy source on first use, every 2^20 output bytes, after a fork
+// and after a change of the source. Returns 0 on success, or 1 if the entropy source failed
 int randombytes(unsigned char* random_array, unsigned long long nbytes);
 
+// Sets the entropy source (and its argument ctx) of the generators of all threads, or restores the operating system source
+// if source is NULL. Every thread reseeds its generator from the new source before its next output.
+// It must not be called concurrently with randombytes
+void randombytes_set_source(randombytes_source_t source, void* ctx);
+
 
-#endif
\ No newline at end of file
+#endif
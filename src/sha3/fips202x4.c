@@ -0,0 +1,223 @@
+/********************************************************************************************
+* 4-way SHAKE256
+*
+* Computes four independent SHAKE256 instances in one pass. With AVX2, each 256-bit register 
+* holds the same lane of the four Keccak states, so that the four permutations run in lockstep.
+* Without AVX2, the four states are permuted one after the other with KeccakF1600_StatePermute.
+*
+* See NIST Special Publication 800-185 for more information:
+* http://nvlpubs.nist.gov/nistpubs/SpecialPublications/NIST.SP.800-185.pdf
+*
+*********************************************************************************************/  
+
+#include <stdint.h>
+#include <string.h>
+#include "fips202.h"
+#include "fips202x4.h"
+#include "../config.h"
+#if defined(__AVX2__)
+  #include <immintrin.h>
+#endif
+
+#define NROUNDS 24
+
+void KeccakF1600_StatePermute(uint64_t *state);
+
+
+#if defined(__AVX2__)
+
+static const uint64_t KeccakF_RoundConstants[NROUNDS] = 
+{
+    (uint64_t)0x0000000000000001ULL,
+    (uint64_t)0x0000000000008082ULL,
+    (uint64_t)0x800000000000808aULL,
+    (uint64_t)0x8000000080008000ULL,
+    (uint64_t)0x000000000000808bULL,
+    (uint64_t)0x0000000080000001ULL,
+    (uint64_t)0x8000000080008081ULL,
+    (uint64_t)0x8000000000008009ULL,
+    (uint64_t)0x000000000000008aULL,
+    (uint64_t)0x0000000000000088ULL,
+    (uint64_t)0x0000000080008009ULL,
+    (uint64_t)0x000000008000000aULL,
+    (uint64_t)0x000000008000808bULL,
+    (uint64_t)0x800000000000008bULL,
+    (uint64_t)0x8000000000008089ULL,
+    (uint64_t)0x8000000000008003ULL,
+    (uint64_t)0x8000000000008002ULL,
+    (uint64_t)0x8000000000000080ULL,
+    (uint64_t)0x000000000000800aULL,
+    (uint64_t)0x800000008000000aULL,
+    (uint64_t)0x8000000080008081ULL,
+    (uint64_t)0x8000000000008080ULL,
+    (uint64_t)0x0000000080000001ULL,
+    (uint64_t)0x8000000080008008ULL
+};
+
+#define ROL4X(a, offset) _mm256_or_si256(_mm256_slli_epi64(a, offset), _mm256_srli_epi64(a, 64-(offset)))
+#define XOR5(a, b, c, d, e) _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(a, b), _mm256_xor_si256(c, d)), e)
+
+
+void KeccakF1600_StatePermute4x(uint64_t *s)
+{
+  __m256i A[25], B[25], C0, C1, C2, C3, C4, D0, D1, D2, D3, D4;
+  unsigned int round, x;
+
+  for (x = 0; x < 25; x++)
+    A[x] = _mm256_loadu_si256((const __m256i*)&s[4*x]);
+
+  for (round = 0; round < NROUNDS; round++)
+  {
+    // Theta
+    C0 = XOR5(A[0], A[5], A[10], A[15], A[20]);
+    C1 = XOR5(A[1], A[6], A[11], A[16], A[21]);
+    C2 = XOR5(A[2], A[7], A[12], A[17], A[22]);
+    C3 = XOR5(A[3], A[8], A[13], A[18], A[23]);
+    C4 = XOR5(A[4], A[9], A[14], A[19], A[24]);
+    D0 = _mm256_xor_si256(C4, ROL4X(C1, 1));
+    D1 = _mm256_xor_si256(C0, ROL4X(C2, 1));
+    D2 = _mm256_xor_si256(C1, ROL4X(C3, 1));
+    D3 = _mm256_xor_si256(C2, ROL4X(C4, 1));
+    D4 = _mm256_xor_si256(C3, ROL4X(C0, 1));
+
+    // Rho and pi
+    B[ 0] = _mm256_xor_si256(A[ 0], D0);
+    B[10] = ROL4X(_mm256_xor_si256(A[ 1], D1), 1);
+    B[20] = ROL4X(_mm256_xor_si256(A[ 2], D2), 62);
+    B[ 5] = ROL4X(_mm256_xor_si256(A[ 3], D3), 28);
+    B[15] = ROL4X(_mm256_xor_si256(A[ 4], D4), 27);
+    B[16] = ROL4X(_mm256_xor_si256(A[ 5], D0), 36);
+    B[ 1] = ROL4X(_mm256_xor_si256(A[ 6], D1), 44);
+    B[11] = ROL4X(_mm256_xor_si256(A[ 7], D2), 6);
+    B[21] = ROL4X(_mm256_xor_si256(A[ 8], D3), 55);
+    B[ 6] = ROL4X(_mm256_xor_si256(A[ 9], D4), 20);
+    B[ 7] = ROL4X(_mm256_xor_si256(A[10], D0), 3);
+    B[17] = ROL4X(_mm256_xor_si256(A[11], D1), 10);
+    B[ 2] = ROL4X(_mm256_xor_si256(A[12], D2), 43);
+    B[12] = ROL4X(_mm256_xor_si256(A[13], D3), 25);
+    B[22] = ROL4X(_mm256_xor_si256(A[14], D4), 39);
+    B[23] = ROL4X(_mm256_xor_si256(A[15], D0), 41);
+    B[ 8] = ROL4X(_mm256_xor_si256(A[16], D1), 45);
+    B[18] = ROL4X(_mm256_xor_si256(A[17], D2), 15);
+    B[ 3] = ROL4X(_mm256_xor_si256(A[18], D3), 21);
+    B[13] = ROL4X(_mm256_xor_si256(A[19], D4), 8);
+    B[14] = ROL4X(_mm256_xor_si256(A[20], D0), 18);
+    B[24] = ROL4X(_mm256_xor_si256(A[21], D1), 2);
+    B[ 9] = ROL4X(_mm256_xor_si256(A[22], D2), 61);
+    B[19] = ROL4X(_mm256_xor_si256(A[23], D3), 56);
+    B[ 4] = ROL4X(_mm256_xor_si256(A[24], D4), 14);
+
+    // Chi
+    A[ 0] = _mm256_xor_si256(B[ 0], _mm256_andnot_si256(B[ 1], B[ 2]));
+    A[ 1] = _mm256_xor_si256(B[ 1], _mm256_andnot_si256(B[ 2], B[ 3]));
+    A[ 2] = _mm256_xor_si256(B[ 2], _mm256_andnot_si256(B[ 3], B[ 4]));
+    A[ 3] = _mm256_xor_si256(B[ 3], _mm256_andnot_si256(B[ 4], B[ 0]));
+    A[ 4] = _mm256_xor_si256(B[ 4], _mm256_andnot_si256(B[ 0], B[ 1]));
+    A[ 5] = _mm256_xor_si256(B[ 5], _mm256_andnot_si256(B[ 6], B[ 7]));
+    A[ 6] = _mm256_xor_si256(B[ 6], _mm256_andnot_si256(B[ 7], B[ 8]));
+    A[ 7] = _mm256_xor_si256(B[ 7], _mm256_andnot_si256(B[ 8], B[ 9]));
+    A[ 8] = _mm256_xor_si256(B[ 8], _mm256_andnot_si256(B[ 9], B[ 5]));
+    A[ 9] = _mm256_xor_si256(B[ 9], _mm256_andnot_si256(B[ 5], B[ 6]));
+    A[10] = _mm256_xor_si256(B[10], _mm256_andnot_si256(B[11], B[12]));
+    A[11] = _mm256_xor_si256(B[11], _mm256_andnot_si256(B[12], B[13]));
+    A[12] = _mm256_xor_si256(B[12], _mm256_andnot_si256(B[13], B[14]));
+    A[13] = _mm256_xor_si256(B[13], _mm256_andnot_si256(B[14], B[10]));
+    A[14] = _mm256_xor_si256(B[14], _mm256_andnot_si256(B[10], B[11]));
+    A[15] = _mm256_xor_si256(B[15], _mm256_andnot_si256(B[16], B[17]));
+    A[16] = _mm256_xor_si256(B[16], _mm256_andnot_si256(B[17], B[18]));
+    A[17] = _mm256_xor_si256(B[17], _mm256_andnot_si256(B[18], B[19]));
+    A[18] = _mm256_xor_si256(B[18], _mm256_andnot_si256(B[19], B[15]));
+    A[19] = _mm256_xor_si256(B[19], _mm256_andnot_si256(B[15], B[16]));
+    A[20] = _mm256_xor_si256(B[20], _mm256_andnot_si256(B[21], B[22]));
+    A[21] = _mm256_xor_si256(B[21], _mm256_andnot_si256(B[22], B[23]));
+    A[22] = _mm256_xor_si256(B[22], _mm256_andnot_si256(B[23], B[24]));
+    A[23] = _mm256_xor_si256(B[23], _mm256_andnot_si256(B[24], B[20]));
+    A[24] = _mm256_xor_si256(B[24], _mm256_andnot_si256(B[20], B[21]));
+
+    // Iota
+    A[0] = _mm256_xor_si256(A[0], _mm256_set1_epi64x((long long)KeccakF_RoundConstants[round]));
+  }
+
+  for (x = 0; x < 25; x++)
+    _mm256_storeu_si256((__m256i*)&s[4*x], A[x]);
+}
+
+#else
+
+void KeccakF1600_StatePermute4x(uint64_t *s)
+{
+  uint64_t t[25];
+  unsigned int i, j;
+
+  for (j = 0; j < 4; j++)
+  {
+    for (i = 0; i < 25; i++)
+      t[i] = s[4*i+j];
+    KeccakF1600_StatePermute(t);
+    for (i = 0; i < 25; i++)
+      s[4*i+j] = t[i];
+  }
+}
+
+#endif
+
+
+static uint64_t load64(const unsigned char *x)
+{
+  uint64_t u;
+
+  memcpy(&u, x, 8);
+  return LETOH_64(u);
+}
+
+
+static void store64(uint8_t *x, uint64_t u)
+{
+  u = HTOLE_64(u);
+  memcpy(x, &u, 8);
+}
+
+
+void shake256x4(unsigned char *out0, unsigned char *out1, unsigned char *out2, unsigned char *out3, unsigned long long outlen,
+                const unsigned char *in0, const unsigned char *in1, const unsigned char *in2, const unsigned char *in3, unsigned long long inlen)
+{
+  uint64_t s[4*25] = {0};
+  unsigned char t[4][SHAKE256_RATE];
+  const unsigned char *in[4] = {in0, in1, in2, in3};
+  unsigned char *out[4] = {out0, out1, out2, out3};
+  unsigned long long pos = 0, len;
+  unsigned int i, j;
+
+  /* Absorb input */
+  while (inlen - pos >= SHAKE256_RATE) 
+  {
+    for (i = 0; i < SHAKE256_RATE/8; i++)
+      for (j = 0; j < 4; j++)
+        s[4*i+j] ^= load64(in[j] + pos + 8*i);
+    KeccakF1600_StatePermute4x(s);
+    pos += SHAKE256_RATE;
+  }
+
+  for (j = 0; j < 4; j++) 
+  {
+    memset(t[j], 0, SHAKE256_RATE);
+    memcpy(t[j], in[j] + pos, inlen - pos);
+    t[j][inlen - pos] = 0x1F;
+    t[j][SHAKE256_RATE - 1] |= 128;
+  }
+  for (i = 0; i < SHAKE256_RATE/8; i++)
+    for (j = 0; j < 4; j++)
+      s[4*i+j] ^= load64(t[j] + 8*i);
+
+  /* Squeeze output */
+  for (pos = 0; pos < outlen; pos += len)
+  {
+    KeccakF1600_StatePermute4x(s);
+    for (i = 0; i < SHAKE256_RATE/8; i++)
+      for (j = 0; j < 4; j++)
+        store64(t[j] + 8*i, s[4*i+j]);
+    len = (outlen - pos < SHAKE256_RATE) ? (outlen - pos) : SHAKE256_RATE;
+    for (j = 0; j < 4; j++)
+      memcpy(out[j] + pos, t[j], len);
+  }
+}
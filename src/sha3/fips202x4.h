@@ -0,0 +1,15 @@
+#ifndef FIPS202X4_H
+#define FIPS202X4_H
+
+#include <stdint.h>
+
+
+// Four Keccak-f[1600] states interleaved by lanes, i.e., word i of state j is s[4*i+j]
+void KeccakF1600_StatePermute4x(uint64_t *s);
+
+// SHAKE256 of four independent inputs of the same length inlen, producing four outputs of outlen bytes
+void shake256x4(unsigned char *out0, unsigned char *out1, unsigned char *out2, unsigned char *out3, unsigned long long outlen,
+                const unsigned char *in0, const unsigned char *in1, const unsigned char *in2, const unsigned char *in3, unsigned long long inlen);
+
+
+#endif
@@ -8,7 +8,11 @@
 * Abstract: ephemeral supersingular isogeny Diffie-Hellman key exchange (SIDH)
 *********************************************************************************************/ 
 
+#include <string.h>
 #include "random/random.h"
+#if defined(SIDH_THREADS)
+    #include "threads/threadpool.h"
+#endif
 
 
 static void init_basis(digit_t *gen, f2elm_t XP, f2elm_t XQ, f2elm_t XR)
@@ -41,18 +45,127 @@ void random_mod_order_B(unsigned char* random_digits)
 }
 
 
-int EphemeralKeyGeneration_A(const unsigned char* PrivateKeyA, unsigned char* PublicKeyA)
-{ // Alice's ephemeral public key generation
-  // Input:  a private key PrivateKeyA in the range [0, 2^eA - 1]. 
-  // Output: the public key PublicKeyA consisting of 3 elements in GF(p^2) which are encoded by removing leading 0 bytes.
-    point_proj_t R, phiP = {0}, phiQ = {0}, phiR = {0}, pts[MAX_INT_POINTS_ALICE];
-    f2elm_t XPA, XQA, XRA, coeff[3], A24plus = {0}, C24 = {0}, A = {0};
+// Strategies in use for the isogeny tree traversal, either the built-in ones or those set by sidh_load_strategies()
+static const unsigned int* strat_Alice_active = strat_Alice;
+static const unsigned int* strat_Bob_active = strat_Bob;
+static unsigned int strat_Alice_loaded[MAX_Alice-1], strat_Bob_loaded[MAX_Bob-1];
+
+
+static int strategy_check(const unsigned int* strat, const unsigned int max, const unsigned int max_pts)
+{ // Checks that a strategy is valid for the tree traversal over max-1 rows with at most max_pts intermediate points, 
+  // i.e., that every row ends on a point of the right order and that exactly max-1 entries are consumed. Returns 0 if valid
+    unsigned int row, m, index = 0, pts_index[MAX_INT_POINTS_ALICE > MAX_INT_POINTS_BOB ? MAX_INT_POINTS_ALICE : MAX_INT_POINTS_BOB], npts = 0, ii = 0;
+
+    for (row = 1; row < max; row++) {
+        while (index < max-row) {
+            if (npts == max_pts || ii == max-1) return -1;
+            pts_index[npts++] = index;
+            m = strat[ii++];
+            if (m == 0) return -1;
+            index += m;
+        }
+        if (index != max-row || npts == 0) return -1;
+        index = pts_index[npts-1];
+        npts -= 1;
+    }
+    return (ii == max-1) ? 0 : -1;
+}
+
+
+int sidh_load_strategies(const unsigned int* strat_A, const unsigned int* strat_B)
+{ // Loading of alternative strategies for Alice's and Bob's isogeny tree traversal, e.g., tuned for a number of threads
+  // Inputs: strategies strat_A and strat_B with MAX_Alice-1 and MAX_Bob-1 entries, or NULL to restore the built-in ones.
+  // Returns 0 on success, or -1 if a strategy is not valid, in which case the strategies in use are left unchanged.
+  // Not thread-safe, to be called at initialization
+    if ((strat_A != NULL && strategy_check(strat_A, MAX_Alice, MAX_INT_POINTS_ALICE) != 0) ||
+        (strat_B != NULL && strategy_check(strat_B, MAX_Bob, MAX_INT_POINTS_BOB) != 0)) {
+        return -1;
+    }
+
+    if (strat_A == NULL) {
+        strat_Alice_active = strat_Alice;
+    } else {
+        memcpy(strat_Alice_loaded, strat_A, sizeof(strat_Alice_loaded));
+        strat_Alice_active = strat_Alice_loaded;
+    }
+    if (strat_B == NULL) {
+        strat_Bob_active = strat_Bob;
+    } else {
+        memcpy(strat_Bob_loaded, strat_B, sizeof(strat_Bob_loaded));
+        strat_Bob_active = strat_Bob_loaded;
+    }
+    return 0;
+}
+
+
+#if defined(SIDH_THREADS)
+
+#define MAX_JOB_POINTS    ((MAX_INT_POINTS_ALICE > MAX_INT_POINTS_BOB ? MAX_INT_POINTS_ALICE : MAX_INT_POINTS_BOB) + 3)
+
+typedef struct {
+    point_proj* pts[MAX_JOB_POINTS];
+    f2elm_t coeff[3];
+    unsigned int npts;
+} isog_job_t;
+
+
+static void isog_job_load(isog_job_t* job, point_proj_t* pts, const unsigned int npts, point_proj_t phiP, point_proj_t phiQ, point_proj_t phiR, const f2elm_t* coeff, const unsigned int ncoeff)
+{ // Lists the intermediate points pts[0..npts-1] and the images phiP, phiQ, phiR to be evaluated by the workers
+  // The isogeny coefficients are copied since the main thread computes the next isogeny while the job is in flight
+    unsigned int i;
+
+    for (i = 0; i < npts; i++) {
+        job->pts[i] = pts[i];
+    }
+    job->pts[npts] = phiP;
+    job->pts[npts+1] = phiQ;
+    job->pts[npts+2] = phiR;
+    job->npts = npts + 3;
+    for (i = 0; i < ncoeff; i++) {
+        fp2copy(coeff[i], job->coeff[i]);
+    }
+}
+
+
+static void eval_4_isog_job(void* arg, unsigned int part, unsigned int nparts)
+{ // Evaluates the share of points of one worker at a 4-isogeny
+    isog_job_t* job = (isog_job_t*)arg;
+
+    for (unsigned int i = part; i < job->npts; i += nparts) {
+        eval_4_isog(job->pts[i], job->coeff);
+    }
+}
+
+
+static void eval_3_isog_job(void* arg, unsigned int part, unsigned int nparts)
+{ // Evaluates the share of points of one worker at a 3-isogeny
+    isog_job_t* job = (isog_job_t*)arg;
+
+    for (unsigned int i = part; i < job->npts; i += nparts) {
+        eval_3_isog(job->pts[i], (const f2elm_t*)job->coeff);
+    }
+}
+
+#endif
+
+
+static void KeyGeneration_A_walk(point_proj_t R, point_proj_t phiP, point_proj_t phiQ, point_proj_t phiR)
+{ // Alice's isogeny walk for public key generation from the kernel point, without the final normalization
+  // Input:  the kernel point R = PA + sk*QA of a private key sk (overwritten). 
+  // Output: the images phiP, phiQ and phiR of Bob's basis in projective coordinates.
+    point_proj_t pts[MAX_INT_POINTS_ALICE];
+    f2elm_t coeff[3], A24plus = {0}, C24 = {0};
     unsigned int i, row, m, index = 0, pts_index[MAX_INT_POINTS_ALICE], npts = 0, ii = 0;
-    digit_t SecretKeyA[NWORDS_ORDER] = {0};
+#if defined(SIDH_THREADS)
+    isog_job_t job;
+    unsigned int nworkers;
+#endif
 
     // Initialize basis points
-    init_basis((digit_t*)A_gen, XPA, XQA, XRA);
     init_basis((digit_t*)B_gen, phiP->X, phiQ->X, phiR->X);
+    fp2zero(phiP->Z);
+    fp2zero(phiQ->Z);
+    fp2zero(phiR->Z);
     fpcopy((digit_t*)&Montgomery_one, (phiP->Z)[0]);
     fpcopy((digit_t*)&Montgomery_one, (phiQ->Z)[0]);
     fpcopy((digit_t*)&Montgomery_one, (phiR->Z)[0]);
@@ -61,12 +174,8 @@ int EphemeralKeyGeneration_A(const unsigned char* PrivateKeyA, unsigned char* Pu
     fpcopy((digit_t*)&Montgomery_one, A24plus[0]);
     mp2_add(A24plus, A24plus, A24plus);
     mp2_add(A24plus, A24plus, C24);
-    mp2_add(A24plus, C24, A);
     mp2_add(C24, C24, A24plus);
-
-    // Retrieve kernel point
-    decode_to_digits(PrivateKeyA, SecretKeyA, SECRETKEY_A_BYTES, NWORDS_ORDER);
-    LADDER3PT(XPA, XQA, XRA, SecretKeyA, ALICE, R, A);       
+    PROFILE_PHASE_BEGIN(SIDH_PHASE_TRAVERSAL);
 
 #if (OALICE_BITS % 2 == 1)
     point_proj_t S;
@@ -80,35 +189,95 @@ int EphemeralKeyGeneration_A(const unsigned char* PrivateKeyA, unsigned char* Pu
 #endif
 
     // Traverse tree
+#if defined(SIDH_THREADS)
+    nworkers = sidh_pool_acquire();
+#endif
     index = 0;        
     for (row = 1; row < MAX_Alice; row++) {
         while (index < MAX_Alice-row) {
             fp2copy(R->X, pts[npts]->X);
             fp2copy(R->Z, pts[npts]->Z);
             pts_index[npts++] = index;
-            m = strat_Alice[ii++];
+            m = strat_Alice_active[ii++];
             xDBLe(R, R, A24plus, C24, (int)(2*m));
             index += m;
         }
         get_4_isog(R, A24plus, C24, coeff);        
 
-        for (i = 0; i < npts; i++) {
-            eval_4_isog(pts[i], coeff);
+#if defined(SIDH_THREADS)
+        if (nworkers != 0) {
+            // The workers evaluate the remaining points while the next doubling chain runs from the last point
+            sidh_pool_wait();
+            eval_4_isog(pts[npts-1], coeff);
+            isog_job_load(&job, pts, npts-1, phiP, phiQ, phiR, (const f2elm_t*)coeff, 3);
+            sidh_pool_post(eval_4_isog_job, &job);
+        } else
+#endif
+        {
+            for (i = 0; i < npts; i++) {
+                eval_4_isog(pts[i], coeff);
+            }
+            eval_4_isog(phiP, coeff);
+            eval_4_isog(phiQ, coeff);
+            eval_4_isog(phiR, coeff);
         }
-        eval_4_isog(phiP, coeff);
-        eval_4_isog(phiQ, coeff);
-        eval_4_isog(phiR, coeff);
 
         fp2copy(pts[npts-1]->X, R->X); 
         fp2copy(pts[npts-1]->Z, R->Z);
         index = pts_index[npts-1];
         npts -= 1;
     }
+#if defined(SIDH_THREADS)
+    if (nworkers != 0) {
+        sidh_pool_wait();
+        sidh_pool_release();
+    }
+#endif
 
     get_4_isog(R, A24plus, C24, coeff); 
     eval_4_isog(phiP, coeff);
     eval_4_isog(phiQ, coeff);
     eval_4_isog(phiR, coeff);
+    PROFILE_PHASE_END();
+}
+
+
+static void KeyGeneration_A_proj(const unsigned char* PrivateKeyA, point_proj_t phiP, point_proj_t phiQ, point_proj_t phiR)
+{ // Alice's isogeny walk for public key generation, without the final normalization
+  // Input:  a private key PrivateKeyA in the range [0, 2^eA - 1]. 
+  // Output: the images phiP, phiQ and phiR of Bob's basis in projective coordinates.
+    point_proj_t R;
+    digit_t SecretKeyA[NWORDS_ORDER] = {0};
+#if defined(SIDH_FIXED_BASE)
+
+    // Retrieve kernel point from the precomputed multiples of Alice's generator
+    decode_to_digits(PrivateKeyA, SecretKeyA, SECRETKEY_A_BYTES, NWORDS_ORDER);
+    LADDER3PT_fixed((digit_t*)A_gen, (digit_t*)A_gen_dbl, SecretKeyA, ALICE, &R, 1);
+#else
+    f2elm_t XPA, XQA, XRA, A = {0}, two = {0};
+
+    // Initialize basis points and the constant A = 6
+    init_basis((digit_t*)A_gen, XPA, XQA, XRA);
+    fpcopy((digit_t*)&Montgomery_one, two[0]);
+    mp2_add(two, two, two);
+    mp2_add(two, two, A);
+    mp2_add(two, A, A);
+
+    // Retrieve kernel point
+    decode_to_digits(PrivateKeyA, SecretKeyA, SECRETKEY_A_BYTES, NWORDS_ORDER);
+    LADDER3PT(XPA, XQA, XRA, SecretKeyA, ALICE, R, A);       
+#endif
+    KeyGeneration_A_walk(R, phiP, phiQ, phiR);
+}
+
+
+int EphemeralKeyGeneration_A(const unsigned char* PrivateKeyA, unsigned char* PublicKeyA)
+{ // Alice's ephemeral public key generation
+  // Input:  a private key PrivateKeyA in the range [0, 2^eA - 1]. 
+  // Output: the public key PublicKeyA consisting of 3 elements in GF(p^2) which are encoded by removing leading 0 bytes.
+    point_proj_t phiP, phiQ, phiR;
+
+    KeyGeneration_A_proj(PrivateKeyA, phiP, phiQ, phiR);
 
     inv_3_way(phiP->Z, phiQ->Z, phiR->Z);
     fp2mul_mont(phiP->X, phiP->Z, phiP->X);
@@ -129,12 +298,18 @@ int EphemeralKeyGeneration_B(const unsigned char* PrivateKeyB, unsigned char* Pu
   // Input:  a private key PrivateKeyB in the range [0, 2^Floor(Log(2,oB)) - 1]. 
   // Output: the public key PublicKeyB consisting of 3 elements in GF(p^2) which are encoded by removing leading 0 bytes.
     point_proj_t R, phiP = {0}, phiQ = {0}, phiR = {0}, pts[MAX_INT_POINTS_BOB];
-    f2elm_t XPB, XQB, XRB, coeff[3], A24plus = {0}, A24minus = {0}, A = {0};
+    f2elm_t coeff[3], A24plus = {0}, A24minus = {0};
+#if !defined(SIDH_FIXED_BASE)
+    f2elm_t XPB, XQB, XRB, A = {0};
+#endif
     unsigned int i, row, m, index = 0, pts_index[MAX_INT_POINTS_BOB], npts = 0, ii = 0;
     digit_t SecretKeyB[NWORDS_ORDER] = {0};
+#if defined(SIDH_THREADS)
+    isog_job_t job;
+    unsigned int nworkers;
+#endif
 
     // Initialize basis points
-    init_basis((digit_t*)B_gen, XPB, XQB, XRB);
     init_basis((digit_t*)A_gen, phiP->X, phiQ->X, phiR->X);
     fpcopy((digit_t*)&Montgomery_one, (phiP->Z)[0]);
     fpcopy((digit_t*)&Montgomery_one, (phiQ->Z)[0]);
@@ -144,43 +319,72 @@ int EphemeralKeyGeneration_B(const unsigned char* PrivateKeyB, unsigned char* Pu
     fpcopy((digit_t*)&Montgomery_one, A24plus[0]);
     mp2_add(A24plus, A24plus, A24plus);
     mp2_add(A24plus, A24plus, A24minus);
+#if !defined(SIDH_FIXED_BASE)
     mp2_add(A24plus, A24minus, A);
+#endif
     mp2_add(A24minus, A24minus, A24plus);
 
     // Retrieve kernel point
     decode_to_digits(PrivateKeyB, SecretKeyB, SECRETKEY_B_BYTES, NWORDS_ORDER);
+#if defined(SIDH_FIXED_BASE)
+    LADDER3PT_fixed((digit_t*)B_gen, (digit_t*)B_gen_dbl, SecretKeyB, BOB, &R, 1);
+#else
+    init_basis((digit_t*)B_gen, XPB, XQB, XRB);
     LADDER3PT(XPB, XQB, XRB, SecretKeyB, BOB, R, A);
+#endif
+    PROFILE_PHASE_BEGIN(SIDH_PHASE_TRAVERSAL);
     
     // Traverse tree
+#if defined(SIDH_THREADS)
+    nworkers = sidh_pool_acquire();
+#endif
     index = 0;  
     for (row = 1; row < MAX_Bob; row++) {
         while (index < MAX_Bob-row) {
             fp2copy(R->X, pts[npts]->X);
             fp2copy(R->Z, pts[npts]->Z);
             pts_index[npts++] = index;
-            m = strat_Bob[ii++];
+            m = strat_Bob_active[ii++];
             xTPLe(R, R, A24minus, A24plus, (int)m);
             index += m;
         } 
         get_3_isog(R, A24minus, A24plus, coeff);
 
-        for (i = 0; i < npts; i++) {
-            eval_3_isog(pts[i], coeff);
-        }     
-        eval_3_isog(phiP, coeff);
-        eval_3_isog(phiQ, coeff);
-        eval_3_isog(phiR, coeff);
+#if defined(SIDH_THREADS)
+        if (nworkers != 0) {
+            // The workers evaluate the remaining points while the next tripling chain runs from the last point
+            sidh_pool_wait();
+            eval_3_isog(pts[npts-1], coeff);
+            isog_job_load(&job, pts, npts-1, phiP, phiQ, phiR, (const f2elm_t*)coeff, 2);
+            sidh_pool_post(eval_3_isog_job, &job);
+        } else
+#endif
+        {
+            for (i = 0; i < npts; i++) {
+                eval_3_isog(pts[i], coeff);
+            }     
+            eval_3_isog(phiP, coeff);
+            eval_3_isog(phiQ, coeff);
+            eval_3_isog(phiR, coeff);
+        }
 
         fp2copy(pts[npts-1]->X, R->X); 
         fp2copy(pts[npts-1]->Z, R->Z);
         index = pts_index[npts-1];
         npts -= 1;
     }
+#if defined(SIDH_THREADS)
+    if (nworkers != 0) {
+        sidh_pool_wait();
+        sidh_pool_release();
+    }
+#endif
     
     get_3_isog(R, A24minus, A24plus, coeff);
     eval_3_isog(phiP, coeff);
     eval_3_isog(phiQ, coeff);
     eval_3_isog(phiR, coeff);
+    PROFILE_PHASE_END();
 
     inv_3_way(phiP->Z, phiQ->Z, phiR->Z);
     fp2mul_mont(phiP->X, phiP->Z, phiP->X);
@@ -196,32 +400,46 @@ int EphemeralKeyGeneration_B(const unsigned char* PrivateKeyB, unsigned char* Pu
 }
 
 
-int EphemeralSecretAgreement_A(const unsigned char* PrivateKeyA, const unsigned char* PublicKeyB, unsigned char* SharedSecretA)
-{ // Alice's ephemeral shared secret computation
-  // It produces a shared secret key SharedSecretA using her secret key PrivateKeyA and Bob's public key PublicKeyB
-  // Inputs: Alice's PrivateKeyA is an integer in the range [0, oA-1]. 
-  //         Bob's PublicKeyB consists of 3 elements in GF(p^2) encoded by removing leading 0 bytes.
-  // Output: a shared secret SharedSecretA that consists of one element in GF(p^2) encoded by removing leading 0 bytes.  
-    point_proj_t R, pts[MAX_INT_POINTS_ALICE];
-    f2elm_t coeff[3], PKB[3], jinv;
-    f2elm_t A24plus = {0}, C24 = {0}, A = {0};
+_Static_assert(sizeof(((sike_pk_ctx*)0)->opaque) >= 5*sizeof(f2elm_t), "sike_pk_ctx is too small for xP, xQ, xR, A and A24");
+
+void sike_pk_ctx_init(sike_pk_ctx* ctx, const unsigned char* PublicKey)
+{ // Precomputation of a public key context
+  // Input:  a public key PublicKey consisting of 3 elements in GF(p^2) encoded by removing leading 0 bytes.
+  // Output: the context ctx with the decoded x-coordinates xP, xQ, xR, the curve coefficient A and A24 = (A+2)/4.
+    f2elm_t* PK = (f2elm_t*)ctx->opaque;    // PK = {xP, xQ, xR, A, A24}
+
+    fp2_decode(PublicKey, PK[0]);
+    fp2_decode(PublicKey + FP2_ENCODED_BYTES, PK[1]);
+    fp2_decode(PublicKey + 2*FP2_ENCODED_BYTES, PK[2]);
+    get_A(PK[0], PK[1], PK[2], PK[3]);
+
+    fp2zero(PK[4]);
+    fpcopy((digit_t*)&Montgomery_one, PK[4][0]);
+    mp2_add(PK[4], PK[4], PK[4]);
+    mp2_add(PK[3], PK[4], PK[4]);
+    fp2div2(PK[4], PK[4]);  
+    fp2div2(PK[4], PK[4]);                  // A24 = (A+2)/4
+
+    memcpy(ctx->pk, PublicKey, CRYPTO_PUBLICKEYBYTES);
+}
+
+
+static void SecretAgreement_A_walk(point_proj_t R, const sike_pk_ctx* ctx, f2elm_t jnum, f2elm_t jden)
+{ // Alice's isogeny walk for shared secret computation from the kernel point, without the final inversion
+  // Inputs: the kernel point R = P + sk*Q of Alice's private key sk on Bob's curve (overwritten). 
+  //         the context ctx of Bob's public key.
+  // Output: the j-invariant of the shared curve as a fraction jnum/jden.
+    const f2elm_t* PKB = (const f2elm_t*)ctx->opaque;
+    point_proj_t pts[MAX_INT_POINTS_ALICE];
+    f2elm_t coeff[3];
+    f2elm_t A24plus = {0}, C24 = {0};
     unsigned int i, row, m, index = 0, pts_index[MAX_INT_POINTS_ALICE], npts = 0, ii = 0;
-    digit_t SecretKeyA[NWORDS_ORDER] = {0};
-      
-    // Initialize images of Bob's basis
-    fp2_decode(PublicKeyB, PKB[0]);
-    fp2_decode(PublicKeyB + FP2_ENCODED_BYTES, PKB[1]);
-    fp2_decode(PublicKeyB + 2*FP2_ENCODED_BYTES, PKB[2]);
 
     // Initialize constants: A24plus = A+2C, C24 = 4C, where C=1
-    get_A(PKB[0], PKB[1], PKB[2], A);
     mp_add((digit_t*)&Montgomery_one, (digit_t*)&Montgomery_one, C24[0], NWORDS_FIELD);
-    mp2_add(A, C24, A24plus);
+    mp2_add(PKB[3], C24, A24plus);
     mp_add(C24[0], C24[0], C24[0], NWORDS_FIELD);
-
-    // Retrieve kernel point
-    decode_to_digits(PrivateKeyA, SecretKeyA, SECRETKEY_A_BYTES, NWORDS_ORDER);
-    LADDER3PT(PKB[0], PKB[1], PKB[2], SecretKeyA, ALICE, R, A);    
+    PROFILE_PHASE_BEGIN(SIDH_PHASE_TRAVERSAL);
 
 #if (OALICE_BITS % 2 == 1)
     point_proj_t S;
@@ -238,7 +456,7 @@ int EphemeralSecretAgreement_A(const unsigned char* PrivateKeyA, const unsigned
             fp2copy(R->X, pts[npts]->X);
             fp2copy(R->Z, pts[npts]->Z);
             pts_index[npts++] = index;
-            m = strat_Alice[ii++];
+            m = strat_Alice_active[ii++];
             xDBLe(R, R, A24plus, C24, (int)(2*m));
             index += m;
         }
@@ -255,42 +473,124 @@ int EphemeralSecretAgreement_A(const unsigned char* PrivateKeyA, const unsigned
     }
 
     get_4_isog(R, A24plus, C24, coeff); 
+    PROFILE_PHASE_END();
     mp2_add(A24plus, A24plus, A24plus);                                                
     fp2sub(A24plus, C24, A24plus); 
     fp2add(A24plus, A24plus, A24plus);                    
-    j_inv(A24plus, C24, jinv);
+    j_inv_proj(A24plus, C24, jnum, jden);
+}
+
+
+static void SecretAgreement_A_proj(const unsigned char* PrivateKeyA, const sike_pk_ctx* ctx, f2elm_t jnum, f2elm_t jden)
+{ // Alice's isogeny walk for shared secret computation, without the final inversion
+  // Inputs: Alice's PrivateKeyA is an integer in the range [0, oA-1]. 
+  //         the context ctx of Bob's public key.
+  // Output: the j-invariant of the shared curve as a fraction jnum/jden.
+    const f2elm_t* PKB = (const f2elm_t*)ctx->opaque;
+    point_proj_t R;
+    digit_t SecretKeyA[NWORDS_ORDER] = {0};
+
+    // Retrieve kernel point
+    decode_to_digits(PrivateKeyA, SecretKeyA, SECRETKEY_A_BYTES, NWORDS_ORDER);
+    LADDER3PT_A24(PKB[0], PKB[1], PKB[2], SecretKeyA, ALICE, R, PKB[4]);    
+    SecretAgreement_A_walk(R, ctx, jnum, jden);
+}
+
+
+static void EncapsulationWalks_A_batch(const unsigned char* PrivateKeysA, const unsigned int n, const sike_pk_ctx* ctx, point_proj_t* phi, f2elm_t* jnum, f2elm_t* jden)
+{ // Alice's isogeny walks for public key generation and shared secret computation for n <= LADDER_BATCH_SIZE private keys,
+  // without the final inversions. The kernel points of all keys on Alice's curve and on Bob's curve are computed with
+  // LADDER3PT_A24_batch, since all ladders of one walk share the base points and the curve (on E0, with the precomputed
+  // multiples of Alice's generator in LADDER3PT_fixed if SIDH_FIXED_BASE is defined).
+  // Inputs: the private keys PrivateKeysA (n*SECRETKEY_A_BYTES bytes, each in the range [0, 2^eA - 1]).
+  //         the context ctx of Bob's public key.
+  // Outputs: the images phi[3k], phi[3k+1], phi[3k+2] of Bob's basis and the j-invariant jnum[k]/jden[k] of the shared curve
+  //          of the k-th private key.
+    const f2elm_t* PKB = (const f2elm_t*)ctx->opaque;
+    point_proj_t R[LADDER_BATCH_SIZE];
+#if !defined(SIDH_FIXED_BASE)
+    f2elm_t XPA, XQA, XRA, A24 = {0};
+#endif
+    digit_t SecretKeysA[LADDER_BATCH_SIZE*NWORDS_ORDER] = {0};
+    unsigned int k;
+
+    for (k = 0; k < n; k++) {
+        decode_to_digits(PrivateKeysA + k*SECRETKEY_A_BYTES, SecretKeysA + k*NWORDS_ORDER, SECRETKEY_A_BYTES, NWORDS_ORDER);
+    }
+
+    // Public key generation on E0, with A24 = (A+2)/4 = 2
+#if defined(SIDH_FIXED_BASE)
+    LADDER3PT_fixed((digit_t*)A_gen, (digit_t*)A_gen_dbl, SecretKeysA, ALICE, R, n);
+#else
+    init_basis((digit_t*)A_gen, XPA, XQA, XRA);
+    fpcopy((digit_t*)&Montgomery_one, A24[0]);
+    mp2_add(A24, A24, A24);
+    LADDER3PT_A24_batch(XPA, XQA, XRA, SecretKeysA, ALICE, R, A24, n);
+#endif
+    for (k = 0; k < n; k++) {
+        KeyGeneration_A_walk(R[k], phi[3*k], phi[3*k+1], phi[3*k+2]);
+    }
+
+    // Shared secret computation on Bob's curve
+    LADDER3PT_A24_batch(PKB[0], PKB[1], PKB[2], SecretKeysA, ALICE, R, PKB[4], n);
+    for (k = 0; k < n; k++) {
+        SecretAgreement_A_walk(R[k], ctx, jnum[k], jden[k]);
+    }
+}
+
+
+int EphemeralSecretAgreement_A_ctx(const unsigned char* PrivateKeyA, const sike_pk_ctx* ctx, unsigned char* SharedSecretA)
+{ // Alice's ephemeral shared secret computation using a precomputed context of Bob's public key
+  // Inputs: Alice's PrivateKeyA is an integer in the range [0, oA-1]. 
+  //         the context ctx of Bob's public key, as computed by sike_pk_ctx_init.
+  // Output: a shared secret SharedSecretA that consists of one element in GF(p^2) encoded by removing leading 0 bytes.  
+    f2elm_t jnum, jinv;
+
+    SecretAgreement_A_proj(PrivateKeyA, ctx, jnum, jinv);
+    fp2inv_mont(jinv);                  // j = jnum/jinv
+    fp2mul_mont(jinv, jnum, jinv);
     fp2_encode(jinv, SharedSecretA);    // Format shared secret
 
     return 0;
 }
 
 
-int EphemeralSecretAgreement_B(const unsigned char* PrivateKeyB, const unsigned char* PublicKeyA, unsigned char* SharedSecretB)
-{ // Bob's ephemeral shared secret computation
-  // It produces a shared secret key SharedSecretB using his secret key PrivateKeyB and Alice's public key PublicKeyA
+int EphemeralSecretAgreement_A(const unsigned char* PrivateKeyA, const unsigned char* PublicKeyB, unsigned char* SharedSecretA)
+{ // Alice's ephemeral shared secret computation
+  // It produces a shared secret key SharedSecretA using her secret key PrivateKeyA and Bob's public key PublicKeyB
+  // Inputs: Alice's PrivateKeyA is an integer in the range [0, oA-1]. 
+  //         Bob's PublicKeyB consists of 3 elements in GF(p^2) encoded by removing leading 0 bytes.
+  // Output: a shared secret SharedSecretA that consists of one element in GF(p^2) encoded by removing leading 0 bytes.  
+    sike_pk_ctx ctx;
+      
+    // Initialize images of Bob's basis
+    sike_pk_ctx_init(&ctx, PublicKeyB);
+
+    return EphemeralSecretAgreement_A_ctx(PrivateKeyA, &ctx, SharedSecretA);
+}
+
+
+int EphemeralSecretAgreement_B_ctx(const unsigned char* PrivateKeyB, const sike_pk_ctx* ctx, unsigned char* SharedSecretB)
+{ // Bob's ephemeral shared secret computation using a precomputed context of Alice's public key
   // Inputs: Bob's PrivateKeyB is an integer in the range [0, 2^Floor(Log(2,oB)) - 1]. 
-  //         Alice's PublicKeyA consists of 3 elements in GF(p^2) encoded by removing leading 0 bytes.
+  //         the context ctx of Alice's public key, as computed by sike_pk_ctx_init.
   // Output: a shared secret SharedSecretB that consists of one element in GF(p^2) encoded by removing leading 0 bytes.  
+    const f2elm_t* PKB = (const f2elm_t*)ctx->opaque;
     point_proj_t R, pts[MAX_INT_POINTS_BOB];
-    f2elm_t coeff[3], PKB[3], jinv;
+    f2elm_t coeff[3], jinv;
     f2elm_t A24plus = {0}, A24minus = {0}, A = {0};
     unsigned int i, row, m, index = 0, pts_index[MAX_INT_POINTS_BOB], npts = 0, ii = 0;
     digit_t SecretKeyB[NWORDS_ORDER] = {0};
-      
-    // Initialize images of Alice's basis
-    fp2_decode(PublicKeyA, PKB[0]);
-    fp2_decode(PublicKeyA + FP2_ENCODED_BYTES, PKB[1]);
-    fp2_decode(PublicKeyA + 2*FP2_ENCODED_BYTES, PKB[2]);
 
     // Initialize constants: A24plus = A+2C, A24minus = A-2C, where C=1
-    get_A(PKB[0], PKB[1], PKB[2], A);
     mp_add((digit_t*)&Montgomery_one, (digit_t*)&Montgomery_one, A24minus[0], NWORDS_FIELD);
-    mp2_add(A, A24minus, A24plus);
-    mp2_sub_p2(A, A24minus, A24minus);
+    mp2_add(PKB[3], A24minus, A24plus);
+    mp2_sub_p2(PKB[3], A24minus, A24minus);
 
     // Retrieve kernel point
     decode_to_digits(PrivateKeyB, SecretKeyB, SECRETKEY_B_BYTES, NWORDS_ORDER);
-    LADDER3PT(PKB[0], PKB[1], PKB[2], SecretKeyB, BOB, R, A);
+    LADDER3PT_A24(PKB[0], PKB[1], PKB[2], SecretKeyB, BOB, R, PKB[4]);
+    PROFILE_PHASE_BEGIN(SIDH_PHASE_TRAVERSAL);
     
     // Traverse tree
     index = 0;  
@@ -299,7 +599,7 @@ int EphemeralSecretAgreement_B(const unsigned char* PrivateKeyB, const unsigned
             fp2copy(R->X, pts[npts]->X);
             fp2copy(R->Z, pts[npts]->Z);
             pts_index[npts++] = index;
-            m = strat_Bob[ii++];
+            m = strat_Bob_active[ii++];
             xTPLe(R, R, A24minus, A24plus, (int)m);
             index += m;
         }
@@ -316,6 +616,7 @@ int EphemeralSecretAgreement_B(const unsigned char* PrivateKeyB, const unsigned
     }
      
     get_3_isog(R, A24minus, A24plus, coeff);    
+    PROFILE_PHASE_END();
     fp2add(A24plus, A24minus, A);                 
     fp2add(A, A, A);
     fp2sub(A24plus, A24minus, A24plus);                   
@@ -323,4 +624,19 @@ int EphemeralSecretAgreement_B(const unsigned char* PrivateKeyB, const unsigned
     fp2_encode(jinv, SharedSecretB);    // Format shared secret
 
     return 0;
+}
+
+
+int EphemeralSecretAgreement_B(const unsigned char* PrivateKeyB, const unsigned char* PublicKeyA, unsigned char* SharedSecretB)
+{ // Bob's ephemeral shared secret computation
+  // It produces a shared secret key SharedSecretB using his secret key PrivateKeyB and Alice's public key PublicKeyA
+  // Inputs: Bob's PrivateKeyB is an integer in the range [0, 2^Floor(Log(2,oB)) - 1]. 
+  //         Alice's PublicKeyA consists of 3 elements in GF(p^2) encoded by removing leading 0 bytes.
+  // Output: a shared secret SharedSecretB that consists of one element in GF(p^2) encoded by removing leading 0 bytes.  
+    sike_pk_ctx ctx;
+      
+    // Initialize images of Alice's basis
+    sike_pk_ctx_init(&ctx, PublicKeyA);
+
+    return EphemeralSecretAgreement_B_ctx(PrivateKeyB, &ctx, SharedSecretB);
 }
\ No newline at end of file
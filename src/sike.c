@@ -10,11 +10,20 @@
 
 #include <string.h>
 #include "sha3/fips202.h"
+#include "sha3/fips202x4.h"
+#include "sike_scheme.h"
 
 #ifdef DO_VALGRIND_CHECK
 #include <valgrind/memcheck.h>
 #endif
 
+// Number of encapsulations whose final inversions are merged in crypto_kem_enc_batch
+#define KEM_BATCH_SIZE    8
+
+#if (KEM_BATCH_SIZE > LADDER_BATCH_SIZE)
+    #error -- "KEM_BATCH_SIZE exceeds the number of ladders run in lockstep"
+#endif
+
 
 int crypto_kem_keypair(unsigned char *pk, unsigned char *sk)
 { // SIKE's key generation
@@ -41,9 +50,9 @@ int crypto_kem_keypair(unsigned char *pk, unsigned char *sk)
 }
 
 
-int crypto_kem_enc(unsigned char *ct, unsigned char *ss, const unsigned char *pk)
-{ // SIKE's encapsulation
-  // Input:   public key pk         (CRYPTO_PUBLICKEYBYTES bytes)
+int crypto_kem_enc_ctx(unsigned char *ct, unsigned char *ss, const sike_pk_ctx *ctx)
+{ // SIKE's encapsulation using a precomputed public key context
+  // Input:   context ctx of the public key pk, as computed by sike_pk_ctx_init
   // Outputs: shared secret ss      (CRYPTO_BYTES bytes)
   //          ciphertext message ct (CRYPTO_CIPHERTEXTBYTES = CRYPTO_PUBLICKEYBYTES + MSG_BYTES bytes)
     unsigned char ephemeralsk[SECRETKEY_A_BYTES];
@@ -56,13 +65,13 @@ int crypto_kem_enc(unsigned char *ct, unsigned char *ss, const unsigned char *pk
 #ifdef DO_VALGRIND_CHECK
     VALGRIND_MAKE_MEM_UNDEFINED(temp, MSG_BYTES);
 #endif
-    memcpy(&temp[MSG_BYTES], pk, CRYPTO_PUBLICKEYBYTES);
+    memcpy(&temp[MSG_BYTES], ctx->pk, CRYPTO_PUBLICKEYBYTES);
     shake256(ephemeralsk, SECRETKEY_A_BYTES, temp, CRYPTO_PUBLICKEYBYTES+MSG_BYTES);
     ephemeralsk[SECRETKEY_A_BYTES - 1] &= MASK_ALICE;
 
     // Encrypt
     EphemeralKeyGeneration_A(ephemeralsk, ct);
-    EphemeralSecretAgreement_A(ephemeralsk, pk, jinvariant);
+    EphemeralSecretAgreement_A_ctx(ephemeralsk, ctx, jinvariant);
     shake256(h, MSG_BYTES, jinvariant, FP2_ENCODED_BYTES);
     for (int i = 0; i < MSG_BYTES; i++) {
         ct[i + CRYPTO_PUBLICKEYBYTES] = temp[i] ^ h[i];
@@ -79,6 +88,37 @@ int crypto_kem_enc(unsigned char *ct, unsigned char *ss, const unsigned char *pk
 }
 
 
+int crypto_kem_enc(unsigned char *ct, unsigned char *ss, const unsigned char *pk)
+{ // SIKE's encapsulation
+  // Input:   public key pk         (CRYPTO_PUBLICKEYBYTES bytes)
+  // Outputs: shared secret ss      (CRYPTO_BYTES bytes)
+  //          ciphertext message ct (CRYPTO_CIPHERTEXTBYTES = CRYPTO_PUBLICKEYBYTES + MSG_BYTES bytes)
+    sike_pk_ctx ctx;
+
+    sike_pk_ctx_init(&ctx, pk);
+
+    return crypto_kem_enc_ctx(ct, ss, &ctx);
+}
+
+
+int crypto_kem_ct_validate(const unsigned char *ct)
+{ // Structural validation of a SIKE ciphertext, in constant time
+  // Input:   ciphertext message ct (CRYPTO_CIPHERTEXTBYTES bytes)
+  // Output:  0 if the six GF(p) coordinates of the public key encoded in ct are in the range [0, p-1], -1 otherwise.
+  //          The re-encryption of crypto_kem_dec only outputs reduced coordinates, so any ciphertext rejected here is also
+  //          rejected by the full decapsulation.
+    digit_t a[NWORDS_FIELD];
+    unsigned int i, valid = 1;
+
+    for (i = 0; i < 6; i++) {
+        decode_to_digits(ct + i*(FP2_ENCODED_BYTES / 2), a, FP2_ENCODED_BYTES / 2, NWORDS_FIELD);
+        valid &= mp_sub(a, (digit_t*)&PRIME, a, NWORDS_FIELD);    // Borrow = 1 if a < p
+    }
+
+    return (int)valid - 1;
+}
+
+
 int crypto_kem_dec(unsigned char *ss, const unsigned char *ct, const unsigned char *sk)
 { // SIKE's decapsulation
   // Input:   secret key sk         (CRYPTO_SECRETKEYBYTES = MSG_BYTES + SECRETKEY_B_BYTES + CRYPTO_PUBLICKEYBYTES bytes)
@@ -89,6 +129,15 @@ int crypto_kem_dec(unsigned char *ss, const unsigned char *ct, const unsigned ch
     unsigned char h_[MSG_BYTES];
     unsigned char c0_[CRYPTO_PUBLICKEYBYTES];
     unsigned char temp[CRYPTO_CIPHERTEXTBYTES+MSG_BYTES];
+
+    // Reject ciphertexts with unreduced coordinates without the isogeny walks, ss <- H(s||ct)
+    // Validity depends only on the public ciphertext, so this branch leaks nothing about sk
+    if (crypto_kem_ct_validate(ct) != 0) {
+        memcpy(temp, sk, MSG_BYTES);
+        memcpy(&temp[MSG_BYTES], ct, CRYPTO_CIPHERTEXTBYTES);
+        shake256(ss, CRYPTO_BYTES, temp, CRYPTO_CIPHERTEXTBYTES+MSG_BYTES);
+        return 0;
+    }
 #ifdef DO_VALGRIND_CHECK
     VALGRIND_MAKE_MEM_UNDEFINED(sk, CRYPTO_SECRETKEYBYTES);
 #endif
@@ -117,4 +166,114 @@ int crypto_kem_dec(unsigned char *ss, const unsigned char *ct, const unsigned ch
     VALGRIND_MAKE_MEM_DEFINED(sk, CRYPTO_SECRETKEYBYTES);
 #endif
     return 0;
-}
\ No newline at end of file
+}
+
+
+static void shake256_batch(unsigned char *out, unsigned long long outlen, unsigned long long outstride, 
+                           const unsigned char *in, unsigned long long inlen, unsigned long long instride, unsigned int n)
+{ // SHAKE256 of n inputs of inlen bytes located instride bytes apart, into n outputs located outstride bytes apart
+  // Inputs are hashed four at a time with shake256x4
+    unsigned int k;
+
+    for (k = 0; k + 4 <= n; k += 4) {
+        shake256x4(out + k*outstride, out + (k+1)*outstride, out + (k+2)*outstride, out + (k+3)*outstride, outlen, 
+                   in + k*instride, in + (k+1)*instride, in + (k+2)*instride, in + (k+3)*instride, inlen);
+    }
+    for (; k < n; k++) {
+        shake256(out + k*outstride, outlen, in + k*instride, inlen);
+    }
+}
+
+
+int crypto_kem_enc_batch(unsigned char *ct, unsigned char *ss, const unsigned char *pk, unsigned int n)
+{ // SIKE's encapsulation for a batch of n ciphertexts under the same public key
+  // Input:   public key pk         (CRYPTO_PUBLICKEYBYTES bytes)
+  //          number of encapsulations n
+  // Outputs: shared secrets ss     (n*CRYPTO_BYTES bytes, the i-th secret at ss + i*CRYPTO_BYTES)
+  //          ciphertexts ct        (n*CRYPTO_CIPHERTEXTBYTES bytes, the i-th ciphertext at ct + i*CRYPTO_CIPHERTEXTBYTES)
+  // The public key is decoded once, the ladders of up to KEM_BATCH_SIZE isogeny walks run in lockstep, their final
+  // inversions are merged into one, and the hashes of the batch are computed four at a time.
+    unsigned char m[KEM_BATCH_SIZE*MSG_BYTES];
+    unsigned char ephemeralsk[KEM_BATCH_SIZE][SECRETKEY_A_BYTES];
+    unsigned char jinvariant[KEM_BATCH_SIZE][FP2_ENCODED_BYTES];
+    unsigned char h[KEM_BATCH_SIZE][MSG_BYTES];
+    unsigned char gtemp[KEM_BATCH_SIZE][CRYPTO_PUBLICKEYBYTES+MSG_BYTES];
+    unsigned char temp[KEM_BATCH_SIZE][CRYPTO_CIPHERTEXTBYTES+MSG_BYTES];
+    point_proj_t phi[3*KEM_BATCH_SIZE];
+    f2elm_t jnum[KEM_BATCH_SIZE], jden[KEM_BATCH_SIZE], den[4*KEM_BATCH_SIZE], inv[4*KEM_BATCH_SIZE];
+    unsigned int i, j, k, batch;
+    sike_pk_ctx ctx;
+
+    // Decode the public key and recover its curve coefficient once for the whole batch
+    sike_pk_ctx_init(&ctx, pk);
+    for (k = 0; k < KEM_BATCH_SIZE; k++) {
+        memcpy(&gtemp[k][MSG_BYTES], pk, CRYPTO_PUBLICKEYBYTES);
+    }
+
+    for (i = 0; i < n; i += batch) {
+        batch = (n - i < KEM_BATCH_SIZE) ? (n - i) : KEM_BATCH_SIZE;
+        randombytes(m, batch*MSG_BYTES);
+#ifdef DO_VALGRIND_CHECK
+        VALGRIND_MAKE_MEM_UNDEFINED(m, batch*MSG_BYTES);
+#endif
+
+        // Generate ephemeralsk <- G(m||pk) mod oA 
+        for (k = 0; k < batch; k++) {
+            memcpy(gtemp[k], &m[k*MSG_BYTES], MSG_BYTES);
+        }
+        shake256_batch(ephemeralsk[0], SECRETKEY_A_BYTES, SECRETKEY_A_BYTES, gtemp[0], CRYPTO_PUBLICKEYBYTES+MSG_BYTES, CRYPTO_PUBLICKEYBYTES+MSG_BYTES, batch);
+
+        for (k = 0; k < batch; k++) {
+            ephemeralsk[k][SECRETKEY_A_BYTES - 1] &= MASK_ALICE;
+        }
+
+        // Run both of Alice's isogeny walks, with the ladders of the batch in lockstep and deferring the inversions
+        EncapsulationWalks_A_batch(ephemeralsk[0], batch, &ctx, phi, jnum, jden);
+        for (k = 0; k < batch; k++) {
+            for (j = 0; j < 3; j++) {
+                fp2copy(phi[3*k+j]->Z, den[4*k+j]);
+            }
+            fp2copy(jden[k], den[4*k+3]);
+        }
+
+        mont_n_way_inv_ct((const f2elm_t*)den, (int)(4*batch), inv);
+
+        for (k = 0; k < batch; k++) {
+            unsigned char *ct_k = ct + (i + k)*CRYPTO_CIPHERTEXTBYTES;
+
+            for (j = 0; j < 3; j++) {
+                fp2mul_mont(phi[3*k+j]->X, inv[4*k+j], phi[3*k+j]->X);
+                fp2_encode(phi[3*k+j]->X, ct_k + j*FP2_ENCODED_BYTES);
+            }
+            fp2mul_mont(jnum[k], inv[4*k+3], jnum[k]);
+            fp2_encode(jnum[k], jinvariant[k]);
+        }
+
+        // Encrypt
+        shake256_batch(h[0], MSG_BYTES, MSG_BYTES, jinvariant[0], FP2_ENCODED_BYTES, FP2_ENCODED_BYTES, batch);
+        for (k = 0; k < batch; k++) {
+            unsigned char *ct_k = ct + (i + k)*CRYPTO_CIPHERTEXTBYTES;
+
+            for (j = 0; j < MSG_BYTES; j++) {
+                ct_k[j + CRYPTO_PUBLICKEYBYTES] = m[k*MSG_BYTES + j] ^ h[k][j];
+            }
+            memcpy(temp[k], &m[k*MSG_BYTES], MSG_BYTES);
+            memcpy(&temp[k][MSG_BYTES], ct_k, CRYPTO_CIPHERTEXTBYTES);
+        }
+
+        // Generate shared secrets ss <- H(m||ct)
+        shake256_batch(ss + i*CRYPTO_BYTES, CRYPTO_BYTES, CRYPTO_BYTES, temp[0], CRYPTO_CIPHERTEXTBYTES+MSG_BYTES, CRYPTO_CIPHERTEXTBYTES+MSG_BYTES, batch);
+#ifdef DO_VALGRIND_CHECK
+        VALGRIND_MAKE_MEM_DEFINED(m, batch*MSG_BYTES);
+#endif
+    }
+
+    return 0;
+}
+
+
+// Sizes and functions of this parameter set, for runtime selection with sike_get_scheme()
+const sike_scheme crypto_kem_scheme = {
+    CRYPTO_ALGNAME, CRYPTO_PUBLICKEYBYTES, CRYPTO_SECRETKEYBYTES, CRYPTO_CIPHERTEXTBYTES, CRYPTO_BYTES,
+    crypto_kem_keypair, crypto_kem_enc, crypto_kem_dec, crypto_kem_enc_batch, crypto_kem_ct_validate
+};
\ No newline at end of file
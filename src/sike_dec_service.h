@@ -0,0 +1,43 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: types of the asynchronous decapsulation services of the compressed SIKE parameter sets
+*
+* A service crypto_kem_dec_service_create_SIKEpXXX_compressed() owns a fixed pool of worker threads.
+* Submitted ciphertexts go through two stages: the shared secret recovery (Alice's isogeny walk),
+* run for batches of requests whose final inversions are merged, and the re-encryption check
+* (Bob's isogeny walk), run in lockstep for batches of up to 4 requests. The workers run both
+* stages for different requests at the same time.
+*********************************************************************************************/
+
+#ifndef SIKE_DEC_SERVICE_H
+#define SIKE_DEC_SERVICE_H
+
+
+#define SIKE_DEC_HISTOGRAM_BUCKETS    32
+
+typedef struct sike_dec_service sike_dec_service;
+
+// Completion callback of a request, called by a worker thread once the shared secret ss is written: ctx is the context
+// given at submission. The callback must not destroy the service
+typedef void (*sike_dec_callback_t)(void* ctx, unsigned char* ss);
+
+typedef struct {
+    unsigned long long submitted;           // Requests accepted by the service
+    unsigned long long rejected;            // Submissions refused because the queue was full or the service was stopping
+    unsigned long long completed;           // Requests whose shared secret is written
+    unsigned long long batches;             // Batches of the first stage, completed/batches is the average batch size
+    unsigned int in_flight;                 // Requests submitted but not completed, i.e., the current queue depth
+    unsigned long long queue_depth[SIKE_DEC_HISTOGRAM_BUCKETS];   // Queue depth found by the accepted submissions: bucket 0 counts
+                                                                  // depth 0 and bucket i > 0 depths in [2^(i-1), 2^i)
+    unsigned long long latency[SIKE_DEC_HISTOGRAM_BUCKETS];       // Time from submission to completion: bucket 0 counts latencies
+                                                                  // below 2 us, bucket i > 0 latencies in [2^i, 2^(i+1)) us, and
+                                                                  // the last bucket everything above
+} sike_dec_stats;
+
+
+#endif
@@ -0,0 +1,59 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: table of the SIKE parameter sets of the unified library
+*********************************************************************************************/
+
+#include <string.h>
+#include "sike_scheme.h"
+
+extern const sike_scheme crypto_kem_scheme_SIKEp217;
+extern const sike_scheme crypto_kem_scheme_SIKEp434;
+extern const sike_scheme crypto_kem_scheme_SIKEp503;
+extern const sike_scheme crypto_kem_scheme_SIKEp610;
+extern const sike_scheme crypto_kem_scheme_SIKEp751;
+extern const sike_scheme crypto_kem_scheme_SIKEp434_compressed;
+extern const sike_scheme crypto_kem_scheme_SIKEp503_compressed;
+extern const sike_scheme crypto_kem_scheme_SIKEp610_compressed;
+extern const sike_scheme crypto_kem_scheme_SIKEp751_compressed;
+
+static const sike_scheme* const schemes[] = {
+    &crypto_kem_scheme_SIKEp217,
+    &crypto_kem_scheme_SIKEp434,
+    &crypto_kem_scheme_SIKEp503,
+    &crypto_kem_scheme_SIKEp610,
+    &crypto_kem_scheme_SIKEp751,
+    &crypto_kem_scheme_SIKEp434_compressed,
+    &crypto_kem_scheme_SIKEp503_compressed,
+    &crypto_kem_scheme_SIKEp610_compressed,
+    &crypto_kem_scheme_SIKEp751_compressed
+};
+
+#define NSCHEMES    (sizeof(schemes) / sizeof(schemes[0]))
+
+
+const sike_scheme* sike_get_scheme(const char* name)
+{ // Lookup of a parameter set by algorithm name
+    unsigned int i;
+
+    if (name == NULL) {
+        return NULL;
+    }
+    for (i = 0; i < NSCHEMES; i++) {
+        if (strcmp(schemes[i]->name, name) == 0) {
+            return schemes[i];
+        }
+    }
+    return NULL;
+}
+
+
+const sike_scheme* sike_get_scheme_at(unsigned int index)
+{ // Enumeration of the parameter sets
+
+    return (index < NSCHEMES) ? schemes[index] : NULL;
+}
@@ -0,0 +1,39 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: runtime selection of the SIKE parameter sets
+*
+* Every SIKE translation unit defines a descriptor crypto_kem_scheme_SIKEpXXX[_compressed] with
+* its sizes and functions. The unified library (make libsidh) links all of them and looks them
+* up by name with sike_get_scheme().
+*********************************************************************************************/
+
+#ifndef SIKE_SCHEME_H
+#define SIKE_SCHEME_H
+
+
+typedef struct {
+    const char* name;                       // Algorithm name, e.g., "SIKEp434" or "SIKEp434_compressed"
+    unsigned int public_key_bytes;          // CRYPTO_PUBLICKEYBYTES
+    unsigned int secret_key_bytes;          // CRYPTO_SECRETKEYBYTES
+    unsigned int ciphertext_bytes;          // CRYPTO_CIPHERTEXTBYTES
+    unsigned int shared_secret_bytes;       // CRYPTO_BYTES
+    int (*keypair)(unsigned char *pk, unsigned char *sk);
+    int (*enc)(unsigned char *ct, unsigned char *ss, const unsigned char *pk);
+    int (*dec)(unsigned char *ss, const unsigned char *ct, const unsigned char *sk);
+    int (*enc_batch)(unsigned char *ct, unsigned char *ss, const unsigned char *pk, unsigned int n);    // NULL if not available
+    int (*ct_validate)(const unsigned char *ct);                                                        // NULL if not available
+} sike_scheme;
+
+// Returns the parameter set with the given algorithm name, or NULL if it is not in the library
+const sike_scheme* sike_get_scheme(const char* name);
+
+// Returns the index-th parameter set of the library, or NULL if index is not less than the number of parameter sets
+const sike_scheme* sike_get_scheme_at(unsigned int index);
+
+
+#endif
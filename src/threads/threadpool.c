@@ -0,0 +1,183 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: persistent worker pool used for parallel isogeny evaluation
+*
+* The workers are created on first use, and then wait for jobs. A posted job is picked up by polling 
+* while the pool is busy, so that the per-row latency of the isogeny tree traversal stays low; idle 
+* workers, and a caller waiting for a job, fall asleep on a condition variable after SPIN_POLLS polls.
+* The workers do not survive a fork(): the pool of the child is reset and started again on first use.
+* The number of workers is SIDH_THREADS by default and can be changed at runtime with the environment
+* variable SIDH_THREADS, read once on first use. A value of 0 disables the pool.
+*********************************************************************************************/
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include "threadpool.h"
+
+#if !defined(SIDH_THREADS)
+    #define SIDH_THREADS    1
+#endif
+#define MAX_WORKERS        64
+#define SPIN_POLLS       1000     // Number of polls before an idle worker or a waiting caller goes to sleep
+
+
+static pthread_mutex_t pool_start = PTHREAD_MUTEX_INITIALIZER;    // Serializes the start of the workers
+static pthread_mutex_t pool_owner = PTHREAD_MUTEX_INITIALIZER;    // Held by the thread using the pool
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;     // Protects pool_sleepers and pool_waiting
+static pthread_cond_t pool_cond = PTHREAD_COND_INITIALIZER;       // Signaled when a job is posted
+static pthread_cond_t pool_done = PTHREAD_COND_INITIALIZER;       // Signaled when the last worker finishes a job
+static unsigned int pool_nworkers = 0, pool_sleepers = 0, pool_waiting = 0;
+static atomic_int pool_started = 0;
+static int pool_atfork_registered = 0;
+static atomic_uint pool_generation = 0;                           // Incremented for every posted job
+static atomic_uint pool_pending = 0;                              // Number of workers still running the current job
+static sidh_job_t pool_fn;
+static void* pool_arg;
+static unsigned int pool_part[MAX_WORKERS];
+
+
+static void* pool_worker(void* arg)
+{ // Worker loop, runs part *arg of every posted job
+    unsigned int part = *(unsigned int*)arg, last = 0, current, polls;
+
+    for (;;) {
+        polls = 0;
+        while ((current = atomic_load_explicit(&pool_generation, memory_order_acquire)) == last) {
+            if (++polls < SPIN_POLLS) {
+                sched_yield();
+                continue;
+            }
+            pthread_mutex_lock(&pool_lock);
+            pool_sleepers++;
+            while (atomic_load_explicit(&pool_generation, memory_order_acquire) == last) {
+                pthread_cond_wait(&pool_cond, &pool_lock);
+            }
+            pool_sleepers--;
+            pthread_mutex_unlock(&pool_lock);
+        }
+        last = current;
+        pool_fn(pool_arg, part, pool_nworkers);
+        if (atomic_fetch_sub_explicit(&pool_pending, 1, memory_order_acq_rel) == 1) {
+            pthread_mutex_lock(&pool_lock);
+            if (pool_waiting != 0) {
+                pthread_cond_signal(&pool_done);
+            }
+            pthread_mutex_unlock(&pool_lock);
+        }
+    }
+    return NULL;
+}
+
+
+static void pool_atfork_child(void)
+{ // The child of a fork() has no workers and may have inherited locked mutexes: the pool is reset, to be started again on 
+  // first use in the child
+    pthread_mutex_init(&pool_start, NULL);
+    pthread_mutex_init(&pool_owner, NULL);
+    pthread_mutex_init(&pool_lock, NULL);
+    pthread_cond_init(&pool_cond, NULL);
+    pthread_cond_init(&pool_done, NULL);
+    pool_nworkers = 0;
+    pool_sleepers = 0;
+    pool_waiting = 0;
+    atomic_store(&pool_generation, 0);
+    atomic_store(&pool_pending, 0);
+    atomic_store(&pool_started, 0);
+}
+
+
+static void pool_init(void)
+{ // Starts the workers. On failure the pool keeps the workers started so far
+    const char* env = getenv("SIDH_THREADS");
+    long n = SIDH_THREADS;
+    unsigned int i;
+    pthread_attr_t attr;
+    pthread_t thread;
+
+    if (env != NULL && *env != '\0') {
+        n = strtol(env, NULL, 10);
+    }
+    if (n < 0) n = 0;
+    if (n > MAX_WORKERS) n = MAX_WORKERS;
+    if (pool_atfork_registered == 0) {                // Registered once, the registration is inherited by the children
+        pthread_atfork(NULL, NULL, pool_atfork_child);
+        pool_atfork_registered = 1;
+    }
+
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    for (i = 0; i < (unsigned int)n; i++) {
+        pool_part[i] = i;
+        if (pthread_create(&thread, &attr, pool_worker, &pool_part[i]) != 0) {
+            break;
+        }
+    }
+    pthread_attr_destroy(&attr);
+    pool_nworkers = i;
+}
+
+
+unsigned int sidh_pool_acquire(void)
+{ // Takes exclusive use of the worker pool. Returns the number of workers, or 0 if the pool is not available
+    if (atomic_load_explicit(&pool_started, memory_order_acquire) == 0) {
+        pthread_mutex_lock(&pool_start);
+        if (atomic_load_explicit(&pool_started, memory_order_relaxed) == 0) {
+            pool_init();
+            atomic_store_explicit(&pool_started, 1, memory_order_release);
+        }
+        pthread_mutex_unlock(&pool_start);
+    }
+
+    if (pool_nworkers == 0 || pthread_mutex_trylock(&pool_owner) != 0) {
+        return 0;
+    }
+    return pool_nworkers;
+}
+
+
+void sidh_pool_release(void)
+{ // Gives the pool back
+    pthread_mutex_unlock(&pool_owner);
+}
+
+
+void sidh_pool_post(sidh_job_t fn, void* arg)
+{ // Starts a job on all workers
+    pool_fn = fn;
+    pool_arg = arg;
+    atomic_store_explicit(&pool_pending, pool_nworkers, memory_order_relaxed);
+    atomic_fetch_add_explicit(&pool_generation, 1, memory_order_release);
+
+    pthread_mutex_lock(&pool_lock);
+    if (pool_sleepers != 0) {
+        pthread_cond_broadcast(&pool_cond);
+    }
+    pthread_mutex_unlock(&pool_lock);
+}
+
+
+void sidh_pool_wait(void)
+{ // Waits for completion of the job in flight, polling SPIN_POLLS times and then sleeping until the last worker is done
+    unsigned int polls = 0;
+
+    while (atomic_load_explicit(&pool_pending, memory_order_acquire) != 0) {
+        if (++polls < SPIN_POLLS) {
+            sched_yield();
+            continue;
+        }
+        pthread_mutex_lock(&pool_lock);
+        pool_waiting++;
+        while (atomic_load_explicit(&pool_pending, memory_order_acquire) != 0) {
+            pthread_cond_wait(&pool_done, &pool_lock);
+        }
+        pool_waiting--;
+        pthread_mutex_unlock(&pool_lock);
+    }
+}
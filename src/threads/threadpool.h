@@ -0,0 +1,22 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+
+// Job run by the workers: fn(arg, part, nparts) is called once for each part = 0..nparts-1, where nparts is the number of workers
+typedef void (*sidh_job_t)(void* arg, unsigned int part, unsigned int nparts);
+
+// Takes exclusive use of the worker pool, starting the workers on first use
+// Returns the number of workers, or 0 if the pool is disabled or in use by another thread, in which case the caller runs serially
+unsigned int sidh_pool_acquire(void);
+
+// Gives the pool back after the last sidh_pool_wait()
+void sidh_pool_release(void);
+
+// Starts a job on all workers and returns immediately. Only the thread holding the pool may post, and at most one job is in flight
+void sidh_pool_post(sidh_job_t fn, void* arg);
+
+// Waits for completion of the job in flight, if any
+void sidh_pool_wait(void);
+
+
+#endif
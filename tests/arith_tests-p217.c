@@ -303,6 +303,43 @@ bool fp2_test()
     else { printf("  GF(p^2) multiplication tests... FAILED"); printf("\n"); return false; }
     printf("\n");
 
+    // Sums and differences of products over GF(p217^2) with a single reduction, on random inputs and on inputs with components 
+    // p-1, 2p-1 (the largest accepted) or 0
+    {
+        const int modes[6][4] = { {0,0,0,0}, {1,1,1,1}, {2,2,2,2}, {2,2,0,2}, {3,0,2,2}, {0,2,2,3} };   // 0: random, 1: p-1, 2: 2p-1, 3: 0
+        f2elm_t* args[4] = {&ma, &mb, &mc, &md};
+        felm_t one = {1}, ext[4];
+
+        fpzero217(ext[2]); fpsub217(ext[2], one, ext[2]);                                // 2p-1
+        fpcopy217(ext[2], ext[1]); fpcorrection217(ext[1]);                              // p-1
+        fpzero217(ext[3]);
+        passed = 1;
+        for (n=0; n<TEST_LOOPS && passed==1; n++)
+        {
+            for (int k = 0; k < 6; k++) {
+                for (int i = 0; i < 4; i++) {
+                    if (modes[k][i] == 0) {
+                        fp2random217_test((digit_t*)a); to_fp2mont(a, *args[i]);
+                    } else {
+                        fpcopy217(ext[modes[k][i]], (*args[i])[0]); fpcopy217(ext[modes[k][i]], (*args[i])[1]);
+                    }
+                }
+                fp2mul217_mont(ma, mb, me); fp2mul217_mont(mc, md, mf); fp2add217(me, mf, me);   // e = a*b+c*d
+                fp2muladd217_mont(ma, mb, mc, md, mf);                                         // f = a*b+c*d
+                from_fp2mont(me, e); from_fp2mont(mf, f);
+                if (compare_words((digit_t*)e, (digit_t*)f, 2*NWORDS_FIELD)!=0) { passed=0; break; }
+
+                fp2mul217_mont(ma, mb, me); fp2mul217_mont(mc, md, mf); fp2sub217(me, mf, me);   // e = a*b-c*d
+                fp2mulsub217_mont(ma, mb, mc, md, mf);                                         // f = a*b-c*d
+                from_fp2mont(me, e); from_fp2mont(mf, f);
+                if (compare_words((digit_t*)e, (digit_t*)f, 2*NWORDS_FIELD)!=0) { passed=0; break; }
+            }
+        }
+    }
+    if (passed==1) printf("  GF(p^2) sum and difference of products tests .................... PASSED");
+    else { printf("  GF(p^2) sum and difference of products tests... FAILED"); printf("\n"); return false; }
+    printf("\n");
+
     // Squaring over GF(p217^2)
     passed = 1;
     for (n=0; n<TEST_LOOPS; n++)
@@ -324,6 +361,33 @@ bool fp2_test()
     if (passed==1) printf("  GF(p^2) squaring tests........................................... PASSED");
     else { printf("  GF(p^2) squaring tests... FAILED"); printf("\n"); return false; }
     printf("\n");
+
+#if defined(_DISPATCH_)
+    // Runtime kernel dispatch: every kernel supported by the processor must agree with the portable one
+    passed = 1;
+    int level = fpkernel217_get();
+    for (n=0; n<TEST_LOOPS; n++)
+    {
+        fp2random217_test((digit_t*)a); fp2random217_test((digit_t*)b);
+        to_fp2mont(a, ma); to_fp2mont(b, mb);
+
+        fpkernel217_set(FP_KERNEL_GENERIC);
+        fp2mul217_mont(ma, mb, mc); fp2sqr217_mont(ma, md); 
+        from_fp2mont(mc, c); from_fp2mont(md, d);
+        for (int k = FP_KERNEL_MULX; k <= FP_KERNEL_MULX_ADX; k++) {
+            if (fpkernel217_set(k) != 0) continue;
+            fp2mul217_mont(ma, mb, me); fp2sqr217_mont(ma, mf); 
+            from_fp2mont(me, e); from_fp2mont(mf, f);
+            if (compare_words((digit_t*)c, (digit_t*)e, 2*NWORDS_FIELD)!=0) { passed=0; break; }
+            if (compare_words((digit_t*)d, (digit_t*)f, 2*NWORDS_FIELD)!=0) { passed=0; break; }
+        }
+        if (passed == 0) break;
+    }
+    fpkernel217_set(level);
+    if (passed==1) printf("  GF(p^2) runtime kernel dispatch tests ........................... PASSED");
+    else { printf("  GF(p^2) runtime kernel dispatch tests... FAILED"); printf("\n"); return false; }
+    printf("\n");
+#endif
     
     // Inversion over GF(p217^2)
     passed = 1;
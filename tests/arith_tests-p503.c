@@ -304,6 +304,43 @@ bool fp2_test()
     else { printf("  GF(p^2) multiplication tests... FAILED"); printf("\n"); return false; }
     printf("\n");
 
+    // Sums and differences of products over GF(p503^2) with a single reduction, on random inputs and on inputs with components 
+    // p-1, 2p-1 (the largest accepted) or 0
+    {
+        const int modes[6][4] = { {0,0,0,0}, {1,1,1,1}, {2,2,2,2}, {2,2,0,2}, {3,0,2,2}, {0,2,2,3} };   // 0: random, 1: p-1, 2: 2p-1, 3: 0
+        f2elm_t* args[4] = {&ma, &mb, &mc, &md};
+        felm_t one = {1}, ext[4];
+
+        fpzero503(ext[2]); fpsub503(ext[2], one, ext[2]);                                // 2p-1
+        fpcopy503(ext[2], ext[1]); fpcorrection503(ext[1]);                              // p-1
+        fpzero503(ext[3]);
+        passed = 1;
+        for (n=0; n<TEST_LOOPS && passed==1; n++)
+        {
+            for (int k = 0; k < 6; k++) {
+                for (int i = 0; i < 4; i++) {
+                    if (modes[k][i] == 0) {
+                        fp2random503_test((digit_t*)a); to_fp2mont(a, *args[i]);
+                    } else {
+                        fpcopy503(ext[modes[k][i]], (*args[i])[0]); fpcopy503(ext[modes[k][i]], (*args[i])[1]);
+                    }
+                }
+                fp2mul503_mont(ma, mb, me); fp2mul503_mont(mc, md, mf); fp2add503(me, mf, me);   // e = a*b+c*d
+                fp2muladd503_mont(ma, mb, mc, md, mf);                                         // f = a*b+c*d
+                from_fp2mont(me, e); from_fp2mont(mf, f);
+                if (compare_words((digit_t*)e, (digit_t*)f, 2*NWORDS_FIELD)!=0) { passed=0; break; }
+
+                fp2mul503_mont(ma, mb, me); fp2mul503_mont(mc, md, mf); fp2sub503(me, mf, me);   // e = a*b-c*d
+                fp2mulsub503_mont(ma, mb, mc, md, mf);                                         // f = a*b-c*d
+                from_fp2mont(me, e); from_fp2mont(mf, f);
+                if (compare_words((digit_t*)e, (digit_t*)f, 2*NWORDS_FIELD)!=0) { passed=0; break; }
+            }
+        }
+    }
+    if (passed==1) printf("  GF(p^2) sum and difference of products tests .................... PASSED");
+    else { printf("  GF(p^2) sum and difference of products tests... FAILED"); printf("\n"); return false; }
+    printf("\n");
+
     // Squaring over GF(p503^2)
     passed = 1;
     for (n=0; n<TEST_LOOPS; n++)
@@ -325,6 +362,64 @@ bool fp2_test()
     if (passed==1) printf("  GF(p^2) squaring tests........................................... PASSED");
     else { printf("  GF(p^2) squaring tests... FAILED"); printf("\n"); return false; }
     printf("\n");
+
+#if defined(_AVX512_IFMA_)
+    // 8-way multiplication and squaring over GF(p503^2) using AVX-512 IFMA
+    passed = 1;
+    for (n=0; n<TEST_LOOPS; n++)
+    {
+        f2elm_t va[8], vb[8], vc[8], vd[8];
+
+        for (int i = 0; i < 8; i++) {
+            fp2random503_test((digit_t*)a); fp2random503_test((digit_t*)b);
+            to_fp2mont(a, va[i]); to_fp2mont(b, vb[i]);
+        }
+        fp2copy503(va[1], vb[1]);                                 // Include a squaring through the multiplication
+        fp2mul503_mont_x8(va, vb, vc);
+        for (int i = 0; i < 8; i++) {
+            fp2mul503_mont(va[i], vb[i], vd[i]);
+            from_fp2mont(vc[i], c); from_fp2mont(vd[i], d);
+            if (compare_words((digit_t*)c, (digit_t*)d, 2*NWORDS_FIELD)!=0) { passed=0; break; }
+        }
+        fp2sqr503_mont_x8(vb, vc);
+        for (int i = 0; i < 8; i++) {
+            fp2sqr503_mont(vb[i], vd[i]);
+            from_fp2mont(vc[i], c); from_fp2mont(vd[i], d);
+            if (compare_words((digit_t*)c, (digit_t*)d, 2*NWORDS_FIELD)!=0) { passed=0; break; }
+        }
+        if (passed == 0) break;
+    }
+    if (passed==1) printf("  GF(p^2) 8-way IFMA multiplication and squaring tests ............ PASSED");
+    else { printf("  GF(p^2) 8-way IFMA multiplication and squaring tests... FAILED"); printf("\n"); return false; }
+    printf("\n");
+#endif
+
+#if defined(_DISPATCH_)
+    // Runtime kernel dispatch: every kernel supported by the processor must agree with the portable one
+    passed = 1;
+    int level = fpkernel503_get();
+    for (n=0; n<TEST_LOOPS; n++)
+    {
+        fp2random503_test((digit_t*)a); fp2random503_test((digit_t*)b);
+        to_fp2mont(a, ma); to_fp2mont(b, mb);
+
+        fpkernel503_set(FP_KERNEL_GENERIC);
+        fp2mul503_mont(ma, mb, mc); fp2sqr503_mont(ma, md); 
+        from_fp2mont(mc, c); from_fp2mont(md, d);
+        for (int k = FP_KERNEL_MULX; k <= FP_KERNEL_MULX_ADX; k++) {
+            if (fpkernel503_set(k) != 0) continue;
+            fp2mul503_mont(ma, mb, me); fp2sqr503_mont(ma, mf); 
+            from_fp2mont(me, e); from_fp2mont(mf, f);
+            if (compare_words((digit_t*)c, (digit_t*)e, 2*NWORDS_FIELD)!=0) { passed=0; break; }
+            if (compare_words((digit_t*)d, (digit_t*)f, 2*NWORDS_FIELD)!=0) { passed=0; break; }
+        }
+        if (passed == 0) break;
+    }
+    fpkernel503_set(level);
+    if (passed==1) printf("  GF(p^2) runtime kernel dispatch tests ........................... PASSED");
+    else { printf("  GF(p^2) runtime kernel dispatch tests... FAILED"); printf("\n"); return false; }
+    printf("\n");
+#endif
     
     // Inversion over GF(p503^2)
     passed = 1;
@@ -472,6 +567,38 @@ bool fp2_run()
     printf("  GF(p^2) squaring runs in ........................................ %7lld ", cycles/BENCH_LOOPS); print_unit;
     printf("\n");
 
+#if defined(_AVX512_IFMA_)
+    // 8-way GF(p^2) multiplication using AVX-512 IFMA
+    {
+        f2elm_t va[8], vb[8], vc[8];
+
+        for (int i = 0; i < 8; i++) {
+            fp2random503_test((digit_t*)va[i]); fp2random503_test((digit_t*)vb[i]);
+        }
+        cycles = 0;
+        for (n=0; n<BENCH_LOOPS; n++)
+        {
+            cycles1 = cpucycles(); 
+            fp2mul503_mont_x8(va, vb, vc);
+            cycles2 = cpucycles();
+            cycles = cycles+(cycles2-cycles1);
+        }
+        printf("  GF(p^2) 8-way IFMA multiplication runs in ....................... %7lld ", cycles/BENCH_LOOPS); print_unit;
+        printf("\n");
+
+        cycles = 0;
+        for (n=0; n<BENCH_LOOPS; n++)
+        {
+            cycles1 = cpucycles(); 
+            fp2sqr503_mont_x8(va, vc);
+            cycles2 = cpucycles();
+            cycles = cycles+(cycles2-cycles1);
+        }
+        printf("  GF(p^2) 8-way IFMA squaring runs in ............................. %7lld ", cycles/BENCH_LOOPS); print_unit;
+        printf("\n");
+    }
+#endif
+
     // GF(p^2) inversion
     cycles = 0;
     for (n=0; n<SMALL_BENCH_LOOPS; n++)
@@ -0,0 +1,203 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: utility functions for benchmarking
+*
+* Samples are taken with the time-stamp counter (cpucycles()) or, with --perf on Linux, with the
+* user-space CPU cycle counter of perf_event_open, which is not affected by frequency scaling.
+* The process is pinned to one CPU so that all samples come from the same core.
+*********************************************************************************************/
+
+#if defined(__linux__)
+    #define _GNU_SOURCE
+    #include <sched.h>
+    #include <unistd.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <linux/perf_event.h>
+#endif
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test_extras.h"
+#include "bench_extras.h"
+
+
+static int perf_fd = -1;
+
+
+int bench_parse_args(int argc, char** argv, bench_config_t* config)
+{ // Parsing of [-n iterations] [-w warmup] [-c cpu] [--perf] [--json file]
+    int i;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i+1 < argc) {
+            config->iterations = (unsigned int)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-w") == 0 && i+1 < argc) {
+            config->warmup = (unsigned int)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-c") == 0 && i+1 < argc) {
+            config->cpu = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--perf") == 0) {
+            config->use_perf = 1;
+        } else if (strcmp(argv[i], "--json") == 0 && i+1 < argc) {
+            config->json = argv[++i];
+        } else {
+            fprintf(stderr, "Usage: %s [-n iterations] [-w warmup] [-c cpu] [--perf] [--json file]\n", argv[0]);
+            return -1;
+        }
+    }
+    return (config->iterations == 0) ? -1 : 0;
+}
+
+
+int bench_setup(bench_config_t* config)
+{ // Pinning to a CPU and opening of the cycle counter
+#if defined(__linux__)
+    cpu_set_t set;
+
+    if (config->cpu < 0) {
+        config->cpu = sched_getcpu();
+    }
+    CPU_ZERO(&set);
+    if (config->cpu >= 0 && config->cpu < CPU_SETSIZE) {
+        CPU_SET(config->cpu, &set);
+    }
+    if (CPU_COUNT(&set) == 0 || sched_setaffinity(0, sizeof(set), &set) != 0) {
+        fprintf(stderr, "Warning: could not pin to CPU %d\n", config->cpu);
+        config->cpu = -1;
+    }
+
+    if (config->use_perf) {
+        struct perf_event_attr attr;
+        uint64_t count;
+
+        memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CPU_CYCLES;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        perf_fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+        if (perf_fd >= 0 && (ioctl(perf_fd, PERF_EVENT_IOC_ENABLE, 0) != 0 || read(perf_fd, &count, sizeof(count)) != sizeof(count))) {
+            close(perf_fd);    // The counter cannot be read, the whole run uses the time-stamp counter
+            perf_fd = -1;
+        }
+        if (perf_fd < 0) {
+            fprintf(stderr, "Warning: perf_event_open is not available, using the time-stamp counter\n");
+            config->use_perf = 0;
+        }
+    }
+#else
+    config->cpu = -1;
+    config->use_perf = 0;
+#endif
+    return config->cpu;
+}
+
+
+uint64_t bench_counter(void)
+{ // Reading of the selected counter. The samples of a run all come from the same counter, so a failed read
+  // of the perf counter after a successful bench_setup() ends the run
+#if defined(__linux__)
+    if (perf_fd >= 0) {
+        uint64_t count = 0;
+
+        if (read(perf_fd, &count, sizeof(count)) != sizeof(count)) {
+            perror("Error: could not read the perf_event counter");
+            exit(EXIT_FAILURE);
+        }
+        return count;
+    }
+#endif
+    return (uint64_t)cpucycles();
+}
+
+
+const char* bench_counter_name(void)
+{
+    return (perf_fd >= 0) ? "perf_event" : "cpucycles";
+}
+
+
+const char* bench_unit(void)
+{
+#if (TARGET == TARGET_ARM || TARGET == TARGET_ARM64)
+    if (perf_fd < 0) return "nsec";
+#endif
+    return "cycles";
+}
+
+
+static int compare_samples(const void* a, const void* b)
+{
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+
+    return (x > y) - (x < y);
+}
+
+
+static double percentile(const uint64_t* sorted, const unsigned int n, const double p)
+{ // Nearest-rank percentile of sorted samples
+    unsigned int rank = (unsigned int)ceil(p*n);
+
+    if (rank == 0) rank = 1;
+    return (double)sorted[rank-1];
+}
+
+
+void bench_stats(const char* op, uint64_t* samples, unsigned int n, bench_stats_t* stats)
+{ // Computing the statistics of n samples, which are sorted in place
+    double sum = 0, var = 0;
+    unsigned int i;
+
+    qsort(samples, n, sizeof(uint64_t), compare_samples);
+    for (i = 0; i < n; i++) {
+        sum += (double)samples[i];
+    }
+    stats->op = op;
+    stats->n = n;
+    stats->mean = sum/n;
+    for (i = 0; i < n; i++) {
+        var += ((double)samples[i] - stats->mean)*((double)samples[i] - stats->mean);
+    }
+    stats->stddev = (n > 1) ? sqrt(var/(n-1)) : 0;
+    stats->median = (n % 2 == 1) ? (double)samples[n/2] : ((double)samples[n/2-1] + (double)samples[n/2])/2;
+    stats->p90 = percentile(samples, n, 0.90);
+    stats->p99 = percentile(samples, n, 0.99);
+    stats->min = (double)samples[0];
+    stats->max = (double)samples[n-1];
+}
+
+
+void bench_print(const bench_stats_t* stats)
+{ // Printing of the statistics as a table row
+    printf("  %-26s %12.0f %12.0f %12.0f %12.0f %10.0f  %s\n", stats->op, stats->median, stats->p90, stats->p99, stats->mean, stats->stddev, bench_unit());
+}
+
+
+int bench_write_json(const bench_config_t* config, const char* scheme, const bench_stats_t* stats, unsigned int nstats)
+{ // Writing of the results of a scheme in JSON format
+    FILE* f = (strcmp(config->json, "-") == 0) ? stdout : fopen(config->json, "w");
+    unsigned int i;
+
+    if (f == NULL) {
+        fprintf(stderr, "Error: could not open %s\n", config->json);
+        return -1;
+    }
+    fprintf(f, "{\n  \"scheme\": \"%s\",\n  \"counter\": \"%s\",\n  \"unit\": \"%s\",\n", scheme, bench_counter_name(), bench_unit());
+    fprintf(f, "  \"iterations\": %u,\n  \"warmup\": %u,\n  \"cpu\": %d,\n  \"results\": [\n", config->iterations, config->warmup, config->cpu);
+    for (i = 0; i < nstats; i++) {
+        fprintf(f, "    { \"op\": \"%s\", \"n\": %u, \"median\": %.0f, \"p90\": %.0f, \"p99\": %.0f, \"mean\": %.1f, \"stddev\": %.1f, \"min\": %.0f, \"max\": %.0f }%s\n",
+                stats[i].op, stats[i].n, stats[i].median, stats[i].p90, stats[i].p99, stats[i].mean, stats[i].stddev, stats[i].min, stats[i].max,
+                (i == nstats-1) ? "" : ",");
+    }
+    fprintf(f, "  ]\n}\n");
+    if (f != stdout) {
+        fclose(f);
+    }
+    return 0;
+}
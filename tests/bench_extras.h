@@ -0,0 +1,58 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: utility header file for benchmarking
+*********************************************************************************************/  
+
+#ifndef BENCH_EXTRAS_H
+#define BENCH_EXTRAS_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+
+// Statistics of the samples of one operation
+typedef struct {
+    const char* op;
+    unsigned int n;
+    double median, p90, p99, mean, stddev, min, max;
+} bench_stats_t;
+
+// Benchmark settings, as parsed from the command line by bench_parse_args()
+typedef struct {
+    unsigned int iterations;      // Number of measured runs per operation
+    unsigned int warmup;          // Number of unmeasured runs per operation
+    int cpu;                      // CPU to pin the benchmark to, or -1 for the CPU the process starts on
+    int use_perf;                 // Read cycles from perf_event_open instead of the time-stamp counter
+    const char* json;             // File the results are written to in JSON format, "-" for stdout, or NULL
+} bench_config_t;
+
+// Parsing of [-n iterations] [-w warmup] [-c cpu] [--perf] [--json file]. Returns 0 on success, -1 on invalid arguments
+int bench_parse_args(int argc, char** argv, bench_config_t* config);
+
+// Pinning to a CPU and opening of the cycle counter, which falls back to the time-stamp counter for the whole run if
+// the perf counter cannot be opened or read. Returns the CPU in use, or -1 if pinning is not available
+int bench_setup(bench_config_t* config);
+
+// Reading of the counter selected by bench_setup(). Exits if the perf counter can no longer be read
+uint64_t bench_counter(void);
+
+// Name of the counter and unit of the samples
+const char* bench_counter_name(void);
+const char* bench_unit(void);
+
+// Computing the statistics of n samples, which are sorted in place
+void bench_stats(const char* op, uint64_t* samples, unsigned int n, bench_stats_t* stats);
+
+// Printing of the statistics as a table row
+void bench_print(const bench_stats_t* stats);
+
+// Writing of the results of a scheme in JSON format. Returns 0 on success
+int bench_write_json(const bench_config_t* config, const char* scheme, const bench_stats_t* stats, unsigned int nstats);
+
+
+#endif
@@ -0,0 +1,20 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: micro-benchmarking of the arithmetic of p217
+*********************************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "test_extras.h"
+#include "../src/P217/P217.c"
+
+
+#define SCHEME_NAME       "p217"
+#define fp2random_test    fp2random217_test
+
+#include "bench_micro.c"
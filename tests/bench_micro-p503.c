@@ -0,0 +1,20 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: micro-benchmarking of the arithmetic of p503
+*********************************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "test_extras.h"
+#include "../src/P503/P503_compressed.c"
+
+
+#define SCHEME_NAME       "p503"
+#define fp2random_test    fp2random503_test
+
+#include "bench_micro.c"
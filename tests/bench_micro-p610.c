@@ -0,0 +1,20 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: micro-benchmarking of the arithmetic of p610
+*********************************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "test_extras.h"
+#include "../src/P610/P610_compressed.c"
+
+
+#define SCHEME_NAME       "p610"
+#define fp2random_test    fp2random610_test
+
+#include "bench_micro.c"
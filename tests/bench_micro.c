@@ -0,0 +1,225 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: micro-benchmarking of the field, curve, isogeny, pairing and discrete logarithm functions
+*
+* Usage: bench_micro-pXXX [-n iterations] [-w warmup] [-c cpu] [--perf] [--json file]
+*
+* The including file provides the parameter set (PXXX.c or PXXX_compressed.c), so that the static
+* functions of ec_isogeny.c and of the compression code can be measured, and fp2random_test.
+* Operands are kept in global memory and chained from one call to the next, and a compiler barrier
+* follows every call, so that the calls cannot be merged or moved out of the timed region.
+* Functions taking a few hundred cycles or less are run MICRO_REPS times per sample, and samples
+* are reported per call.
+*********************************************************************************************/
+
+#include <stdlib.h>
+#include "bench_extras.h"
+
+
+// Default benchmark parameters
+#define BENCH_ITERATIONS    1000
+#define BENCH_WARMUP         100
+#define BENCH_MAX_OPS         64
+#define MICRO_REPS           100       // Number of calls per sample for the field functions
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define BENCH_BARRIER()    __asm__ __volatile__("" ::: "memory")
+#else
+    #define BENCH_BARRIER()
+#endif
+
+#define MICRO_BENCH(name, reps, stmt)                                                                  \
+    do {                                                                                               \
+        for (i = 0; i < config.warmup; i++) {                                                          \
+            stmt; BENCH_BARRIER();                                                                     \
+        }                                                                                              \
+        for (i = 0; i < config.iterations; i++) {                                                      \
+            t0 = bench_counter();                                                                      \
+            for (r = 0; r < (reps); r++) {                                                             \
+                stmt; BENCH_BARRIER();                                                                 \
+            }                                                                                          \
+            samples[i] = (bench_counter() - t0)/(reps);                                                \
+        }                                                                                              \
+        bench_stats(name, samples, config.iterations, &stats[nstats++]);                               \
+    } while (0)
+
+
+// Operands
+felm_t fa, fb, fc;
+dfelm_t fd;
+f2elm_t ea, eb, ec, A, A24plus, A24minus, C24, coeff[5], XPA, XQA, XRA, XPB, XQB, XRB;
+point_proj_t P, Q, S;
+digit_t SecretKeyA[NWORDS_ORDER], SecretKeyB[NWORDS_ORDER];
+#if defined(_AVX512_IFMA_)
+f2elm_t va[8], vb[8];
+#endif
+#if defined(COMPRESS)
+unsigned char skA[SECRETKEY_A_BYTES], skB[SECRETKEY_B_BYTES], qnr, ind, bit;
+unsigned int rs[3];
+int D[DLEN_2 > DLEN_3 ? DLEN_2 : DLEN_3];
+digit_t d0[NWORDS_ORDER];
+f2elm_t a24, AB, As[MAX_Alice+1][5], Ds[MAX_Bob][2], f3[4], f2[4];
+point_full_proj_t Rs3[2], Rs2[2], Rs3_[2], Rs2_[2];
+point_proj_t Xs[3], pts[MAX_INT_POINTS_ALICE > MAX_INT_POINTS_BOB ? MAX_INT_POINTS_ALICE : MAX_INT_POINTS_BOB];
+point_t Pw, Qw;
+f2elm_t T[PAIRING_WORKSPACE];
+felm_t prods[PH2_DLOG_PRODS];
+#endif
+
+
+static void init_operands(void)
+{ // Random field elements and points, and the starting curve with the public basis points
+    unsigned char sk[SECRETKEY_B_BYTES > SECRETKEY_A_BYTES ? SECRETKEY_B_BYTES : SECRETKEY_A_BYTES] = {0};
+    f2elm_t two = {0};
+
+    fp2random_test((digit_t*)ea); fp2random_test((digit_t*)eb); fp2random_test((digit_t*)ec);
+    fpcopy(ea[0], fa); fpcopy(eb[0], fb); fpcopy(ec[0], fc);
+    fp2random_test((digit_t*)P->X); fp2random_test((digit_t*)P->Z);
+    fp2random_test((digit_t*)Q->X); fp2random_test((digit_t*)Q->Z);
+    fp2random_test((digit_t*)S->X); fp2random_test((digit_t*)S->Z);
+    fp2random_test((digit_t*)A24plus); fp2random_test((digit_t*)A24minus); fp2random_test((digit_t*)C24);
+    for (unsigned int k = 0; k < 5; k++) fp2random_test((digit_t*)coeff[k]);
+#if defined(_AVX512_IFMA_)
+    for (unsigned int k = 0; k < 8; k++) { fp2random_test((digit_t*)va[k]); fp2random_test((digit_t*)vb[k]); }
+#endif
+
+    // A = 6
+    fpcopy((digit_t*)&Montgomery_one, two[0]);
+    fp2add(two, two, two);
+    fp2add(two, two, A);
+    fp2add(two, A, A);
+
+    random_mod_order_A(sk);
+    decode_to_digits(sk, SecretKeyA, SECRETKEY_A_BYTES, NWORDS_ORDER);
+    random_mod_order_B(sk);
+    decode_to_digits(sk, SecretKeyB, SECRETKEY_B_BYTES, NWORDS_ORDER);
+    init_basis((digit_t*)A_gen, XPA, XQA, XRA);
+    init_basis((digit_t*)B_gen, XPB, XQB, XRB);
+
+#if defined(COMPRESS)
+    // Inputs of the torsion basis generation, pairings and discrete logarithms, from the isogenies of random keys
+    random_mod_order_A(skA);
+    random_mod_order_B(skB);
+    FullIsogeny_A_dual(skA, As, a24, 0, pts);
+    FullIsogeny_B_dual(skB, Ds, AB, pts);
+    BuildOrdinary3nBasis_dual(a24, (const f2elm_t(*)[5])As, Rs3, rs, &rs[2]);
+    BuildOrdinary2nBasis_dual(AB, (const f2elm_t(*)[2])Ds, Rs2, &qnr, &ind);
+    fpadd((digit_t*)Montgomery_one, (Rs2[0]->X)[0], (Rs2[0]->X)[0]);
+    fpadd((digit_t*)Montgomery_one, (Rs2[0]->X)[0], (Rs2[0]->X)[0]);
+    fpadd((digit_t*)Montgomery_one, (Rs2[1]->X)[0], (Rs2[1]->X)[0]);
+    fpadd((digit_t*)Montgomery_one, (Rs2[1]->X)[0], (Rs2[1]->X)[0]);
+    fpcopy((digit_t*)A_basis_zero + 0*NWORDS_FIELD, Pw->x[0]);
+    fpcopy((digit_t*)A_basis_zero + 1*NWORDS_FIELD, Pw->x[1]);
+    fpcopy((digit_t*)A_basis_zero + 2*NWORDS_FIELD, Pw->y[0]);
+    fpcopy((digit_t*)A_basis_zero + 3*NWORDS_FIELD, Pw->y[1]);
+    fpcopy((digit_t*)A_basis_zero + 4*NWORDS_FIELD, Qw->x[0]);
+    fpcopy((digit_t*)A_basis_zero + 5*NWORDS_FIELD, Qw->x[1]);
+    fpcopy((digit_t*)A_basis_zero + 6*NWORDS_FIELD, Qw->y[0]);
+    fpcopy((digit_t*)A_basis_zero + 7*NWORDS_FIELD, Qw->y[1]);
+    memcpy(Rs3_, Rs3, sizeof(Rs3));
+    memcpy(Rs2_, Rs2, sizeof(Rs2));
+    Tate3_pairings(Rs3_, f3, T);
+    Tate2_pairings(Pw, Qw, Rs2_, f2, T);
+    fp2correction(f2[0]);
+#endif
+}
+
+
+int main(int argc, char **argv)
+{
+    bench_config_t config = { BENCH_ITERATIONS, BENCH_WARMUP, -1, 0, NULL };
+    bench_stats_t stats[BENCH_MAX_OPS];
+    uint64_t *samples, t0;
+    unsigned int i, r, k, nstats = 0;
+
+    if (bench_parse_args(argc, argv, &config) != 0) {
+        return FAILED;
+    }
+    bench_setup(&config);
+    samples = (uint64_t*)malloc(config.iterations*sizeof(uint64_t));
+    if (samples == NULL) return FAILED;
+    init_operands();
+
+    // Field arithmetic
+    MICRO_BENCH("fpadd", MICRO_REPS, fpadd(fa, fb, fa));
+    MICRO_BENCH("fpsub", MICRO_REPS, fpsub(fa, fb, fa));
+#if ((OS_TARGET == OS_WIN) || defined(GENERIC_IMPLEMENTATION)) && (NBITS_FIELD != 217)    // Fused into fpmul_mont otherwise
+    MICRO_BENCH("mp_mul", MICRO_REPS, mp_mul(fa, fb, fd, NWORDS_FIELD));
+    MICRO_BENCH("rdc_mont", MICRO_REPS, rdc_mont(fd, fc));
+#endif
+    MICRO_BENCH("fpmul_mont", MICRO_REPS, fpmul_mont(fa, fb, fa));
+    MICRO_BENCH("fpsqr_mont", MICRO_REPS, fpsqr_mont(fa, fa));
+    MICRO_BENCH("fpinv_mont", 1, fpinv_mont(fa));
+#if defined(COMPRESS)
+    MICRO_BENCH("fpinv_mont_bingcd", 1, fpinv_mont_bingcd(fa));
+#endif
+    MICRO_BENCH("fp2add", MICRO_REPS, fp2add(ea, eb, ea));
+    MICRO_BENCH("fp2sub", MICRO_REPS, fp2sub(ea, eb, ea));
+    MICRO_BENCH("fp2mul_mont", MICRO_REPS, fp2mul_mont(ea, eb, ea));
+    MICRO_BENCH("fp2muladd_mont", MICRO_REPS, fp2muladd_mont(ea, eb, ec, eb, ea));
+    MICRO_BENCH("fp2mulsub_mont", MICRO_REPS, fp2mulsub_mont(ea, eb, ec, eb, ea));
+    MICRO_BENCH("fp2sqr_mont", MICRO_REPS, fp2sqr_mont(ea, ea));
+    MICRO_BENCH("fp2inv_mont", 1, fp2inv_mont(ea));
+#if defined(COMPRESS)
+    MICRO_BENCH("fp2inv_mont_bingcd", 1, fp2inv_mont_bingcd(ea));
+#endif
+#if defined(_AVX512_IFMA_)
+    MICRO_BENCH("fp2mul_mont_x8", MICRO_REPS, fp2mul_mont_x8((const f2elm_t*)va, (const f2elm_t*)vb, va));
+    MICRO_BENCH("fp2sqr_mont_x8", MICRO_REPS, fp2sqr_mont_x8((const f2elm_t*)va, va));
+#endif
+
+    // Curve and isogeny arithmetic
+    MICRO_BENCH("xDBL", MICRO_REPS, xDBL(P, P, A24plus, C24));
+    MICRO_BENCH("xDBLADD", MICRO_REPS, xDBLADD(P, Q, S->X, S->Z, A24plus));
+    MICRO_BENCH("xTPL", MICRO_REPS, xTPL(P, P, A24minus, A24plus));
+#if (OALICE_BITS % 2 == 1)
+    MICRO_BENCH("get_2_isog", MICRO_REPS, get_2_isog(P, A24plus, C24));
+    MICRO_BENCH("eval_2_isog", MICRO_REPS, eval_2_isog(Q, P));
+#endif
+    MICRO_BENCH("get_4_isog", MICRO_REPS, get_4_isog(P, A24plus, C24, coeff));
+    MICRO_BENCH("eval_4_isog", MICRO_REPS, eval_4_isog(Q, coeff));
+    MICRO_BENCH("get_3_isog", MICRO_REPS, get_3_isog(P, A24minus, A24plus, coeff));
+    MICRO_BENCH("eval_3_isog", MICRO_REPS, eval_3_isog(Q, (const f2elm_t*)coeff));
+    MICRO_BENCH("inv_3_way", 1, inv_3_way(ea, eb, ec));
+    MICRO_BENCH("get_A", 1, get_A(XPA, XQA, XRA, ec));
+    MICRO_BENCH("j_inv", 1, j_inv(A24plus, C24, ec));
+#if !defined(COMPRESS) && defined(SIDH_FIXED_BASE)
+    MICRO_BENCH("LADDER3PT_fixed_A", 1, LADDER3PT_fixed((digit_t*)A_gen, (digit_t*)A_gen_dbl, SecretKeyA, ALICE, &P, 1));
+    MICRO_BENCH("LADDER3PT_fixed_B", 1, LADDER3PT_fixed((digit_t*)B_gen, (digit_t*)B_gen_dbl, SecretKeyB, BOB, &P, 1));
+#else
+    MICRO_BENCH("LADDER3PT_A", 1, LADDER3PT(XPA, XQA, XRA, SecretKeyA, ALICE, P, A));
+    MICRO_BENCH("LADDER3PT_B", 1, LADDER3PT(XPB, XQB, XRB, SecretKeyB, BOB, P, A));
+#endif
+
+#if defined(COMPRESS)
+    // Torsion basis generation, pairings and discrete logarithms of the public key compression
+    MICRO_BENCH("Elligator2", 1, Elligator2(a24, 0, ec, &bit, COMPRESSION));
+    MICRO_BENCH("BuildOrdinary3nBasis_dual", 1, BuildOrdinary3nBasis_dual(a24, (const f2elm_t(*)[5])As, Rs3_, rs, &rs[2]));
+    MICRO_BENCH("BuildEntangledXonly", 1, BuildEntangledXonly(AB, Xs, &qnr, &ind));
+    MICRO_BENCH("BuildOrdinary2nBasis_dual", 1, BuildOrdinary2nBasis_dual(AB, (const f2elm_t(*)[2])Ds, Rs2_, &qnr, &ind));
+    MICRO_BENCH("Tate3_pairings", 1, memcpy(Rs3_, Rs3, sizeof(Rs3)); Tate3_pairings(Rs3_, f3, T));
+    MICRO_BENCH("Tate2_pairings", 1, memcpy(Rs2_, Rs2, sizeof(Rs2)); Tate2_pairings(Pw, Qw, Rs2_, f2, T));
+    fp2correction(f2[0]);
+    MICRO_BENCH("solve_dlog_2", 1, solve_dlog(f2[0], D, d0, 2, prods));
+    MICRO_BENCH("solve_dlog_3", 1, solve_dlog(f3[0], D, d0, 3, NULL));
+#endif
+
+    printf("\nMICRO-BENCHMARKING OF THE ARITHMETIC OF %s\n", SCHEME_NAME);
+    printf("%u iterations after %u warm-up runs, counter %s, CPU %d\n", config.iterations, config.warmup, bench_counter_name(), config.cpu);
+    printf("--------------------------------------------------------------------------------------------------------\n");
+    printf("  %-26s %12s %12s %12s %12s %10s\n", "", "median", "p90", "p99", "mean", "stddev");
+    for (k = 0; k < nstats; k++) {
+        bench_print(&stats[k]);
+    }
+
+    if (config.json != NULL && bench_write_json(&config, SCHEME_NAME, stats, nstats) != 0) {
+        return FAILED;
+    }
+    free(samples);
+    return PASSED;
+}
@@ -0,0 +1,89 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: benchmarking of the isogeny-based key encapsulation mechanism
+*
+* Usage: bench_SIKE [-n iterations] [-w warmup] [-c cpu] [--perf] [--json file]
+*********************************************************************************************/ 
+
+#include <stdlib.h>
+#include "bench_extras.h"
+
+
+// Default benchmark parameters
+#define BENCH_ITERATIONS    100
+#define BENCH_WARMUP         10
+#define BENCH_OPS             3
+
+
+int main(int argc, char **argv)
+{
+    bench_config_t config = { BENCH_ITERATIONS, BENCH_WARMUP, -1, 0, NULL };
+    unsigned char sk[CRYPTO_SECRETKEYBYTES] = {0};
+    unsigned char pk[CRYPTO_PUBLICKEYBYTES] = {0};
+    unsigned char ct[CRYPTO_CIPHERTEXTBYTES] = {0};
+    unsigned char ss[CRYPTO_BYTES] = {0};
+    unsigned char ss_[CRYPTO_BYTES] = {0};
+    bench_stats_t stats[BENCH_OPS];
+    uint64_t *samples[BENCH_OPS], t0, t1, t2, t3;
+    unsigned int i, k;
+
+    if (bench_parse_args(argc, argv, &config) != 0) {
+        return FAILED;
+    }
+    bench_setup(&config);
+    for (k = 0; k < BENCH_OPS; k++) {
+        samples[k] = (uint64_t*)malloc(config.iterations*sizeof(uint64_t));
+        if (samples[k] == NULL) return FAILED;
+    }
+
+    for (i = 0; i < config.warmup; i++) 
+    {
+        crypto_kem_keypair(pk, sk);
+        crypto_kem_enc(ct, ss, pk);
+        crypto_kem_dec(ss_, ct, sk);
+    }
+
+    for (i = 0; i < config.iterations; i++) 
+    {
+        t0 = bench_counter();
+        crypto_kem_keypair(pk, sk);
+        t1 = bench_counter();
+        crypto_kem_enc(ct, ss, pk);
+        t2 = bench_counter();
+        crypto_kem_dec(ss_, ct, sk);
+        t3 = bench_counter();
+
+        if (memcmp(ss, ss_, CRYPTO_BYTES) != 0) {
+            printf("\n\n   Error detected: KEM_ERROR_SHARED_KEY \n\n");
+            return FAILED;
+        }
+        samples[0][i] = t1 - t0;
+        samples[1][i] = t2 - t1;
+        samples[2][i] = t3 - t2;
+    }
+
+    bench_stats("keygen", samples[0], config.iterations, &stats[0]);
+    bench_stats("encaps", samples[1], config.iterations, &stats[1]);
+    bench_stats("decaps", samples[2], config.iterations, &stats[2]);
+
+    printf("\nBENCHMARKING ISOGENY-BASED KEY ENCAPSULATION MECHANISM %s\n", SCHEME_NAME);
+    printf("%u iterations after %u warm-up runs, counter %s, CPU %d\n", config.iterations, config.warmup, bench_counter_name(), config.cpu);
+    printf("--------------------------------------------------------------------------------------------------------\n");
+    printf("  %-26s %12s %12s %12s %12s %10s\n", "", "median", "p90", "p99", "mean", "stddev");
+    for (k = 0; k < BENCH_OPS; k++) {
+        bench_print(&stats[k]);
+    }
+
+    if (config.json != NULL && bench_write_json(&config, SCHEME_NAME, stats, BENCH_OPS) != 0) {
+        return FAILED;
+    }
+    for (k = 0; k < BENCH_OPS; k++) {
+        free(samples[k]);
+    }
+    return PASSED;
+}
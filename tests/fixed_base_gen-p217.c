@@ -0,0 +1,17 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: generation of the precomputed multiples of the generators of SIDHp217
+*********************************************************************************************/
+
+#include "../src/P217/P217.c"
+
+
+#define SCHEME_NAME          "SIDHp217"
+#define PRIME_NAME           "p217"
+
+#include "fixed_base_gen.c"
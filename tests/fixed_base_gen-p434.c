@@ -0,0 +1,17 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: generation of the precomputed multiples of the generators of SIDHp434
+*********************************************************************************************/
+
+#include "../src/P434/P434.c"
+
+
+#define SCHEME_NAME          "SIDHp434"
+#define PRIME_NAME           "p434"
+
+#include "fixed_base_gen.c"
@@ -0,0 +1,17 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: generation of the precomputed multiples of the generators of SIDHp503
+*********************************************************************************************/
+
+#include "../src/P503/P503.c"
+
+
+#define SCHEME_NAME          "SIDHp503"
+#define PRIME_NAME           "p503"
+
+#include "fixed_base_gen.c"
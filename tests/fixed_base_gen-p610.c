@@ -0,0 +1,17 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: generation of the precomputed multiples of the generators of SIDHp610
+*********************************************************************************************/
+
+#include "../src/P610/P610.c"
+
+
+#define SCHEME_NAME          "SIDHp610"
+#define PRIME_NAME           "p610"
+
+#include "fixed_base_gen.c"
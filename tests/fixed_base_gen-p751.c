@@ -0,0 +1,17 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: generation of the precomputed multiples of the generators of SIDHp751
+*********************************************************************************************/
+
+#include "../src/P751/P751.c"
+
+
+#define SCHEME_NAME          "SIDHp751"
+#define PRIME_NAME           "p751"
+
+#include "fixed_base_gen.c"
@@ -0,0 +1,81 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: generation of the precomputed multiples of the generators for the fixed-base ladder
+*           Requires SCHEME_NAME and PRIME_NAME, and the library source included by the caller
+*********************************************************************************************/
+
+#include <stdio.h>
+
+#if (RADIX != 64)
+    #error -- "The tables are written as 64-bit words"
+#endif
+
+
+static void print_felm(const felm_t a, const char* end)
+{ // Print a field element as 64-bit words, 4 per line
+    unsigned int i;
+
+    for (i = 0; i < NWORDS_FIELD; i++) {
+        printf("%s0x%016llX%s", (i % 4 == 0) ? "    " : " ", (unsigned long long)a[i], 
+               (i == NWORDS_FIELD-1) ? end : ((i % 4 == 3) ? ",\n" : ","));
+    }
+}
+
+
+static void print_table(const char* name, const char* size, const char* comment, const digit_t* gen, const int nbits)
+{ // Print the affine x-coordinates of 2^i*Q, i = 0, ..., nbits-1, for the generators gen = {xP, xQ, xPQ} on E0: y^2 = x^3 + 6x^2 + x
+    point_proj_t Q;
+    f2elm_t A24plus = {0}, C24 = {0}, t, x;
+    int i;
+
+    fpcopy(gen + 2*NWORDS_FIELD, Q->X[0]);
+    fpcopy(gen + 3*NWORDS_FIELD, Q->X[1]);
+    fpcopy((digit_t*)&Montgomery_one, Q->Z[0]);
+    fpzero(Q->Z[1]);
+
+    // A24plus = A+2C = 8, C24 = 4C = 4
+    fpcopy((digit_t*)&Montgomery_one, C24[0]);
+    mp2_add(C24, C24, C24);
+    mp2_add(C24, C24, C24);
+    mp2_add(C24, C24, A24plus);
+
+    printf("// %s\n", comment);
+    printf("const uint64_t %s[2*(%s)*NWORDS64_FIELD] = {\n", name, size);
+    for (i = 0; i < nbits; i++) {
+        fp2copy(Q->Z, t);
+        fp2inv_mont(t);
+        fp2mul_mont(Q->X, t, x);
+        fp2correction(x);
+        print_felm(x[0], ",\n");
+        print_felm(x[1], (i == nbits-1) ? " };\n" : ",\n");
+        xDBL(Q, Q, A24plus, C24);
+    }
+}
+
+
+int main(void)
+{
+    printf("/********************************************************************************************\n");
+    printf("* SIDH: an efficient supersingular isogeny cryptography library\n");
+    printf("* Copyright (c) Microsoft Corporation\n");
+    printf("*\n");
+    printf("* Website: https://github.com/microsoft/PQCrypto-SIDH\n");
+    printf("* Released under MIT license\n");
+    printf("*\n");
+    printf("* Abstract: precomputed multiples of the generators of %s for fixed-base key generation\n", SCHEME_NAME);
+    printf("*           Generated by fixed_base_gen-%s, used if SIDH_FIXED_BASE is defined\n", PRIME_NAME);
+    printf("*********************************************************************************************/\n\n");
+
+    print_table("A_gen_dbl", "OALICE_BITS", "Affine x-coordinates x(2^i*QA), i = 0, ..., OALICE_BITS-1, in GF(p^2), expressed in Montgomery representation", 
+                (digit_t*)A_gen, OALICE_BITS);
+    printf("\n");
+    print_table("B_gen_dbl", "OBOB_BITS-1", "Affine x-coordinates x(2^i*QB), i = 0, ..., OBOB_BITS-2, in GF(p^2), expressed in Montgomery representation", 
+                (digit_t*)B_gen, OBOB_BITS-1);
+
+    return 0;
+}
@@ -0,0 +1,177 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: depth-first enumeration of isogeny trees for the meet-in-the-middle search
+*
+* Requires isogeny_walks.c.
+*********************************************************************************************/
+
+
+// Leaf callback of walk_tree(): DFS index and kernel scalar of the leaf and j-invariant of its curve
+typedef void (*walk_leaf_t)(void* ctx, uint64_t index, uint64_t k, const f2elm_t j);
+
+// Node of an isogeny tree: curve (A24plus:C24) for ell = 2 or (A24minus:A24plus) for ell = 3, and basis {P,Q} of E[ell^r]
+typedef struct {
+    f2elm_t c0, c1;
+    point_proj_t P, Q, PQ;
+} walk_node_t;
+
+// Traversal of an isogeny tree
+typedef struct {
+    unsigned int ell, step, arity;            // One level is a 4-isogeny (step 2, arity 4) or a 3-isogeny (step 1, arity 3)
+    uint64_t first, end;                      // Range of DFS indices of the enumerated leaves
+    walk_leaf_t leaf;
+    void* ctx;
+} walk_tree_t;
+
+
+static void walk_xADD(const point_proj_t P, const point_proj_t Q, const point_proj_t PQ, point_proj_t R)
+{ // Differential addition R = P+Q, given P-Q. R may be equal to P
+    f2elm_t t0, t1, t2;
+
+    fp2add(P->X, P->Z, t0);
+    fp2sub(P->X, P->Z, t1);
+    fp2sub(Q->X, Q->Z, t2);
+    fp2mul_mont(t0, t2, t0);                          // t0 = (XP+ZP)*(XQ-ZQ)
+    fp2add(Q->X, Q->Z, t2);
+    fp2mul_mont(t1, t2, t1);                          // t1 = (XP-ZP)*(XQ+ZQ)
+    fp2add(t0, t1, t2);
+    fp2sub(t0, t1, t0);
+    fp2sqr_mont(t2, t2);
+    fp2sqr_mont(t0, t0);
+    fp2mul_mont(PQ->Z, t2, t1);
+    fp2mul_mont(PQ->X, t0, R->Z);
+    fp2copy(t1, R->X);
+}
+
+
+static void walk_tree_node(const walk_tree_t* tree, const walk_node_t* node, unsigned int r, uint64_t size, uint64_t index, uint64_t k, uint64_t scale)
+{ // Enumeration of the leaves of the subtree of a node with size leaves, the first of which has the DFS index index.
+  // The child c of a node with basis {P,Q} is the isogeny with kernel [ell^(r-step)](P+c*Q), with the basis {P',Q'} =
+  // {phi(P+c*Q), phi(arity*Q)}, so that the leaf of P+k*Q has the scalar k = c_0 + arity*c_1 + arity^2*c_2 + ...
+    unsigned int n = tree->arity, c, i;
+    uint64_t child_size = size/n;
+    point_proj_t T[8], nQ, K;                         // T[i] = P+(i-n)*Q
+    f2elm_t coeff[3], j, A;
+    walk_node_t child;
+
+    if (index >= tree->end || index + size <= tree->first) return;
+
+    fp2copy(node->P->X, T[n]->X);
+    fp2copy(node->P->Z, T[n]->Z);
+    fp2copy(node->PQ->X, T[n-1]->X);
+    fp2copy(node->PQ->Z, T[n-1]->Z);
+    for (i = n; i < 2*n - 1; i++) {
+        walk_xADD(T[i], node->Q, T[i-1], T[i+1]);
+    }
+    if (r > tree->step) {
+        for (i = n - 1; i > 0; i--) {
+            walk_xADD(T[i], node->Q, T[i+1], T[i-1]);
+        }
+        if (tree->ell == 2) {
+            xDBLe(node->Q, nQ, node->c0, node->c1, 2);
+        } else {
+            xTPL(node->Q, nQ, node->c0, node->c1);
+        }
+    }
+
+    for (c = 0; c < n; c++) {
+        if (index + c*child_size >= tree->end || index + (c + 1)*child_size <= tree->first) continue;
+        fp2copy(node->c0, child.c0);
+        fp2copy(node->c1, child.c1);
+        if (tree->ell == 2) {
+            xDBLe(T[n+c], K, child.c0, child.c1, (int)(r - 2));
+            get_4_isog(K, child.c0, child.c1, coeff);
+        } else {
+            xTPLe(T[n+c], K, child.c0, child.c1, (int)(r - 1));
+            get_3_isog(K, child.c0, child.c1, coeff);
+        }
+
+        if (r == tree->step) {
+            if (tree->ell == 2) {
+                walk_j(child.c0, child.c1, j);
+            } else {
+                fp2add(child.c0, child.c1, A);
+                fp2add(A, A, A);                      // 4*A = 2*(A24plus+A24minus)
+                fp2sub(child.c1, child.c0, child.c1); // 4*C = A24plus-A24minus
+                j_inv(A, child.c1, j);
+                fp2correction(j);
+            }
+            tree->leaf(tree->ctx, index + c, k + c*scale, j);
+            continue;
+        }
+
+        fp2copy(T[n+c]->X, child.P->X);
+        fp2copy(T[n+c]->Z, child.P->Z);
+        fp2copy(nQ->X, child.Q->X);
+        fp2copy(nQ->Z, child.Q->Z);
+        fp2copy(T[c]->X, child.PQ->X);
+        fp2copy(T[c]->Z, child.PQ->Z);
+        if (tree->ell == 2) {
+            eval_4_isog(child.P, coeff);
+            eval_4_isog(child.Q, coeff);
+            eval_4_isog(child.PQ, coeff);
+        } else {
+            eval_3_isog(child.P, coeff);
+            eval_3_isog(child.Q, coeff);
+            eval_3_isog(child.PQ, coeff);
+        }
+        walk_tree_node(tree, &child, r - tree->step, child_size, index + c*child_size, k + c*scale, scale*n);
+    }
+}
+
+
+static int walk_tree(const walk_side_t* root, unsigned int ell, unsigned int d, uint64_t first, uint64_t count, walk_leaf_t leaf, void* ctx)
+{ // Depth-first enumeration of the ell^d curves E/<P+k*Q>, 0 <= k < ell^d, for the curve E and the basis {P,Q} of E[ell^d]
+  // of root (with [2^(d-1)]Q = (0,0) for ell = 2). The tree has d/2 levels of 4-isogenies (ell = 2, d even) or d levels
+  // of 3-isogenies (ell = 3), and each node passes its curve and the images of its basis points to its children, so that
+  // a leaf costs a constant number of isogeny evaluations instead of the O(d^2) operations of walk_curve(). Only the
+  // leaves with DFS indices in [first, first+count) are enumerated, and leaf() is called on each of them in DFS order.
+  // The DFS index of the leaf of k is obtained by reversing the digits of k in base 4 (ell = 2) or 3 (ell = 3).
+  // Returns 0 on invalid parameters
+    walk_tree_t tree;
+    walk_node_t node;
+    f2elm_t two = {0}, j;
+    uint64_t size = 1;
+    unsigned int i;
+
+    if ((ell != 2 || (d & 1) != 0 || d > 62) && (ell != 3 || d > 40)) return 0;
+    for (i = 0; i < d; i++) size *= ell;
+    tree.ell = ell;
+    tree.step = (ell == 2) ? 2 : 1;
+    tree.arity = (ell == 2) ? 4 : 3;
+    tree.first = first;
+    tree.end = (count > size - first || first > size) ? size : first + count;
+    tree.leaf = leaf;
+    tree.ctx = ctx;
+
+    fpcopy((digit_t*)&Montgomery_one, two[0]);
+    fp2add(two, two, two);
+    if (ell == 2) {
+        fp2add(root->A, two, node.c0);               // A24plus = A+2
+        fp2add(two, two, node.c1);                   // C24 = 4
+    } else {
+        fp2sub(root->A, two, node.c0);               // A24minus = A-2
+        fp2add(root->A, two, node.c1);               // A24plus = A+2
+    }
+    if (d == 0) {
+        if (first == 0 && count > 0) {
+            fp2copy(root->A, j);
+            fp2zero(two);
+            fpcopy((digit_t*)&Montgomery_one, two[0]);
+            j_inv(j, two, j);
+            fp2correction(j);
+            leaf(ctx, 0, 0, j);
+        }
+        return 1;
+    }
+    walk_point(root->xP, node.P);
+    walk_point(root->xQ, node.Q);
+    walk_point(root->xPQ, node.PQ);
+    walk_tree_node(&tree, &node, d, size, 0, 0, 1);
+    return 1;
+}
@@ -0,0 +1,451 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: reduced SIDH instances and isogeny walks for the collision search tools
+*
+* An instance is a secret 2^e-isogeny phi: E0 -> EA of even length e = 2m, computed as in EphemeralKeyGeneration_A()
+* from the kernel <[2^(eA-e)](PA+sk*QA)>. The attacker knows E0, EA and bases of E0[2^m] and EA[2^m], and phi factors
+* through a middle curve Emid reached by a 2^m-isogeny from either side. A walk point x in [0, 2^(m+1)) selects a side
+* (the top bit) and a kernel <P+k*Q> of order 2^m on that side, and walk_curve() computes the j-invariant of the
+* codomain with m/2 4-isogenies from ec_isogeny.c, so that the secret is recovered from a pair of walk points with
+* equal j-invariants on opposite sides.
+* The 4-isogeny formulas require kernels that do not lie above (0,0). Public curves are output in a model where the
+* dual of the last isogeny lies above (0,0), so the model of EA is changed to move another point of order 2 to the
+* origin, and on both sides the basis is ordered such that [2^(m-1)]Q = (0,0). The kernels <P+k*Q> are then exactly
+* the 2^m kernels that do not lie above (0,0), which include the kernels of both halves of phi.
+*********************************************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+
+
+#define WALK_MAX_M        30                          // Walk points fit in 32 bits
+#define WALK_DIGITS       ((64 + RADIX - 1)/RADIX)    // Number of digits of a 64-bit scalar
+
+// Starting curve and basis of E[2^m] of one side of a walk
+typedef struct {
+    f2elm_t A;                                        // Montgomery coefficient
+    f2elm_t A24;                                      // (A+2)/4
+    f2elm_t xP, xQ, xPQ;                              // Affine x-coordinates of P, Q and P-Q, with [2^(m-1)]Q = (0,0)
+} walk_side_t;
+
+// Reduced SIDH instance
+typedef struct {
+    unsigned int e, m;                                // Length e = 2m of the secret isogeny
+    uint64_t sk;                                      // Secret scalar of the kernel
+    walk_side_t side[2];                              // Side 0 starts at E0, side 1 at the public curve EA
+    f2elm_t jmid;                                     // j-invariant of the middle curve, only used to check results
+} walk_instance_t;
+
+
+static void walk_digits(uint64_t k, digit_t* d, unsigned int nwords)
+{ // Conversion of a 64-bit scalar to nwords >= WALK_DIGITS digits
+    unsigned int i;
+
+    for (i = 0; i < nwords; i++) {
+        d[i] = (i < WALK_DIGITS) ? (digit_t)(k >> ((i*RADIX) & 63)) : 0;
+    }
+}
+
+
+static int fp2_equal(const f2elm_t a, const f2elm_t b)
+{ // Non-constant-time comparison of two elements of GF(p^2)
+    f2elm_t t, u;
+
+    fp2copy(a, t);
+    fp2copy(b, u);
+    fp2correction(t);
+    fp2correction(u);
+    return memcmp(t, u, sizeof(f2elm_t)) == 0;
+}
+
+
+static void fp_sqrt(const felm_t a, felm_t r)
+{ // Square root r = a^((p+1)/4) of a square a in GF(p), with (p+1)/4 = 2^(eA-2)*3^eB
+    felm_t t;
+
+    fpcopy(a, r);
+    for (unsigned int i = 0; i < OBOB_EXPON; i++) {
+        fpsqr_mont(r, t);
+        fpmul_mont(r, t, r);
+    }
+    for (unsigned int i = 0; i < OALICE_BITS - 2; i++) {
+        fpsqr_mont(r, t);
+        fpcopy(t, r);
+    }
+}
+
+
+static int fp2_sqrt(const f2elm_t a, f2elm_t r)
+{ // Square root r of a in GF(p^2) = GF(p)(i), i^2 = -1. Returns 0 if a is not a square
+  // With n = sqrt(a0^2+a1^2), r = u + a1/(2u)*i for u = sqrt((a0+n)/2) or u = sqrt((a0-n)/2), or r = sqrt(-a0)*i if a1 = 0
+    felm_t n, t, u, v;
+    f2elm_t s;
+
+    fpsqr_mont(a[0], n);
+    fpsqr_mont(a[1], t);
+    fpadd(n, t, t);
+    fp_sqrt(t, n);
+    fpadd(a[0], n, t);
+    fpdiv2(t, t);
+    fp_sqrt(t, u);
+    fpsqr_mont(u, v);
+    fpcorrection(v);
+    fpcorrection(t);
+    if (memcmp(v, t, sizeof(felm_t)) != 0) {
+        fpsub(a[0], n, t);
+        fpdiv2(t, t);
+        fp_sqrt(t, u);
+    }
+    fpcopy(u, t);
+    fpcorrection(t);
+    fpzero(v);
+    if (memcmp(t, v, sizeof(felm_t)) == 0) {
+        fpcopy(a[0], t);
+        fpneg(t);
+        fp_sqrt(t, r[1]);
+        fpzero(r[0]);
+    } else {
+        fpadd(u, u, t);
+        fpinv_mont(t);
+        fpmul_mont(a[1], t, r[1]);
+        fpcopy(u, r[0]);
+    }
+    fp2sqr_mont(r, s);
+    return fp2_equal(s, a);
+}
+
+
+static void walk_affine(const point_proj_t P, f2elm_t x)
+{ // Affine x-coordinate x = X/Z of a projective point
+    f2elm_t t;
+
+    fp2copy(P->Z, t);
+    fp2inv_mont(t);
+    fp2mul_mont(P->X, t, x);
+}
+
+
+static void walk_A24(const f2elm_t A, f2elm_t A24)
+{ // A24 = (A+2)/4
+    fp2zero(A24);
+    fpcopy((digit_t*)&Montgomery_one, A24[0]);
+    fp2add(A24, A24, A24);
+    fp2add(A, A24, A24);
+    fp2div2(A24, A24);
+    fp2div2(A24, A24);
+}
+
+
+static void walk_ladder(const f2elm_t xP, const f2elm_t xQ, const f2elm_t xPQ, const digit_t* k, unsigned int nbits, point_proj_t R, const f2elm_t A24)
+{ // Three-point ladder computing R = P + k*Q for a scalar k of nbits bits, as LADDER3PT_A24()
+    point_proj_t R0 = {0}, R2 = {0};
+    digit_t mask;
+    unsigned int i, bit, swap, prevbit = 0;
+
+    fp2copy(xQ, R0->X);
+    fpcopy((digit_t*)&Montgomery_one, (digit_t*)R0->Z);
+    fp2copy(xPQ, R2->X);
+    fpcopy((digit_t*)&Montgomery_one, (digit_t*)R2->Z);
+    fp2copy(xP, R->X);
+    fp2zero(R->Z);
+    fpcopy((digit_t*)&Montgomery_one, (digit_t*)R->Z);
+
+    for (i = 0; i < nbits; i++) {
+        bit = (k[i >> LOG2RADIX] >> (i & (RADIX-1))) & 1;
+        swap = bit ^ prevbit;
+        prevbit = bit;
+        mask = 0 - (digit_t)swap;
+
+        swap_points(R, R2, mask);
+        xDBLADD(R0, R2, R->X, R->Z, A24);
+    }
+    mask = 0 - (digit_t)prevbit;
+    swap_points(R, R2, mask);
+}
+
+
+static void walk_isogeny(f2elm_t A24plus, f2elm_t C24, const point_proj_t R, unsigned int bits, point_proj_t* pts, unsigned int npts)
+{ // Isogeny of degree 2^bits (bits even) with kernel <R> as a chain of 4-isogenies, pushing npts points.
+  // Updates the curve (A24plus:C24) = (A+2C:4C) to the codomain
+    point_proj_t S, T;
+    f2elm_t coeff[3];
+    unsigned int i, j, steps = bits/2;
+
+    fp2copy(R->X, S->X);
+    fp2copy(R->Z, S->Z);
+    for (i = 0; i < steps; i++) {
+        xDBLe(S, T, A24plus, C24, (int)(2*(steps - 1 - i)));
+        get_4_isog(T, A24plus, C24, coeff);
+        if (i != steps - 1) {
+            eval_4_isog(S, coeff);
+        }
+        for (j = 0; j < npts; j++) {
+            eval_4_isog(pts[j], coeff);
+        }
+    }
+}
+
+
+static void walk_j(const f2elm_t A24plus, const f2elm_t C24, f2elm_t j)
+{ // j-invariant of the curve (A24plus:C24) = (A+2C:4C), in reduced form
+    f2elm_t A;
+
+    fp2add(A24plus, A24plus, A);
+    fp2sub(A, C24, A);
+    fp2add(A, A, A);                                   // 4*A = 2*(2*A24plus-C24)
+    j_inv(A, C24, j);
+    fp2correction(j);
+}
+
+
+static void walk_curve(const walk_side_t* side, unsigned int m, uint64_t k, f2elm_t j)
+{ // j-invariant of E/<P+k*Q> for the starting curve E and the basis {P,Q} of E[2^m] of a side
+    point_proj_t R;
+    f2elm_t A24plus, C24;
+    digit_t kd[WALK_DIGITS];
+
+    walk_digits(k, kd, WALK_DIGITS);
+    walk_ladder(side->xP, side->xQ, side->xPQ, kd, m, R, side->A24);
+    fp2zero(C24);
+    fpcopy((digit_t*)&Montgomery_one, C24[0]);
+    fp2add(C24, C24, C24);
+    fp2add(C24, C24, C24);                             // C24 = 4
+    fp2mul_mont(side->A24, C24, A24plus);              // A24plus = A+2
+    walk_isogeny(A24plus, C24, R, m, NULL, 0);
+    walk_j(A24plus, C24, j);
+}
+
+
+static int walk_order_basis(walk_side_t* side, unsigned int m)
+{ // Ordering of the basis {P,Q} of E[2^m] such that [2^(m-1)]Q = (0,0). Returns 0 if P, Q are not a basis
+    point_proj_t pts[3], T;
+    f2elm_t A24plus, C24, x[3];
+    unsigned int i, origin = 3;
+    felm_t zero = {0};
+
+    fp2copy(side->xP, x[0]);
+    fp2copy(side->xQ, x[1]);
+    fp2copy(side->xPQ, x[2]);
+    fp2zero(C24);
+    fpcopy((digit_t*)&Montgomery_one, C24[0]);
+    fp2add(C24, C24, C24);
+    fp2add(C24, C24, C24);
+    fp2mul_mont(side->A24, C24, A24plus);
+    for (i = 0; i < 3; i++) {
+        fp2copy(x[i], pts[i]->X);
+        fp2zero(pts[i]->Z);
+        fpcopy((digit_t*)&Montgomery_one, pts[i]->Z[0]);
+        xDBLe(pts[i], T, A24plus, C24, (int)m - 1);
+        fp2correction(T->X);
+        fp2correction(T->Z);
+        if (memcmp(T->X, zero, sizeof(felm_t)) == 0 && memcmp(T->X[1], zero, sizeof(felm_t)) == 0) {
+            if (origin != 3) return 0;
+            origin = i;
+        } else if (memcmp(T->Z, zero, sizeof(felm_t)) == 0 && memcmp(T->Z[1], zero, sizeof(felm_t)) == 0) {
+            return 0;
+        }
+    }
+    if (origin == 0) {                                  // {P,Q} <- {Q,P}, with x(Q-P) = x(P-Q)
+        fp2copy(x[1], side->xP);
+        fp2copy(x[0], side->xQ);
+    } else if (origin == 2) {                           // {P,Q} <- {P,P-Q}, with P-(P-Q) = Q
+        fp2copy(x[2], side->xQ);
+        fp2copy(x[1], side->xPQ);
+    } else if (origin == 3) {
+        return 0;
+    }
+    return 1;
+}
+
+
+static int walk_move_origin(walk_side_t* side)
+{ // Change of the model y^2 = x(x-a)(x-1/a) of a side to v = (x-a)/s with s^2 = a^2-1, which moves (a,0) to the origin.
+  // The coefficient becomes (2a-1/a)/s. Returns 0 if a square root does not exist
+    f2elm_t a, s, t, one = {0};
+    f2elm_t* xs[3] = {&side->xP, &side->xQ, &side->xPQ};
+    unsigned int i;
+
+    fpcopy((digit_t*)&Montgomery_one, one[0]);
+    fp2sqr_mont(side->A, t);
+    fp2sub(t, one, t);
+    fp2sub(t, one, t);
+    fp2sub(t, one, t);
+    fp2sub(t, one, t);                                 // t = A^2-4
+    if (!fp2_sqrt(t, a)) return 0;
+    fp2sub(a, side->A, a);
+    fp2div2(a, a);                                     // a = (-A+sqrt(A^2-4))/2
+    fp2sqr_mont(a, t);
+    fp2sub(t, one, t);
+    if (!fp2_sqrt(t, s)) return 0;
+    fp2inv_mont(s);                                    // s <- 1/s
+
+    fp2copy(a, t);
+    fp2inv_mont(t);
+    fp2add(a, a, side->A);
+    fp2sub(side->A, t, side->A);
+    fp2mul_mont(side->A, s, side->A);                  // A = (2a-1/a)/s
+    walk_A24(side->A, side->A24);
+    for (i = 0; i < 3; i++) {
+        fp2sub(*xs[i], a, *xs[i]);
+        fp2mul_mont(*xs[i], s, *xs[i]);
+    }
+    return 1;
+}
+
+
+static void walk_coefficient(const f2elm_t A24plus, const f2elm_t C24, f2elm_t A)
+{ // Affine coefficient A = 2*(2*A24plus-C24)/C24 of the curve (A24plus:C24) = (A+2C:4C)
+    f2elm_t t;
+
+    fp2add(A24plus, A24plus, A);
+    fp2sub(A, C24, A);
+    fp2add(A, A, A);
+    fp2copy(C24, t);
+    fp2inv_mont(t);
+    fp2mul_mont(A, t, A);
+}
+
+
+static void walk_point(const f2elm_t x, point_proj_t P)
+{ // Projective point (x:1)
+    fp2copy(x, P->X);
+    fp2zero(P->Z);
+    fpcopy((digit_t*)&Montgomery_one, P->Z[0]);
+}
+
+
+static int walk_root_E0(walk_side_t* side, unsigned int ell, unsigned int d)
+{ // Starting curve E0 with A = 6 and the basis [2^(eA-d)]{PA,QA} of E0[2^d] (ell = 2, ordered with walk_order_basis())
+  // or [3^(eB-d)]{PB,QB} of E0[3^d] (ell = 3). Returns 0 on invalid parameters
+    point_proj_t T;
+    f2elm_t A24plus, A24minus, C24, x[3];
+    f2elm_t* xs[3] = {&side->xP, &side->xQ, &side->xPQ};
+    unsigned int i;
+
+    if ((ell != 2 || d == 0 || d > OALICE_BITS) && (ell != 3 || d > OBOB_EXPON)) return 0;
+    fp2zero(C24);
+    fpcopy((digit_t*)&Montgomery_one, C24[0]);
+    fp2add(C24, C24, C24);
+    fp2add(C24, C24, C24);                             // C24 = 4, A24minus = A-2 = 4
+    fp2copy(C24, A24minus);
+    fp2add(C24, C24, A24plus);                         // A24plus = A+2 = 8
+    walk_coefficient(A24plus, C24, side->A);
+    walk_A24(side->A, side->A24);
+    init_basis((digit_t*)((ell == 2) ? A_gen : B_gen), x[0], x[1], x[2]);
+    for (i = 0; i < 3; i++) {
+        walk_point(x[i], T);
+        if (ell == 2) {
+            xDBLe(T, T, A24plus, C24, (int)(OALICE_BITS - d));
+        } else {
+            xTPLe(T, T, A24minus, A24plus, (int)(OBOB_EXPON - d));
+        }
+        walk_affine(T, *xs[i]);
+    }
+    return (ell == 3) || walk_order_basis(side, d);
+}
+
+
+static int walk_instance_init(walk_instance_t* inst, unsigned int e)
+{ // Generation of an instance with a random secret isogeny of length e from the kernel <[2^(eA-e)](PA+sk*QA)>, 0 < sk < 2^e.
+  // e must be a multiple of 4 with e/2 <= WALK_MAX_M and 3e/2 <= eA. Returns 0 on invalid parameters or failure
+    unsigned int m = e/2, i;
+    point_proj_t pts[4], T;                            // pts = {R, QA, X1, X2}
+    f2elm_t A24plus, C24, xPA, xQA, xRA, xU, xV, xW;
+    walk_side_t* side;
+    digit_t k[NWORDS_ORDER];
+    uint64_t b;
+
+    if (e == 0 || (e & 3) != 0 || m > WALK_MAX_M || 3*m > OALICE_BITS) return 0;
+    memset(inst, 0, sizeof(*inst));
+    inst->e = e;
+    inst->m = m;
+    do {
+        randombytes((unsigned char*)&inst->sk, sizeof(inst->sk));
+        inst->sk &= ((uint64_t)1 << e) - 1;
+        randombytes((unsigned char*)&b, sizeof(b));
+        b &= ((uint64_t)1 << m) - 1;
+    } while (inst->sk == 0 || b == 0);
+
+    // Side 0: E0 with A = 6, i.e., (A24plus:C24) = (8:4), and the basis [2^(eA-m)]{PA,QA}
+    side = &inst->side[0];
+    if (!walk_root_E0(side, 2, m)) return 0;
+    fp2zero(C24);
+    fpcopy((digit_t*)&Montgomery_one, C24[0]);
+    fp2add(C24, C24, C24);
+    fp2add(C24, C24, C24);
+    fp2add(C24, C24, A24plus);
+    init_basis((digit_t*)A_gen, xPA, xQA, xRA);
+
+    // Secret isogeny phi = phi2*phi1 with kernel <R>, R = [2^(eA-e)]X1 for X1 = PA+sk*QA, pushing QA, X1 and X2 = PA+(sk-1)*QA
+    walk_digits(inst->sk, k, NWORDS_ORDER);
+    walk_ladder(xPA, xQA, xRA, k, OALICE_BITS, pts[2], side->A24);
+    walk_digits(inst->sk - 1, k, NWORDS_ORDER);
+    walk_ladder(xPA, xQA, xRA, k, OALICE_BITS, pts[3], side->A24);
+    walk_point(xQA, pts[1]);
+    xDBLe(pts[2], pts[0], A24plus, C24, OALICE_BITS - e);
+    xDBLe(pts[0], T, A24plus, C24, m);
+    walk_isogeny(A24plus, C24, T, m, pts, 4);
+    walk_j(A24plus, C24, inst->jmid);
+    walk_isogeny(A24plus, C24, pts[0], m, pts + 1, 3);
+
+    // Side 1: EA with the basis {U,V} = {[2^(eA-m)]phi(QA), [2^(eA-e-m)]phi(X1)} and U-V = [2^(eA-e-m)](2^e*phi(QA)-phi(X1)),
+    // where phi(X1)-phi(QA) = phi(X2)
+    side = &inst->side[1];
+    walk_coefficient(A24plus, C24, side->A);
+    walk_A24(side->A, side->A24);
+    walk_affine(pts[1], xU);
+    walk_affine(pts[2], xV);
+    walk_affine(pts[3], xW);
+    memset(k, 0, sizeof(k));
+    for (i = e; i < OALICE_BITS; i++) {
+        k[i >> LOG2RADIX] |= (digit_t)1 << (i & (RADIX-1));       // k = 2^eA-2^e
+    }
+    walk_ladder(xV, xU, xW, k, OALICE_BITS, T, side->A24);
+    xDBLe(T, T, A24plus, C24, OALICE_BITS - e - m);
+    walk_affine(T, xW);
+    xDBLe(pts[1], T, A24plus, C24, OALICE_BITS - m);
+    walk_affine(T, xU);
+    xDBLe(pts[2], T, A24plus, C24, OALICE_BITS - e - m);
+    walk_affine(T, xV);
+
+    // Randomizing the basis to {U+b*V, V}, so that the kernel of the dual of phi2 is not <U>
+    walk_digits(b, k, NWORDS_ORDER);
+    walk_ladder(xU, xV, xW, k, m, T, side->A24);
+    walk_affine(T, side->xP);
+    walk_digits(b - 1, k, NWORDS_ORDER);
+    walk_ladder(xU, xV, xW, k, m, T, side->A24);
+    walk_affine(T, side->xPQ);
+    fp2copy(xV, side->xQ);
+
+    if (!walk_move_origin(side)) return 0;
+    return walk_order_basis(&inst->side[1], m);
+}
+
+
+static uint64_t walk_mix(uint64_t x)
+{ // Mixing function of 64-bit words (finalizer of SplitMix64)
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+
+static uint64_t walk_hash(const f2elm_t j, uint64_t salt)
+{ // Hash of a reduced j-invariant, keyed by salt
+    const digit_t* d = (const digit_t*)j;
+    uint64_t h = walk_mix(salt);
+    unsigned int i;
+
+    for (i = 0; i < 2*NWORDS_FIELD; i++) {
+        h = walk_mix(h ^ (uint64_t)d[i]);
+    }
+    return h;
+}
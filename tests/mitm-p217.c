@@ -0,0 +1,18 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: meet-in-the-middle search on reduced SIDHp217 instances
+*********************************************************************************************/
+
+#include <stdio.h>
+#include "test_extras.h"
+#include "../src/P217/P217.c"
+
+
+#define SCHEME_NAME    "SIDHp217"
+
+#include "mitm.c"
@@ -0,0 +1,493 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: meet-in-the-middle search on reduced SIDH instances with on-disk j-invariant tables
+*
+* Usage: mitm-pXXX [-e bits] [-t threads] [-M MiB] [-d dir] [-n runs] | --check
+*   -e: length of the secret isogeny, a multiple of 4 (24 by default)
+*   -t: number of threads enumerating the curves (number of online processors by default)
+*   -M: memory for the sorting and streaming buffers, in MiB (256 by default)
+*   -d: directory of the table file and of the temporary sort runs (current directory by default)
+*   -n: number of instances to solve (1 by default)
+*   --check: check the 3-isogeny tree of walk_tree() from E0 instead of solving instances
+*
+* The 2^(e/2) curves reached from E0 (see isogeny_walks.c) are enumerated depth-first with walk_tree() (see isogeny_tree.c),
+* in ranges of DFS indices split among the threads, once per length e and stored in the table file
+* mitm-pXXX-e<bits>.tbl as 64-bit records (fingerprint || k) sorted by fingerprint, where the fingerprint is the top
+* 64-e/2 bits of a hash of the j-invariant and k the kernel scalar. Since the side of E0 does not depend on the instance,
+* an existing table file is reused. The records are sorted externally: runs that fit in the memory buffer are sorted
+* and written to temporary files, and then merged into the table file. The table is then mapped read-only, and the
+* curves reached from the public curve are enumerated in batches which are sorted and merged against the table, so that
+* the table is read sequentially once per batch. Matching fingerprints are checked by comparing the j-invariants.
+*********************************************************************************************/
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include "isogeny_walks.c"
+#include "isogeny_tree.c"
+
+
+#define MITM_MAGIC           "SIDHMITM"
+#define MITM_VERSION         1
+#define MITM_SALT            0x6d69746d          // Key of the fingerprint hash
+#define MITM_MAX_THREADS     256
+#define MITM_CHECK_DEPTH     6                   // Depth of the 3-isogeny tree of --check, 3^6 leaves
+#define MITM_CHECK_LEAVES    729
+
+// Header of a table file, followed by count records
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t m;
+    uint64_t count;
+} mitm_header_t;
+
+// Leaves of the 3-isogeny tree of --check
+typedef struct {
+    uint64_t first, n;                        // DFS index of the first leaf and number of leaves seen
+    int ordered;                              // Leaves came in DFS order, with the DFS index of k given by its reversed base-3 digits
+    uint64_t k[MITM_CHECK_LEAVES];
+    f2elm_t j[MITM_CHECK_LEAVES];
+} mitm_check_t;
+
+// Enumeration of a range of kernels of one side by a thread
+typedef struct {
+    const walk_side_t* side;
+    unsigned int m;
+    uint64_t first, count;
+    uint64_t* records;
+} mitm_job_t;
+
+
+static double mitm_time(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec*1e-9;
+}
+
+
+static uint64_t mitm_record(const f2elm_t j, uint64_t k, unsigned int m)
+{ // Record (fingerprint || k) of the curve with j-invariant j reached with the kernel scalar k
+    return (walk_hash(j, MITM_SALT) & ~(((uint64_t)1 << m) - 1)) | k;
+}
+
+
+static void mitm_leaf(void* ctx, uint64_t index, uint64_t k, const f2elm_t j)
+{
+    mitm_job_t* job = (mitm_job_t*)ctx;
+
+    job->records[index - job->first] = mitm_record(j, k, job->m);
+}
+
+
+static void* mitm_enumerate_job(void* arg)
+{
+    mitm_job_t* job = (mitm_job_t*)arg;
+
+    walk_tree(job->side, 2, job->m, job->first, job->count, mitm_leaf, job);
+    return NULL;
+}
+
+
+static int mitm_enumerate(const walk_side_t* side, unsigned int m, uint64_t first, uint64_t count, uint64_t* records, unsigned int nthreads)
+{ // Records of the leaves with DFS indices first, ..., first+count-1 of the isogeny tree of a side, computed by nthreads threads
+    pthread_t threads[MITM_MAX_THREADS];
+    mitm_job_t jobs[MITM_MAX_THREADS];
+    uint64_t start = 0, len;
+    unsigned int i;
+
+    for (i = 0; i < nthreads; i++) {
+        len = count/nthreads + (i < count % nthreads);
+        jobs[i].side = side;
+        jobs[i].m = m;
+        jobs[i].first = first + start;
+        jobs[i].count = len;
+        jobs[i].records = records + start;
+        start += len;
+        if (pthread_create(&threads[i], NULL, mitm_enumerate_job, &jobs[i]) != 0) {
+            while (i-- > 0) pthread_join(threads[i], NULL);
+            return 0;
+        }
+    }
+    for (i = 0; i < nthreads; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    return 1;
+}
+
+
+static int compare_records(const void* a, const void* b)
+{
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+
+    return (x > y) - (x < y);
+}
+
+
+static int mitm_merge(FILE** runs, unsigned int nruns, FILE* out, uint64_t* buffer, size_t buffer_records)
+{ // Merging of nruns sorted run files into out, using buffer as input buffers of each run and as output buffer
+    size_t per_run = buffer_records/(nruns + 1), *pos, *len, nout = 0;
+    uint64_t* outbuf = buffer + nruns*per_run;
+    unsigned int i, best;
+    int ok = 1;
+
+    pos = calloc(nruns, sizeof(size_t));
+    len = calloc(nruns, sizeof(size_t));
+    if (pos == NULL || len == NULL || per_run == 0) {
+        free(pos);
+        free(len);
+        return 0;
+    }
+    for (i = 0; i < nruns; i++) {
+        len[i] = fread(buffer + i*per_run, sizeof(uint64_t), per_run, runs[i]);
+    }
+    for (;;) {
+        best = nruns;
+        for (i = 0; i < nruns; i++) {
+            if (pos[i] == len[i]) continue;
+            if (best == nruns || buffer[i*per_run + pos[i]] < buffer[best*per_run + pos[best]]) best = i;
+        }
+        if (best == nruns) break;
+        outbuf[nout++] = buffer[best*per_run + pos[best]];
+        if (nout == per_run) {
+            ok &= (fwrite(outbuf, sizeof(uint64_t), nout, out) == nout);
+            nout = 0;
+        }
+        if (++pos[best] == len[best]) {
+            len[best] = fread(buffer + best*per_run, sizeof(uint64_t), per_run, runs[best]);
+            pos[best] = 0;
+        }
+    }
+    ok &= (fwrite(outbuf, sizeof(uint64_t), nout, out) == nout);
+    free(pos);
+    free(len);
+    return ok;
+}
+
+
+static FILE* tmpfile_in(const char* dir, char* name, size_t size)
+{ // Temporary file in dir, removed when it is closed
+    FILE* f;
+    int fd;
+
+    if ((size_t)snprintf(name, size, "%s/mitm-run-XXXXXX", dir) >= size) return NULL;
+    fd = mkstemp(name);
+    if (fd < 0) return NULL;
+    unlink(name);
+    f = fdopen(fd, "w+b");
+    if (f == NULL) close(fd);
+    return f;
+}
+
+
+static int mitm_build_table(const walk_instance_t* inst, const char* path, const char* dir, uint64_t* buffer, size_t buffer_records, unsigned int nthreads)
+{ // Enumeration of the curves reached from E0 and external sorting of their records into the table file
+    uint64_t total = (uint64_t)1 << inst->m, first, count;
+    unsigned int nruns = 0, i;
+    FILE **runs = NULL, *out;
+    char name[4096];
+    mitm_header_t header;
+    double t0, t1, t2;
+    int ok = 1;
+
+    t0 = mitm_time();
+    runs = calloc((size_t)(total/buffer_records + 1), sizeof(FILE*));
+    if (runs == NULL) return 0;
+    for (first = 0; first < total && ok; first += count) {
+        count = (total - first < buffer_records) ? total - first : buffer_records;
+        ok = mitm_enumerate(&inst->side[0], inst->m, first, count, buffer, nthreads);
+        qsort(buffer, (size_t)count, sizeof(uint64_t), compare_records);
+        runs[nruns] = tmpfile_in(dir, name, sizeof(name));
+        if (runs[nruns] == NULL || fwrite(buffer, sizeof(uint64_t), (size_t)count, runs[nruns]) != count) {
+            ok = 0;
+        }
+        nruns++;
+    }
+    t1 = mitm_time();
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MITM_MAGIC, sizeof(header.magic));
+    header.version = MITM_VERSION;
+    header.m = inst->m;
+    header.count = total;
+    out = fopen(path, "wb");
+    if (out == NULL || fwrite(&header, sizeof(header), 1, out) != 1) ok = 0;
+    for (i = 0; i < nruns && ok; i++) {
+        ok = (fflush(runs[i]) == 0 && fseek(runs[i], 0, SEEK_SET) == 0);
+    }
+    if (ok) ok = mitm_merge(runs, nruns, out, buffer, buffer_records);
+    if (out != NULL && fclose(out) != 0) ok = 0;
+    for (i = 0; i < nruns; i++) {
+        if (runs[i] != NULL) fclose(runs[i]);
+    }
+    free(runs);
+    t2 = mitm_time();
+
+    if (ok) {
+        printf("  Table of E0: 2^%u curves in %.2f s (%.0f curves/second), %u sorted runs merged in %.2f s, %.1f MiB \n",
+               inst->m, t1 - t0, (double)total/(t1 - t0), nruns, t2 - t1, (double)(sizeof(header) + total*sizeof(uint64_t))/1048576);
+    } else {
+        remove(path);
+    }
+    return ok;
+}
+
+
+static const uint64_t* mitm_map_table(const char* path, unsigned int m, size_t* size)
+{ // Mapping of a table file for 2^m curves. Returns NULL if the file is missing or does not match
+    mitm_header_t header;
+    struct stat st;
+    void* map;
+    int fd;
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+    if (fstat(fd, &st) != 0 || read(fd, &header, sizeof(header)) != (ssize_t)sizeof(header) ||
+        memcmp(header.magic, MITM_MAGIC, sizeof(header.magic)) != 0 || header.version != MITM_VERSION || header.m != m ||
+        header.count != ((uint64_t)1 << m) || (uint64_t)st.st_size != sizeof(header) + header.count*sizeof(uint64_t)) {
+        close(fd);
+        return NULL;
+    }
+    *size = (size_t)st.st_size;
+    map = mmap(NULL, *size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return NULL;
+    madvise(map, *size, MADV_SEQUENTIAL);
+    return (const uint64_t*)((const unsigned char*)map + sizeof(header));
+}
+
+
+static int mitm_search(const walk_instance_t* inst, const uint64_t* table, uint64_t* buffer, size_t buffer_records, unsigned int nthreads, uint64_t k[2], uint64_t* candidates)
+{ // Streaming of the curves reached from the public curve against the table. Returns 1 if the middle curve is found
+    uint64_t total = (uint64_t)1 << inst->m, mask = total - 1, first, count, i, lo, hi, t;
+    f2elm_t j0, j1;
+
+    *candidates = 0;
+    for (first = 0; first < total; first += count) {
+        count = (total - first < buffer_records) ? total - first : buffer_records;
+        if (!mitm_enumerate(&inst->side[1], inst->m, first, count, buffer, nthreads)) return -1;
+        qsort(buffer, (size_t)count, sizeof(uint64_t), compare_records);
+
+        // Merge join of the sorted batch with the table, starting at the first fingerprint of the batch
+        lo = 0;
+        hi = total;
+        while (lo < hi) {
+            uint64_t mid = lo + (hi - lo)/2;
+            if ((table[mid] & ~mask) < (buffer[0] & ~mask)) lo = mid + 1; else hi = mid;
+        }
+        for (i = 0, t = lo; i < count && t < total; ) {
+            if ((table[t] & ~mask) < (buffer[i] & ~mask)) {
+                t++;
+            } else if ((table[t] & ~mask) > (buffer[i] & ~mask)) {
+                i++;
+            } else {
+                uint64_t u;
+                for (u = t; u < total && (table[u] & ~mask) == (buffer[i] & ~mask); u++) {
+                    (*candidates)++;
+                    walk_curve(&inst->side[0], inst->m, table[u] & mask, j0);
+                    walk_curve(&inst->side[1], inst->m, buffer[i] & mask, j1);
+                    if (fp2_equal(j0, j1)) {
+                        k[0] = table[u] & mask;
+                        k[1] = buffer[i] & mask;
+                        return 1;
+                    }
+                }
+                i++;
+            }
+        }
+    }
+    return 0;
+}
+
+
+static void mitm_check_leaf(void* ctx, uint64_t index, uint64_t k, const f2elm_t j)
+{
+    mitm_check_t* check = (mitm_check_t*)ctx;
+    uint64_t reversed = 0, t = k;
+    unsigned int i;
+
+    for (i = 0; i < MITM_CHECK_DEPTH; i++) {
+        reversed = 3*reversed + t % 3;
+        t /= 3;
+    }
+    if (index != check->first + check->n || reversed != index || check->n >= MITM_CHECK_LEAVES) {
+        check->ordered = 0;
+        return;
+    }
+    check->k[check->n] = k;
+    fp2copy(j, check->j[check->n++]);
+}
+
+
+static void mitm_check_curve(const walk_side_t* side, uint64_t k, f2elm_t j)
+{ // j-invariant of E/<P+k*Q> for the basis {P,Q} of E[3^MITM_CHECK_DEPTH] of a side, computed from the root
+    point_proj_t R, T;
+    f2elm_t A24minus, A24plus, two = {0}, coeff[3];
+    digit_t kd[WALK_DIGITS];
+    unsigned int i;
+
+    walk_digits(k, kd, WALK_DIGITS);
+    walk_ladder(side->xP, side->xQ, side->xPQ, kd, 64, R, side->A24);
+    fpcopy((digit_t*)&Montgomery_one, two[0]);
+    fp2add(two, two, two);
+    fp2sub(side->A, two, A24minus);
+    fp2add(side->A, two, A24plus);
+    for (i = 0; i < MITM_CHECK_DEPTH; i++) {
+        xTPLe(R, T, A24minus, A24plus, MITM_CHECK_DEPTH - 1 - i);
+        get_3_isog(T, A24minus, A24plus, coeff);
+        eval_3_isog(R, coeff);
+    }
+    fp2add(A24minus, A24plus, two);
+    fp2add(two, two, two);                            // 4*A = 2*(A24plus+A24minus)
+    fp2sub(A24plus, A24minus, A24plus);               // 4*C = A24plus-A24minus
+    j_inv(two, A24plus, j);
+    fp2correction(j);
+}
+
+
+static int mitm_check(void)
+{ // Enumeration of the 3-isogeny tree of depth MITM_CHECK_DEPTH from E0 with walk_tree(), in full and in a range of DFS indices.
+  // Every leaf must match the curve computed from the root, and the leaves E0/<P+k*Q> are pairwise non-isomorphic, since an
+  // isomorphism would give an endomorphism of E0 of degree 3^(2d) other than [3^d], and E0 has none of degree below p
+  // other than those of Z[2i], where 3 is inert
+    static mitm_check_t full, part;
+    walk_side_t side;
+    f2elm_t j;
+    uint64_t i, l, distinct = 0;
+    int passed = 1;
+
+    full.first = 0; full.n = 0; full.ordered = 1;
+    part.first = 100; part.n = 0; part.ordered = 1;
+    if (!walk_root_E0(&side, 3, MITM_CHECK_DEPTH) ||
+        !walk_tree(&side, 3, MITM_CHECK_DEPTH, 0, MITM_CHECK_LEAVES, mitm_check_leaf, &full) ||
+        !walk_tree(&side, 3, MITM_CHECK_DEPTH, 100, 200, mitm_check_leaf, &part)) {
+        passed = 0;
+    }
+    if (full.ordered == 0 || full.n != MITM_CHECK_LEAVES || part.ordered == 0 || part.n != 200) passed = 0;
+    for (i = 0; i < full.n; i++) {
+        mitm_check_curve(&side, full.k[i], j);
+        if (!fp2_equal(j, full.j[i])) passed = 0;
+        for (l = 0; l < i && !fp2_equal(full.j[i], full.j[l]); l++);
+        distinct += (l == i);
+    }
+    for (i = 0; i < part.n; i++) {
+        if (!fp2_equal(part.j[i], full.j[part.first + i])) passed = 0;
+    }
+    if (distinct != MITM_CHECK_LEAVES) passed = 0;
+
+    printf("  3-isogeny tree of depth %d from E0: %llu leaves, %llu distinct j-invariants ............ %s\n", MITM_CHECK_DEPTH,
+           (unsigned long long)full.n, (unsigned long long)distinct, passed ? "PASSED" : "FAILED");
+    return passed;
+}
+
+
+static void print_usage(const char* prog)
+{
+    printf("Usage: %s [-e bits] [-t threads] [-M MiB] [-d dir] [-n runs] | --check\n", prog);
+}
+
+
+int main(int argc, char** argv)
+{
+    unsigned int e = 24, nthreads = 0, runs = 1, i, nfound = 0;
+    size_t mib = 256, buffer_records, map_size = 0;
+    const char* dir = ".";
+    const uint64_t* table = NULL;
+    uint64_t* buffer;
+    uint64_t k[2], candidates;
+    walk_instance_t inst;
+    char path[4096];
+    double t0, t1;
+    f2elm_t j;
+    int r;
+
+    if (argc == 2 && strcmp(argv[1], "--check") == 0) {
+        printf("\n\nISOGENY TREE CHECK ON %s\n", SCHEME_NAME);
+        printf("--------------------------------------------------------------------------------------------------------\n\n");
+        return mitm_check() ? 0 : 1;
+    }
+    for (i = 1; i < (unsigned int)argc; i++) {
+        if (strcmp(argv[i], "-e") == 0 && i + 1 < (unsigned int)argc) {
+            e = (unsigned int)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-t") == 0 && i + 1 < (unsigned int)argc) {
+            nthreads = (unsigned int)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-M") == 0 && i + 1 < (unsigned int)argc) {
+            mib = (size_t)atol(argv[++i]);
+        } else if (strcmp(argv[i], "-d") == 0 && i + 1 < (unsigned int)argc) {
+            dir = argv[++i];
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < (unsigned int)argc) {
+            runs = (unsigned int)atoi(argv[++i]);
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (nthreads == 0) {
+        long n = sysconf(_SC_NPROCESSORS_ONLN);
+        nthreads = (n > 0) ? (unsigned int)n : 1;
+    }
+    if (nthreads > MITM_MAX_THREADS) nthreads = MITM_MAX_THREADS;
+    if ((e & 3) != 0 || e == 0 || e/2 > WALK_MAX_M || 3*(e/2) > OALICE_BITS || mib == 0 || runs == 0) {
+        printf("  Unsupported parameters: e must be a multiple of 4 with e/2 <= %d and 3e/2 <= %d \n", WALK_MAX_M, OALICE_BITS);
+        return 1;
+    }
+    buffer_records = mib*1048576/sizeof(uint64_t);
+    buffer = malloc(buffer_records*sizeof(uint64_t));
+    if (buffer == NULL) {
+        printf("  Allocation of %zu MiB failed \n", mib);
+        return 1;
+    }
+    snprintf(path, sizeof(path), "%s/mitm-%s-e%u.tbl", dir, SCHEME_NAME, e);
+
+    printf("\n\nMEET-IN-THE-MIDDLE SEARCH ON REDUCED %s INSTANCES\n", SCHEME_NAME);
+    printf("--------------------------------------------------------------------------------------------------------\n\n");
+    printf("  Secret isogeny of length e = %u, 2^%u curves per side, %u threads, %zu MiB of buffers \n", e, e/2, nthreads, mib);
+
+    for (i = 0; i < runs; i++) {
+        if (!walk_instance_init(&inst, e)) {
+            printf("  Instance generation failed \n");
+            return 1;
+        }
+        if (i == 0) {
+            table = mitm_map_table(path, inst.m, &map_size);
+            if (table == NULL) {
+                if (!mitm_build_table(&inst, path, dir, buffer, buffer_records, nthreads) ||
+                    (table = mitm_map_table(path, inst.m, &map_size)) == NULL) {
+                    printf("  Writing of the table file %s failed \n", path);
+                    return 1;
+                }
+            } else {
+                printf("  Reusing the table file %s \n", path);
+            }
+            printf("\n");
+        }
+
+        t0 = mitm_time();
+        r = mitm_search(&inst, table, buffer, buffer_records, nthreads, k, &candidates);
+        t1 = mitm_time();
+        if (r == 1) {
+            walk_curve(&inst.side[0], inst.m, k[0], j);
+            r = fp2_equal(j, inst.jmid);
+            nfound += r;
+        }
+        printf("  Instance %u: %s, %llu fingerprint matches, %.2f s (%.0f curves/second) \n", i + 1, (r == 1) ? "middle curve found" : "FAILED",
+               (unsigned long long)candidates, t1 - t0, (double)((uint64_t)1 << inst.m)/(t1 - t0));
+    }
+
+    munmap((void*)((const unsigned char*)table - sizeof(mitm_header_t)), map_size);
+    free(buffer);
+    printf("\n  Solved %u of %u instances \n", nfound, runs);
+    return (nfound == runs) ? 0 : 1;
+}
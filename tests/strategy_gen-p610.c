@@ -0,0 +1,21 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: generation of optimal strategies for the isogeny tree traversal of p610
+*********************************************************************************************/
+
+#include "../src/config.h"
+#include "../src/P610/P610_internal.h"
+#include "../src/internal.h"
+#include "test_extras.h"
+#include <stdio.h>
+
+
+#define SCHEME_NAME       "SIDHp610"
+#define fp2random_test    fp2random610_test
+
+#include "strategy_gen.c"
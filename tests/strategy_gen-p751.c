@@ -0,0 +1,21 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: generation of optimal strategies for the isogeny tree traversal of p751
+*********************************************************************************************/
+
+#include "../src/config.h"
+#include "../src/P751/P751_internal.h"
+#include "../src/internal.h"
+#include "test_extras.h"
+#include <stdio.h>
+
+
+#define SCHEME_NAME       "SIDHp751"
+#define fp2random_test    fp2random751_test
+
+#include "strategy_gen.c"
@@ -0,0 +1,210 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: generation of optimal strategies for the isogeny tree traversal
+*
+* Usage: strategy_gen-pXXX [threads [p2 q4 p3 q3]]
+*   threads: number of worker threads of the traversal (SIDH_THREADS), 0 for the serial code (default)
+*   p2, q4, p3, q3: costs of a doubling step (two doublings), a 4-isogeny evaluation, a tripling and
+*                   a 3-isogeny evaluation. Measured on the host if not given.
+*
+* A strategy is split recursively: a subtree with n leaves is split as [m] + strategy(n-m) + strategy(m),
+* i.e., the point is pushed, multiplied m times, the remaining n-m leaves are computed and the pushed point
+* is then evaluated through n-m isogenies before its own m leaves are processed.
+* For the serial code, the optimal strategy under the limit on intermediate points is obtained by
+* dynamic programming (De Feo, Jao and Plut, "Towards quantum-resistant cryptosystems from supersingular
+* elliptic curve isogenies", 2014). With worker threads, the cost of a strategy is no longer additive over
+* subtrees, so strategies are evaluated by simulating the parallel traversal of sidh.c, where the workers
+* evaluate the pushed points while the main thread runs the next multiplication chain, and the best
+* strategy is selected among the optimal strategies for scaled evaluation costs (cf. Hutchinson and
+* Karabina, "Constructing canonical strategies for parallel implementation of isogeny based cryptography",
+* INDOCRYPT 2018). The output can be loaded with sidh_load_strategies().
+*********************************************************************************************/
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#define COST_LOOPS    10000          // Number of iterations per measurement
+#define NWEIGHTS        64          // Number of scaled evaluation costs tried with worker threads
+#define MAX_LEAVES    (MAX_Alice > MAX_Bob ? MAX_Alice : MAX_Bob)
+#define MAX_PTS       (MAX_INT_POINTS_ALICE > MAX_INT_POINTS_BOB ? MAX_INT_POINTS_ALICE : MAX_INT_POINTS_BOB)
+
+extern const unsigned int strat_Alice[MAX_Alice-1];
+extern const unsigned int strat_Bob[MAX_Bob-1];
+
+static double dp_cost[MAX_LEAVES+1][MAX_PTS+1];
+static unsigned int dp_split[MAX_LEAVES+1][MAX_PTS+1];
+
+
+static void measure_costs(double* p2, double* q4, double* p3, double* q3)
+{ // Measuring the costs of the traversal primitives on the host
+    unsigned long long cycles[4] = {0}, cycles1, cycles2;
+    f2elm_t A24plus, C24, coeff[3];
+    point_proj_t P;
+    unsigned int n;
+
+    for (n = 0; n < COST_LOOPS; n++) {
+        fp2random_test((digit_t*)A24plus); fp2random_test((digit_t*)C24); fp2random_test((digit_t*)P->X); fp2random_test((digit_t*)P->Z);
+        fp2random_test((digit_t*)coeff[0]); fp2random_test((digit_t*)coeff[1]); fp2random_test((digit_t*)coeff[2]);
+
+        cycles1 = cpucycles();
+        xDBLe(P, P, A24plus, C24, 2);
+        cycles2 = cpucycles();
+        cycles[0] += cycles2-cycles1;
+
+        cycles1 = cpucycles();
+        eval_4_isog(P, coeff);
+        cycles2 = cpucycles();
+        cycles[1] += cycles2-cycles1;
+
+        cycles1 = cpucycles();
+        xTPLe(P, P, A24plus, C24, 1);
+        cycles2 = cpucycles();
+        cycles[2] += cycles2-cycles1;
+
+        cycles1 = cpucycles();
+        eval_3_isog(P, (const f2elm_t*)coeff);
+        cycles2 = cpucycles();
+        cycles[3] += cycles2-cycles1;
+    }
+    *p2 = (double)cycles[0]/COST_LOOPS;
+    *q4 = (double)cycles[1]/COST_LOOPS;
+    *p3 = (double)cycles[2]/COST_LOOPS;
+    *q3 = (double)cycles[3]/COST_LOOPS;
+}
+
+
+static void optimal_strategy(const unsigned int max, const unsigned int max_pts, const double p, const double q, unsigned int* strat)
+{ // Optimal serial strategy with max-1 entries using at most max_pts intermediate points, for multiplication cost p and evaluation cost q
+    unsigned int n, k, m, len = 0, stack_n[2*MAX_LEAVES], stack_k[2*MAX_LEAVES], top = 0;
+    double c;
+
+    for (k = 0; k <= max_pts; k++) {
+        dp_cost[1][k] = 0;
+    }
+    for (n = 2; n <= max; n++) {
+        dp_cost[n][0] = HUGE_VAL;
+        for (k = 1; k <= max_pts; k++) {
+            dp_cost[n][k] = HUGE_VAL;
+            for (m = 1; m < n; m++) {
+                c = dp_cost[n-m][k-1] + dp_cost[m][k] + m*p + (n-m)*q;
+                if (c < dp_cost[n][k]) {
+                    dp_cost[n][k] = c;
+                    dp_split[n][k] = m;
+                }
+            }
+        }
+    }
+
+    // Emitting [m] + strategy(n-m, k-1) + strategy(m, k) in traversal order
+    stack_n[top] = max; stack_k[top++] = max_pts;
+    while (top > 0) {
+        n = stack_n[--top]; k = stack_k[top];
+        if (n == 1) continue;
+        m = dp_split[n][k];
+        strat[len++] = m;
+        stack_n[top] = m; stack_k[top++] = k;
+        stack_n[top] = n-m; stack_k[top++] = k-1;
+    }
+}
+
+
+static double strategy_cost(const unsigned int* strat, const unsigned int max, const double p, const double q, const unsigned int threads)
+{ // Cost of the tree traversal of sidh.c, including the evaluation of the three basis points, for a number of worker threads
+    unsigned int row, m, index = 0, pts_index[MAX_PTS], npts = 0, ii = 0, neval;
+    double t = 0, workers = 0;                       // Times at which the main thread and the workers are done
+
+    for (row = 1; row < max; row++) {
+        while (index < max-row) {
+            pts_index[npts++] = index;
+            m = strat[ii++];
+            t += m*p;
+            index += m;
+        }
+        if (threads == 0) {
+            t += (npts + 3)*q;
+        } else {
+            neval = (npts - 1 + 3 + threads - 1)/threads;
+            t = (t > workers ? t : workers) + q;
+            workers = t + neval*q;
+        }
+        index = pts_index[npts-1];
+        npts -= 1;
+    }
+    t = (t > workers ? t : workers);
+    return t + 3*q;
+}
+
+
+static void best_strategy(const unsigned int max, const unsigned int max_pts, const double p, const double q, const unsigned int threads,
+                          const unsigned int* builtin, unsigned int* strat)
+{ // Best strategy for a number of worker threads, among the optimal serial strategies for evaluation costs q*w, w in (0, 1]
+    unsigned int candidate[MAX_LEAVES-1], i;
+    double cost, best;
+
+    optimal_strategy(max, max_pts, p, q, strat);
+    best = strategy_cost(strat, max, p, q, threads);
+    if (threads == 0) {
+        return;
+    }
+    for (i = 1; i < NWEIGHTS; i++) {
+        optimal_strategy(max, max_pts, p, q*(double)i/NWEIGHTS, candidate);
+        cost = strategy_cost(candidate, max, p, q, threads);
+        if (cost < best) {
+            best = cost;
+            memcpy(strat, candidate, (max-1)*sizeof(unsigned int));
+        }
+    }
+    if (strategy_cost(builtin, max, p, q, threads) <= best) {
+        memcpy(strat, builtin, (max-1)*sizeof(unsigned int));
+    }
+}
+
+
+static void print_strategy(const char* name, const unsigned int* strat, const unsigned int len)
+{ // Printing a strategy in the format of the tables in PXXX.c
+    unsigned int i;
+
+    printf("const unsigned int %s[%u] = { \n", name, len);
+    for (i = 0; i < len; i++) {
+        printf("%u%s", strat[i], (i == len-1) ? " };\n" : ((i % 46 == 45) ? ", \n" : ", "));
+    }
+}
+
+
+int main(int argc, char** argv)
+{
+    unsigned int threads = 0, strat_A[MAX_Alice-1], strat_B[MAX_Bob-1];
+    double p2, q4, p3, q3;
+
+    if (argc > 1) {
+        threads = (unsigned int)atoi(argv[1]);
+    }
+    if (argc > 5) {
+        p2 = atof(argv[2]); q4 = atof(argv[3]); p3 = atof(argv[4]); q3 = atof(argv[5]);
+    } else if (argc == 1 || argc == 2) {
+        measure_costs(&p2, &q4, &p3, &q3);
+    } else {
+        fprintf(stderr, "Usage: %s [threads [p2 q4 p3 q3]]\n", argv[0]);
+        return 1;
+    }
+
+    best_strategy(MAX_Alice, MAX_INT_POINTS_ALICE, p2, q4, threads, strat_Alice, strat_A);
+    best_strategy(MAX_Bob, MAX_INT_POINTS_BOB, p3, q3, threads, strat_Bob, strat_B);
+
+    printf("// Strategies for %s with %u worker thread(s), for costs p2 = %.0f, q4 = %.0f, p3 = %.0f, q3 = %.0f\n", SCHEME_NAME, threads, p2, q4, p3, q3);
+    printf("// Alice: %.0f (built-in strategy: %.0f), Bob: %.0f (built-in strategy: %.0f)\n",
+           strategy_cost(strat_A, MAX_Alice, p2, q4, threads), strategy_cost(strat_Alice, MAX_Alice, p2, q4, threads),
+           strategy_cost(strat_B, MAX_Bob, p3, q3, threads), strategy_cost(strat_Bob, MAX_Bob, p3, q3, threads));
+    print_strategy("strat_Alice", strat_A, MAX_Alice-1);
+    printf("\n");
+    print_strategy("strat_Bob", strat_B, MAX_Bob-1);
+
+    return 0;
+}
@@ -0,0 +1,18 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: generation of the table file of p434_compressed
+*********************************************************************************************/
+
+#include "test_extras.h"
+#include "../src/P434/P434_compressed.c"
+
+
+#define SCHEME_NAME          "SIDHp434_compressed"
+#define TABLES_FILE          "p434_compressed.tbl"
+
+#include "tables_gen.c"
@@ -0,0 +1,18 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: generation of the table file of p503_compressed
+*********************************************************************************************/
+
+#include "test_extras.h"
+#include "../src/P503/P503_compressed.c"
+
+
+#define SCHEME_NAME          "SIDHp503_compressed"
+#define TABLES_FILE          "p503_compressed.tbl"
+
+#include "tables_gen.c"
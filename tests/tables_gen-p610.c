@@ -0,0 +1,18 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: generation of the table file of p610_compressed
+*********************************************************************************************/
+
+#include "test_extras.h"
+#include "../src/P610/P610_compressed.c"
+
+
+#define SCHEME_NAME          "SIDHp610_compressed"
+#define TABLES_FILE          "p610_compressed.tbl"
+
+#include "tables_gen.c"
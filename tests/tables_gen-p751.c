@@ -0,0 +1,18 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: generation of the table file of p751_compressed
+*********************************************************************************************/
+
+#include "test_extras.h"
+#include "../src/P751/P751_compressed.c"
+
+
+#define SCHEME_NAME          "SIDHp751_compressed"
+#define TABLES_FILE          "p751_compressed.tbl"
+
+#include "tables_gen.c"
@@ -0,0 +1,612 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: generation of table files with the pairing and discrete log tables for compression
+*
+* Usage: tables_gen-pXXX [file [w2 w3]]
+*        tables_gen-pXXX --report
+*        tables_gen-pXXX --test w2 w3
+*   file:     output table file (TABLES_FILE by default), to be loaded with sidh_load_tables()
+*   w2, w3:   Pohlig-Hellman window sizes for the discrete logs in the groups of order 2^eA and 3^eB (the built-in
+*             W_2 and W_3 by default). Windows other than the built-in ones must satisfy ph_windows_supported()
+*   --report: for every supported pair of window sizes, table size versus measured cycles of the discrete logs and
+*             of the compressed key generations
+*   --test:   table file round trip, the tables for w2 and w3 are written to a temporary file and loaded, and must give
+*             the same compressed public keys and shared secrets as the built-in tables (run by make check_tables)
+*
+* The discrete log tables for w2 and w3 are computed from the generators g of the built-in tables: the tables ph2_CT and
+* ph3_T1 hold g^(-t*ell^(w*i)) for the signed digits t, ph3_T2 (when w3 does not divide eB) holds g^(-t*3^(w3*(i-1)+eB mod w3)),
+* ph2_G and ph2_Texp hold the torus coordinates and half-angle terms used by ord2w_dloghyb() and ord2w_dlog(), and the
+* ph2_Log table is obtained by running ord2w_dlog() on the powers of its generator. The traversal paths are optimal for
+* the costs of the squarings/cubings and multiplications measured on the host. Generated tables are checked against
+* the built-in ones for the built-in window sizes, and by solving discrete logs and running the key exchange otherwise.
+*********************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+
+#define COST_LOOPS      1000          // Number of iterations per cost measurement
+#define CHECK_LOOPS       10          // Number of discrete logs and key exchanges checked per pair of window sizes
+#define REPORT_LOOPS      10          // Number of measurements per operation in the report
+
+// Discrete log tables for a pair of window sizes, in the layout of the table file sections
+typedef struct {
+    ph_params_t params;
+    unsigned int* path2;
+    uint64_t* Texp;
+    int* Log;
+    uint64_t* G;
+    uint64_t* CT2;
+    unsigned int* path3;
+    uint64_t* T1;
+    uint64_t* T2;
+} ph_tables_t;
+
+static double cost_sqr2, cost_mul2, cost_cube3, cost_mul3;
+
+
+static void measure_costs(void)
+{ // Measuring the costs of the traversal primitives on the host: torus squaring and mixed multiplication for ell=2,
+  // cyclotomic cubing and multiplication for ell=3
+    unsigned long long cycles[4] = {0}, cycles1, cycles2;
+    felm_t a[2], alpha;
+    f2elm_t b, c;
+    unsigned int n;
+
+    fpcopy((digit_t*)ph2_CT, a[0]);
+    fpcopy((digit_t*)&Montgomery_one, a[1]);
+    fpcopy((digit_t*)ph2_CT, alpha);
+    fp2copy((felm_t*)PH3_T1_BUILTIN, b);
+    fp2copy((felm_t*)PH3_T1_BUILTIN, c);
+    for (n = 0; n < COST_LOOPS; n++) {
+        cycles1 = cpucycles();
+        sqr_Fp2_cycl_proj(a);
+        cycles2 = cpucycles();
+        cycles[0] += cycles2-cycles1;
+
+        cycles1 = cpucycles();
+        mulmixed_montproj(a, alpha, a);
+        cycles2 = cpucycles();
+        cycles[1] += cycles2-cycles1;
+
+        cycles1 = cpucycles();
+        cube_Fp2_cycl(b, (digit_t*)&Montgomery_one);
+        cycles2 = cpucycles();
+        cycles[2] += cycles2-cycles1;
+
+        cycles1 = cpucycles();
+        fp2mul_mont(b, c, b);
+        cycles2 = cpucycles();
+        cycles[3] += cycles2-cycles1;
+    }
+    cost_sqr2 = (double)cycles[0]/COST_LOOPS;
+    cost_mul2 = (double)cycles[1]/COST_LOOPS;
+    cost_cube3 = (double)cycles[2]/COST_LOOPS;
+    cost_mul3 = (double)cycles[3]/COST_LOOPS;
+}
+
+
+static void optimal_path(const unsigned int dlen, const unsigned int w, const double sqr, const double mul, unsigned int* P)
+{ // Optimal Pohlig-Hellman traversal path with dlen leaves, for a cost sqr of a squaring (cubing) and mul of a multiplication.
+  // A subtree with z leaves is split as P[z] leaves after w*(z-P[z]) squarings (cubings) and z-P[z] leaves after P[z]
+  // multiplications. When w does not divide the exponent the first chain is shorter by w - (e mod w) squarings (cubings),
+  // which is ignored since the path is shared by all subtrees
+    double* C = (double*)calloc(dlen + 1, sizeof(double));
+    double c;
+
+    P[0] = P[1] = 0;
+    for (unsigned int z = 2; z <= dlen; z++) {
+        C[z] = -1;
+        for (unsigned int t = 1; t < z; t++) {
+            c = C[t] + C[z-t] + (double)(z-t)*w*sqr + (double)t*mul;
+            if (C[z] < 0 || c < C[z]) {
+                C[z] = c;
+                P[z] = t;
+            }
+        }
+    }
+    free(C);
+}
+
+
+static void fp_sqrt(const felm_t a, felm_t r)
+{ // Square root r = a^((p+1)/4) of a square a in GF(p), with (p+1)/4 = 2^(eA-2)*3^eB
+    felm_t t;
+
+    fpcopy(a, r);
+    for (unsigned int i = 0; i < OBOB_EXPON; i++) {
+        fpsqr_mont(r, t);
+        fpmul_mont(r, t, r);
+    }
+    for (unsigned int i = 0; i < OALICE_BITS - 2; i++) {
+        fpsqr_mont(r, t);
+        fpcopy(t, r);
+    }
+}
+
+
+static void proj_alpha(const felm_t* a, felm_t alpha)
+{ // Coordinate alpha of a torus element a = [x:y] = [alpha:1], y != 0
+    felm_t t;
+
+    fpcopy(a[1], t);
+    fpinv_mont(t);
+    fpmul_mont(a[0], t, alpha);
+    fpcorrection(alpha);
+}
+
+
+static void fp2_exp(const f2elm_t a, const digit_t* k, const unsigned int nbits, f2elm_t c)
+{ // c = a^k, variable-time left-to-right exponentiation
+    f2elm_t t;
+
+    fp2zero(t);
+    fpcopy((digit_t*)&Montgomery_one, t[0]);
+    for (unsigned int i = nbits; i-- > 0;) {
+        fp2sqr_mont(t, t);
+        if ((k[i/RADIX] >> (i%RADIX)) & 1) fp2mul_mont(t, a, t);
+    }
+    fp2copy(t, c);
+    fp2correction(c);
+}
+
+
+static void ph_tables_free(ph_tables_t* tables)
+{
+    free(tables->path2); free(tables->Texp); free(tables->Log); free(tables->G); free(tables->CT2);
+    free(tables->path3); free(tables->T1); free(tables->T2);
+}
+
+
+static void ph_tables_activate(const ph_tables_t* tables)
+{ // Using the tables for the discrete logs, until sidh_load_tables() is called
+    ph_params_active = tables->params;
+    ph2_path_active = tables->path2;
+    ph2_Texp_active = tables->Texp;
+    ph2_Log_active = tables->Log;
+    ph2_G_active = tables->G;
+    ph2_CT_active = tables->CT2;
+    ph3_path_active = tables->path3;
+    ph3_T1_active = tables->T1;
+    ph3_T2_active = tables->T2;
+}
+
+
+static int ph_tables_generate(ph_tables_t* tables, const unsigned int w2, const unsigned int w3)
+{ // Discrete log tables for window sizes w2 and w3. Returns 0 on success
+    const unsigned int nfelm = NWORDS64_FIELD;
+    ph_params_t* prm = &tables->params;
+    uint64_t size[TABLES_NSECTIONS];
+    unsigned int half2, half3, w1, npow;
+    felm_t h[2], base[2], acc[2], alpha, (*pw)[2], *A, t;
+    f2elm_t hb, hacc, hb2;
+    int logprobe[1 << (PH_W2_MAX-1)], found;
+    felm_t prods[PH2_DLOG_PRODS];
+
+    memset(tables, 0, sizeof(ph_tables_t));
+    ph_params_init(prm, w2, w3);
+    tables_sizes(prm, size);
+    tables->path2 = (unsigned int*)calloc(1, size[TABLE_PH2_PATH]);
+    tables->Texp = (uint64_t*)calloc(1, size[TABLE_PH2_TEXP] + 1);
+    tables->Log = (int*)calloc(1, size[TABLE_PH2_LOG]);
+    tables->G = (uint64_t*)calloc(1, size[TABLE_PH2_G]);
+    tables->CT2 = (uint64_t*)calloc(1, size[TABLE_PH2_CT]);
+    tables->path3 = (unsigned int*)calloc(1, size[TABLE_PH3_PATH]);
+    tables->T1 = (uint64_t*)calloc(1, size[TABLE_PH3_T1]);
+    tables->T2 = (uint64_t*)calloc(1, size[TABLE_PH3_T2] + 1);
+    if (tables->path2 == NULL || tables->Texp == NULL || tables->Log == NULL || tables->G == NULL || tables->CT2 == NULL ||
+        tables->path3 == NULL || tables->T1 == NULL || tables->T2 == NULL) {
+        ph_tables_free(tables);
+        return -1;
+    }
+    half2 = prm->ellw2 >> 1;
+    half3 = prm->ellw3 >> 1;
+    w1 = prm->w2_1;
+
+    // ell=2: h = [CT[0]:1] = g^-1 for the generator g of the group of order 2^eA
+    fpcopy((digit_t*)ph2_CT, h[0]);
+    fpcopy((digit_t*)&Montgomery_one, h[1]);
+    fp2copy(h, base);
+    for (unsigned int i = 0; i < prm->dlen2; i++) {                  // CT[i][t-1] = h^(t*2^(w2*i))
+        proj_alpha(base, alpha);
+        fp2copy(base, acc);
+        for (unsigned int k = 0; k < half2; k++) {
+            proj_alpha(acc, t);
+            fpcopy(t, tables->CT2 + (i*half2 + k)*nfelm);
+            mulmixed_montproj(acc, alpha, acc);
+        }
+        for (unsigned int k = 0; k < w2; k++) sqr_Fp2_cycl_proj(base);
+    }
+
+    // Powers of rho = g^(2^(eA-w2)), the generator of the digits
+    npow = 1 << w2;
+    pw = (felm_t(*)[2])calloc(npow, sizeof(*pw));
+    A = (felm_t*)calloc(npow, sizeof(felm_t));
+    if (pw == NULL || A == NULL) {
+        free(pw); free(A); ph_tables_free(tables);
+        return -1;
+    }
+    fp2copy(h, base);
+    for (unsigned int k = 0; k < OALICE_BITS - w2; k++) sqr_Fp2_cycl_proj(base);
+    inv_Fp2_cycl_proj(base);
+    proj_alpha(base, alpha);
+    fpcopy((digit_t*)&Montgomery_one, pw[0][0]);
+    fp2copy(base, pw[1]);
+    for (unsigned int d = 2; d < npow; d++) mulmixed_montproj(pw[d-1], alpha, pw[d]);
+
+    // G[0] = rho^(2^(w2-2)), and G[2^(ord-2) + i] = rho^(2^(w1-ord)*(2*reverse_bits(i, ord-1)+1)) for ord = 2,...,w1
+    proj_alpha(pw[1 << (w2-2)], tables->G);
+    for (unsigned int ord = 2; ord <= w1; ord++) {
+        for (unsigned int i = 0; i < (1u << (ord-2)); i++) {
+            proj_alpha(pw[(1 << (w1-ord))*(2*reverse_bits(i, ord-1) + 1)], tables->G + ((1 << (ord-2)) + i)*nfelm);
+        }
+    }
+
+    // Texp[2^k + n - 1] = sqrt(1 + A_{k+1}[n]^2), with A_1[0] = 1 and A_{k+2}[2n], A_{k+2}[2n+1] = A_{k+1}[n] +/- Texp[2^k + n - 1]
+    fpcopy((digit_t*)&Montgomery_one, A[0]);
+    for (unsigned int k = 0; k + 3 <= w1; k++) {
+        for (unsigned int n = (1 << k); n-- > 0;) {                  // In place, from the last node of the level
+            felm_t sq, root;
+            fpsqr_mont(A[n], sq);
+            fpadd(sq, (digit_t*)&Montgomery_one, sq);
+            fp_sqrt(sq, root);
+            fpcorrection(root);
+            fpcopy(root, tables->Texp + ((1 << k) + n - 1)*nfelm);
+            fpsub(A[n], root, A[2*n+1]);
+            fpadd(A[n], root, A[2*n]);
+            fpsqr_mont(root, t);
+            fpcorrection(t);
+            fpcorrection(sq);
+            if (memcmp(t, sq, sizeof(felm_t)) != 0) {
+                free(pw); free(A); ph_tables_free(tables);
+                return -1;
+            }
+        }
+    }
+
+    // Log table, by running ord2w_dlog() with a probe table on the powers rho^(2m) of its generator
+    ph_tables_activate(tables);
+    for (unsigned int i = 0; i < (1u << w1) - 1; i++) logprobe[i] = (int)i + 1;
+    found = 0;
+    for (unsigned int m = 1; m < (1u << w1); m++) {
+        int idx = ord2w_dlog((const felm_t*)pw[2*m], logprobe, (const felm_t*)tables->Texp, prods) - 1;
+        if (idx < 0 || idx >= (int)(1u << w1) - 1) break;
+        tables->Log[idx] = (m > (1u << (w1-1))) ? (int)m - (1 << w1) : (int)m;
+        found++;
+    }
+    sidh_load_tables(NULL);
+    free(pw);
+    free(A);
+    if (found != (1 << w1) - 1) {
+        ph_tables_free(tables);
+        return -1;
+    }
+
+    // ell=3: hb = g^-1 for the generator g of the group of order 3^eB
+    fp2copy((felm_t*)PH3_T1_BUILTIN, hb);
+    fp2copy(hb, hacc);
+    for (unsigned int i = 0; i < prm->dlen3; i++) {                  // T1[i][t-1] = hb^(t*3^(w3*i))
+        f2elm_t x;
+        fp2copy(hacc, x);
+        for (unsigned int k = 0; k < half3; k++) {
+            fp2correction(x);
+            fp2copy(x, (felm_t*)(tables->T1 + 2*(i*half3 + k)*nfelm));
+            fp2mul_mont(x, hacc, x);
+        }
+        for (unsigned int k = 0; k < w3; k++) cube_Fp2_cycl(hacc, (digit_t*)&Montgomery_one);
+    }
+    if (OBOB_EXPON % w3 != 0) {                                      // T2[0] = T1[0], T2[i][t-1] = hb^(t*3^(w3*(i-1) + eB mod w3))
+        memcpy(tables->T2, tables->T1, half3*2*sizeof(felm_t));
+        fp2copy(hb, hb2);
+        for (unsigned int k = 0; k < OBOB_EXPON % w3; k++) cube_Fp2_cycl(hb2, (digit_t*)&Montgomery_one);
+        for (unsigned int i = 1; i < prm->dlen3; i++) {
+            f2elm_t x;
+            fp2copy(hb2, x);
+            for (unsigned int k = 0; k < half3; k++) {
+                fp2correction(x);
+                fp2copy(x, (felm_t*)(tables->T2 + 2*(i*half3 + k)*nfelm));
+                fp2mul_mont(x, hb2, x);
+            }
+            for (unsigned int k = 0; k < w3; k++) cube_Fp2_cycl(hb2, (digit_t*)&Montgomery_one);
+        }
+    }
+
+    optimal_path(prm->dlen2, w2, cost_sqr2, cost_mul2, tables->path2);
+    optimal_path(prm->dlen3, w3, cost_cube3, cost_mul3, tables->path3);
+    return 0;
+}
+
+
+static int ph_tables_match_builtin(const ph_tables_t* tables)
+{ // Checking tables generated for the built-in window sizes against the built-in tables. The last row of ph2_CT is not
+  // used by the traversal and is not compared
+    uint64_t size[TABLES_NSECTIONS];
+    const uint64_t felm = NWORDS64_FIELD*sizeof(uint64_t);
+
+    tables_sizes(&tables->params, size);
+    if (memcmp(tables->CT2, ph2_CT, size[TABLE_PH2_CT] - (ELL2_W >> 1)*felm) != 0) return 0;
+    if (memcmp(tables->G, ph2_G, size[TABLE_PH2_G]) != 0) return 0;
+    if (memcmp(tables->Texp, ph2_Texp, size[TABLE_PH2_TEXP]) != 0) return 0;
+    if (memcmp(tables->Log, ph2_Log, size[TABLE_PH2_LOG]) != 0) return 0;
+    if (memcmp(tables->T1, PH3_T1_BUILTIN, size[TABLE_PH3_T1]) != 0) return 0;
+#if (OBOB_EXPON % W_3 != 0)
+    if (memcmp(tables->T2, ph3_T2, size[TABLE_PH3_T2]) != 0) return 0;
+#endif
+    return 1;
+}
+
+
+static void random_exponent(digit_t* k)
+{ // Random exponent of NWORDS_ORDER words
+    memset(k, 0, NWORDS_ORDER*sizeof(digit_t));
+    randombytes((unsigned char*)k, NWORDS_ORDER*sizeof(digit_t));
+}
+
+
+static void random_dlog_input(const int ell, f2elm_t r)
+{ // Random r = g^k in the group of order ell^e used by solve_dlog()
+    f2elm_t g;
+    felm_t h[2];
+    digit_t k[NWORDS_ORDER];
+
+    if (ell == 2) {
+        fpcopy((digit_t*)ph2_CT, h[0]);
+        fpcopy((digit_t*)&Montgomery_one, h[1]);
+        fromproj((const felm_t*)h, g);
+    } else {
+        fp2copy((felm_t*)PH3_T1_BUILTIN, g);
+    }
+    random_exponent(k);
+    fp2_exp(g, k, NWORDS_ORDER*RADIX, r);
+}
+
+
+static int check_dlog(const int ell)
+{ // Checking solve_dlog() with the tables in use on a random input r = g^d, i.e., hb^d * r = 1 for hb = g^-1
+    f2elm_t r, g, c;
+    felm_t h[2];
+    digit_t d[NWORDS_ORDER] = {0};
+    int D[DLEN_2 > DLEN_3 ? DLEN_2 : DLEN_3];
+    felm_t prods[PH2_DLOG_PRODS];
+
+    random_dlog_input(ell, r);
+    solve_dlog(r, D, d, ell, prods);
+    if (ell == 2) {
+        fpcopy((digit_t*)ph2_CT, h[0]);
+        fpcopy((digit_t*)&Montgomery_one, h[1]);
+        fromproj((const felm_t*)h, g);
+    } else {
+        fp2copy((felm_t*)PH3_T1_BUILTIN, g);
+    }
+    fp2_exp(g, d, NWORDS_ORDER*RADIX, c);
+    fp2mul_mont(c, r, c);
+    fp2correction(c);
+    return (is_felm_zero(c[1]) && memcmp(c[0], &Montgomery_one, sizeof(felm_t)) == 0);
+}
+
+
+static int check_kex(void)
+{ // Checking the compressed key exchange with the tables in use
+    unsigned char PrivateKeyA[SIDH_SECRETKEYBYTES_A], PrivateKeyB[SIDH_SECRETKEYBYTES_B];
+    unsigned char PublicKeyA[SIDH_PUBLICKEYBYTES], PublicKeyB[SIDH_PUBLICKEYBYTES];
+    unsigned char SharedSecretA[SIDH_BYTES], SharedSecretB[SIDH_BYTES];
+
+    random_mod_order_A(PrivateKeyA);
+    random_mod_order_B(PrivateKeyB);
+    EphemeralKeyGeneration_A(PrivateKeyA, PublicKeyA);
+    EphemeralKeyGeneration_B(PrivateKeyB, PublicKeyB);
+    EphemeralSecretAgreement_A(PrivateKeyA, PublicKeyB, SharedSecretA);
+    EphemeralSecretAgreement_B(PrivateKeyB, PublicKeyA, SharedSecretB);
+    return (memcmp(SharedSecretA, SharedSecretB, SIDH_BYTES) == 0);
+}
+
+
+static int ph_tables_check(const ph_tables_t* tables)
+{ // Checking generated tables, returns 1 if they are correct
+    int ok = 1;
+
+    if (tables->params.w2 == W_2 && tables->params.w3 == W_3 && !ph_tables_match_builtin(tables)) return 0;
+    ph_tables_activate(tables);
+    for (unsigned int n = 0; n < CHECK_LOOPS && ok; n++) {
+        ok = check_dlog(2) && check_dlog(3) && check_kex();
+    }
+    sidh_load_tables(NULL);
+    return ok;
+}
+
+
+static int compare_cycles(const void* a, const void* b)
+{
+    unsigned long long x = *(const unsigned long long*)a, y = *(const unsigned long long*)b;
+    return (x > y) - (x < y);
+}
+
+
+static unsigned long long median_cycles(unsigned long long* samples)
+{
+    qsort(samples, REPORT_LOOPS, sizeof(unsigned long long), compare_cycles);
+    return samples[REPORT_LOOPS/2];
+}
+
+
+static void report_windows(const ph_tables_t* tables)
+{ // One line of the report: table sizes and median cycles of the discrete logs and key generations with the tables
+    unsigned long long dlog2[REPORT_LOOPS], dlog3[REPORT_LOOPS], keygenA[REPORT_LOOPS], keygenB[REPORT_LOOPS], cycles1;
+    unsigned char PrivateKeyA[SIDH_SECRETKEYBYTES_A], PrivateKeyB[SIDH_SECRETKEYBYTES_B], PublicKey[SIDH_PUBLICKEYBYTES];
+    uint64_t size[TABLES_NSECTIONS], bytes2, bytes3;
+    tables_entry_t entries[TABLES_NSECTIONS];
+    int D[DLEN_2 > DLEN_3 ? DLEN_2 : DLEN_3];
+    digit_t d[NWORDS_ORDER];
+    f2elm_t r;
+    felm_t prods[PH2_DLOG_PRODS];
+
+    tables_sizes(&tables->params, size);
+    bytes2 = size[TABLE_PH2_PATH] + size[TABLE_PH2_TEXP] + size[TABLE_PH2_LOG] + size[TABLE_PH2_G] + size[TABLE_PH2_CT];
+    bytes3 = size[TABLE_PH3_PATH] + size[TABLE_PH3_T1] + size[TABLE_PH3_T2];
+
+    ph_tables_activate(tables);
+    for (unsigned int n = 0; n < REPORT_LOOPS; n++) {
+        random_dlog_input(2, r);
+        cycles1 = cpucycles();
+        solve_dlog(r, D, d, 2, prods);
+        dlog2[n] = cpucycles() - cycles1;
+
+        random_dlog_input(3, r);
+        cycles1 = cpucycles();
+        solve_dlog(r, D, d, 3, NULL);
+        dlog3[n] = cpucycles() - cycles1;
+
+        random_mod_order_A(PrivateKeyA);
+        cycles1 = cpucycles();
+        EphemeralKeyGeneration_A(PrivateKeyA, PublicKey);
+        keygenA[n] = cpucycles() - cycles1;
+
+        random_mod_order_B(PrivateKeyB);
+        cycles1 = cpucycles();
+        EphemeralKeyGeneration_B(PrivateKeyB, PublicKey);
+        keygenB[n] = cpucycles() - cycles1;
+    }
+    sidh_load_tables(NULL);
+
+    printf("  %3u %3u %12llu %12llu %12llu %12llu %14llu %14llu\n", tables->params.w2, tables->params.w3,
+           (unsigned long long)tables_layout(entries, &tables->params), (unsigned long long)(bytes2 + bytes3),
+           median_cycles(dlog2), median_cycles(dlog3), median_cycles(keygenA), median_cycles(keygenB));
+}
+
+
+static int report(void)
+{ // Table size versus measured time for every supported pair of window sizes
+    ph_tables_t tables;
+
+    printf("\n  %s: Pohlig-Hellman window sizes, table sizes (bytes) and median cycles of %u runs\n\n", SCHEME_NAME, REPORT_LOOPS);
+    printf("   w2  w3   file bytes   dlog bytes  dlog_2^eA   dlog_3^eB   KeyGen_A(comp) KeyGen_B(comp)\n");
+    for (unsigned int w2 = W_2; w2 <= PH_W2_MAX; w2++) {
+        for (unsigned int w3 = W_3; w3 <= PH_W3_MAX; w3++) {
+            if (!ph_windows_supported(w2, w3)) continue;
+            if (ph_tables_generate(&tables, w2, w3) != 0 || !ph_tables_check(&tables)) {
+                printf("  Error: tables for w2 = %u, w3 = %u are incorrect\n", w2, w3);
+                return 1;
+            }
+            report_windows(&tables);
+            ph_tables_free(&tables);
+        }
+    }
+    return 0;
+}
+
+
+static int round_trip(const unsigned int w2, const unsigned int w3)
+{ // Table file round trip for window sizes w2 and w3, returns 0 on success
+    unsigned char PrivateKeyA[SIDH_SECRETKEYBYTES_A], PrivateKeyB[SIDH_SECRETKEYBYTES_B];
+    unsigned char PublicKeyA[2][SIDH_PUBLICKEYBYTES] = {0}, PublicKeyB[2][SIDH_PUBLICKEYBYTES] = {0};    // Zeroed, Bob's key leaves the last bytes of p751 unset
+    unsigned char SharedSecretA[2][SIDH_BYTES], SharedSecretB[2][SIDH_BYTES];
+    const char* dir = getenv("TMPDIR");
+    char path[256];
+    ph_tables_t tables;
+    int fd, ok;
+
+    snprintf(path, sizeof(path), "%s/%s_XXXXXX", (dir != NULL && *dir != '\0') ? dir : "/tmp", SCHEME_NAME);
+    fd = mkstemp(path);
+    if (fd < 0) {
+        printf("  Error: cannot create a temporary file in %s\n", (dir != NULL && *dir != '\0') ? dir : "/tmp");
+        return 1;
+    }
+    close(fd);
+
+    ok = (ph_tables_generate(&tables, w2, w3) == 0);
+    if (ok) {
+        ph_tables_activate(&tables);
+        ok = (sidh_write_tables(path) == 0);
+        sidh_load_tables(NULL);
+        ph_tables_free(&tables);
+    }
+    for (unsigned int n = 0; n < CHECK_LOOPS && ok; n++) {
+        random_mod_order_A(PrivateKeyA);
+        random_mod_order_B(PrivateKeyB);
+        for (unsigned int t = 0; t < 2 && ok; t++) {    // The built-in tables (t = 0), then those of the file (t = 1)
+            ok = (sidh_load_tables(t == 0 ? NULL : path) == 0);
+            EphemeralKeyGeneration_A(PrivateKeyA, PublicKeyA[t]);
+            EphemeralKeyGeneration_B(PrivateKeyB, PublicKeyB[t]);
+            EphemeralSecretAgreement_A(PrivateKeyA, PublicKeyB[t], SharedSecretA[t]);
+            EphemeralSecretAgreement_B(PrivateKeyB, PublicKeyA[t], SharedSecretB[t]);
+        }
+        ok = ok && memcmp(PublicKeyA[0], PublicKeyA[1], SIDH_PUBLICKEYBYTES) == 0 && memcmp(PublicKeyB[0], PublicKeyB[1], SIDH_PUBLICKEYBYTES) == 0;
+        ok = ok && memcmp(SharedSecretA[0], SharedSecretB[0], SIDH_BYTES) == 0 && memcmp(SharedSecretA[0], SharedSecretA[1], SIDH_BYTES) == 0 && 
+             memcmp(SharedSecretA[0], SharedSecretB[1], SIDH_BYTES) == 0;
+    }
+    sidh_load_tables(NULL);
+    remove(path);
+
+    if (ok) printf("  %s table file round trip (w2 = %u, w3 = %u) ................ PASSED\n", SCHEME_NAME, w2, w3);
+    else printf("  %s table file round trip (w2 = %u, w3 = %u) ... FAILED\n", SCHEME_NAME, w2, w3);
+    return ok ? 0 : 1;
+}
+
+
+int main(int argc, char **argv)
+{
+    const char* path = (argc > 1) ? argv[1] : TABLES_FILE;
+    unsigned int w2 = W_2, w3 = W_3;
+    ph_tables_t tables;
+    int generated = 0;
+    FILE* f;
+    long size = 0;
+
+    measure_costs();
+    if (argc == 2 && strcmp(argv[1], "--report") == 0) {
+        return report();
+    }
+    if (argc == 4) {
+        w2 = (unsigned int)atoi(argv[2]);
+        w3 = (unsigned int)atoi(argv[3]);
+    } else if (argc > 2) {
+        fprintf(stderr, "Usage: %s [file [w2 w3]]\n       %s --report\n       %s --test w2 w3\n", argv[0], argv[0], argv[0]);
+        return 1;
+    }
+    if (!ph_windows_supported(w2, w3)) {
+        printf("  Error: window sizes w2 = %u, w3 = %u are not supported (w2 in [%u, %u] dividing %u, w3 in [%u, %u])\n",
+               w2, w3, W_2, PH_W2_MAX, OALICE_BITS, W_3, PH_W3_MAX);
+        return 1;
+    }
+    if (strcmp(path, "--test") == 0) {
+        return round_trip(w2, w3);
+    }
+    if (w2 != W_2 || w3 != W_3) {                       // The built-in tables are written as they are
+        if (ph_tables_generate(&tables, w2, w3) != 0 || !ph_tables_check(&tables)) {
+            printf("  Error: tables for w2 = %u, w3 = %u are incorrect\n", w2, w3);
+            return 1;
+        }
+        ph_tables_activate(&tables);
+        generated = 1;
+    }
+
+    if (sidh_write_tables(path) != 0) {
+        printf("  Error: cannot write %s\n", path);
+        return 1;
+    }
+    if (generated) {
+        sidh_load_tables(NULL);
+        ph_tables_free(&tables);
+    }
+    if (sidh_load_tables(path) != 0) {                  // Check that the file is accepted by the library
+        printf("  Error: %s is rejected by the library\n", path);
+        return 1;
+    }
+    sidh_load_tables(NULL);
+
+    f = fopen(path, "rb");
+    if (f != NULL) {
+        fseek(f, 0, SEEK_END);
+        size = ftell(f);
+        fclose(f);
+    }
+    printf("  %s tables (w2 = %u, w3 = %u) written to %s (%ld bytes)\n", SCHEME_NAME, w2, w3, path, size);
+    return 0;
+}
@@ -22,5 +22,10 @@
 #define EphemeralKeyGeneration_B      EphemeralKeyGeneration_B_SIDHp503
 #define EphemeralSecretAgreement_A    EphemeralSecretAgreement_A_SIDHp503
 #define EphemeralSecretAgreement_B    EphemeralSecretAgreement_B_SIDHp503
+#define EphemeralSecretAgreement_A_ctx EphemeralSecretAgreement_A_ctx_SIDHp503
+#define EphemeralSecretAgreement_B_ctx EphemeralSecretAgreement_B_ctx_SIDHp503
+#define sike_pk_ctx                   sike_pk_ctx_SIKEp503
+#define sike_pk_ctx_init              sike_pk_ctx_init_SIKEp503
+#define sidh_load_strategies          sidh_load_strategies_SIDHp503
 
 #include "test_sidh.c"
\ No newline at end of file
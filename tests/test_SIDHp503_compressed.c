@@ -16,11 +16,17 @@
 
 #define SCHEME_NAME    "SIDHp503_compressed"
 
-#define random_mod_order_A            random_mod_order_A_SIDHp503
-#define random_mod_order_B            random_mod_order_B_SIDHp503
+#define random_mod_order_A            random_mod_order_A_SIDHp503_Compressed
+#define random_mod_order_B            random_mod_order_B_SIDHp503_Compressed
 #define EphemeralKeyGeneration_A      EphemeralKeyGeneration_A_SIDHp503_Compressed
 #define EphemeralKeyGeneration_B      EphemeralKeyGeneration_B_SIDHp503_Compressed
 #define EphemeralSecretAgreement_A    EphemeralSecretAgreement_A_SIDHp503_Compressed
 #define EphemeralSecretAgreement_B    EphemeralSecretAgreement_B_SIDHp503_Compressed
+#define EphemeralKeyGeneration_A_ex   EphemeralKeyGeneration_A_ex_SIDHp503_Compressed
+#define EphemeralKeyGeneration_B_ex   EphemeralKeyGeneration_B_ex_SIDHp503_Compressed
+#define EphemeralSecretAgreement_A_ex EphemeralSecretAgreement_A_ex_SIDHp503_Compressed
+#define EphemeralSecretAgreement_B_ex EphemeralSecretAgreement_B_ex_SIDHp503_Compressed
+#define sidh_load_tables              sidh_load_tables_SIDHp503_Compressed
+#define sidh_write_tables             sidh_write_tables_SIDHp503_Compressed
 
 #include "test_sidh.c"
\ No newline at end of file
@@ -18,6 +18,11 @@
 
 #define crypto_kem_keypair            crypto_kem_keypair_SIKEp217
 #define crypto_kem_enc                crypto_kem_enc_SIKEp217
+#define crypto_kem_enc_batch          crypto_kem_enc_batch_SIKEp217
+#define crypto_kem_enc_ctx            crypto_kem_enc_ctx_SIKEp217
+#define sike_pk_ctx                   sike_pk_ctx_SIKEp217
+#define sike_pk_ctx_init              sike_pk_ctx_init_SIKEp217
+#define crypto_kem_ct_validate        crypto_kem_ct_validate_SIKEp217
 #define crypto_kem_dec                crypto_kem_dec_SIKEp217
 
 #include "test_sike.c"
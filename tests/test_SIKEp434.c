@@ -18,6 +18,11 @@
 
 #define crypto_kem_keypair            crypto_kem_keypair_SIKEp434
 #define crypto_kem_enc                crypto_kem_enc_SIKEp434
+#define crypto_kem_enc_batch          crypto_kem_enc_batch_SIKEp434
+#define crypto_kem_enc_ctx            crypto_kem_enc_ctx_SIKEp434
+#define sike_pk_ctx                   sike_pk_ctx_SIKEp434
+#define sike_pk_ctx_init              sike_pk_ctx_init_SIKEp434
+#define crypto_kem_ct_validate        crypto_kem_ct_validate_SIKEp434
 #define crypto_kem_dec                crypto_kem_dec_SIKEp434
 
 #include "test_sike.c"
\ No newline at end of file
@@ -18,6 +18,11 @@
 
 #define crypto_kem_keypair            crypto_kem_keypair_SIKEp503
 #define crypto_kem_enc                crypto_kem_enc_SIKEp503
+#define crypto_kem_enc_batch          crypto_kem_enc_batch_SIKEp503
+#define crypto_kem_enc_ctx            crypto_kem_enc_ctx_SIKEp503
+#define sike_pk_ctx                   sike_pk_ctx_SIKEp503
+#define sike_pk_ctx_init              sike_pk_ctx_init_SIKEp503
+#define crypto_kem_ct_validate        crypto_kem_ct_validate_SIKEp503
 #define crypto_kem_dec                crypto_kem_dec_SIKEp503
 
 #include "test_sike.c"
\ No newline at end of file
@@ -19,5 +19,14 @@
 #define crypto_kem_keypair            crypto_kem_keypair_SIKEp610_compressed
 #define crypto_kem_enc                crypto_kem_enc_SIKEp610_compressed
 #define crypto_kem_dec                crypto_kem_dec_SIKEp610_compressed
+#define crypto_kem_dec_batch          crypto_kem_dec_batch_SIKEp610_compressed
+#define crypto_kem_keypair_ex         crypto_kem_keypair_ex_SIKEp610_compressed
+#define crypto_kem_enc_ex             crypto_kem_enc_ex_SIKEp610_compressed
+#define crypto_kem_dec_ex             crypto_kem_dec_ex_SIKEp610_compressed
+#define crypto_kem_dec_service_create crypto_kem_dec_service_create_SIKEp610_compressed
+#define crypto_kem_dec_service_submit crypto_kem_dec_service_submit_SIKEp610_compressed
+#define crypto_kem_dec_service_poll   crypto_kem_dec_service_poll_SIKEp610_compressed
+#define crypto_kem_dec_service_stats  crypto_kem_dec_service_stats_SIKEp610_compressed
+#define crypto_kem_dec_service_destroy crypto_kem_dec_service_destroy_SIKEp610_compressed
 
 #include "test_sike.c"
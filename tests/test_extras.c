@@ -48,7 +48,7 @@ int64_t cpucycles(void)
 #elif (OS_TARGET == OS_NIX) && (TARGET == TARGET_ARM || TARGET == TARGET_ARM64)
     struct timespec time;
 
-    clock_gettime(CLOCK_REALTIME, &time);
+    clock_gettime(CLOCK_MONOTONIC, &time);
     return (int64_t)(time.tv_sec*1e9 + time.tv_nsec);
 #else
     return 0;            
@@ -0,0 +1,143 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: tests and benchmarks of all the SIKE parameter sets of the unified library
+*********************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "test_extras.h"
+#include "../src/sike_scheme.h"
+
+
+// Benchmark and test parameters
+#if defined(GENERIC_IMPLEMENTATION) || (TARGET == TARGET_ARM)
+    #define BENCH_LOOPS        5      // Number of iterations per bench
+    #define TEST_LOOPS         5      // Number of iterations per test
+#else
+    #define BENCH_LOOPS       10
+    #define TEST_LOOPS        10
+#endif
+#define BATCH_SIZE             4      // Number of encapsulations of the batched tests
+
+
+int scheme_test(const sike_scheme* scheme)
+{ // Testing of the key encapsulation mechanism of a parameter set
+    unsigned int n, i;
+    bool passed = true;
+    unsigned char *sk = malloc(scheme->secret_key_bytes);
+    unsigned char *pk = malloc(scheme->public_key_bytes);
+    unsigned char *ct = malloc(BATCH_SIZE*scheme->ciphertext_bytes);
+    unsigned char *ss = malloc(BATCH_SIZE*scheme->shared_secret_bytes);
+    unsigned char *ss_ = malloc(scheme->shared_secret_bytes);
+
+    for (n = 0; n < TEST_LOOPS; n++)
+    {
+        scheme->keypair(pk, sk);
+        scheme->enc(ct, ss, pk);
+        scheme->dec(ss_, ct, sk);
+        if (memcmp(ss, ss_, scheme->shared_secret_bytes) != 0) {
+            passed = false;
+            break;
+        }
+        if (scheme->ct_validate != NULL && scheme->ct_validate(ct) != 0) {
+            passed = false;
+            break;
+        }
+        if (scheme->enc_batch != NULL) {
+            scheme->enc_batch(ct, ss, pk, BATCH_SIZE);
+            for (i = 0; i < BATCH_SIZE; i++) {
+                scheme->dec(ss_, &ct[i*scheme->ciphertext_bytes], sk);
+                if (memcmp(&ss[i*scheme->shared_secret_bytes], ss_, scheme->shared_secret_bytes) != 0) passed = false;
+            }
+            if (passed == false) break;
+        }
+    }
+    if (sike_get_scheme(scheme->name) != scheme) passed = false;
+
+    printf("  %-24s KEM tests ...................................... ", scheme->name);
+    if (passed == true) printf("PASSED");
+    else printf("FAILED");
+    printf("\n");
+
+    free(sk); free(pk); free(ct); free(ss); free(ss_);
+    return (passed == true) ? PASSED : FAILED;
+}
+
+
+int scheme_run(const sike_scheme* scheme)
+{ // Benchmarking of the key encapsulation mechanism of a parameter set
+    unsigned int n;
+    unsigned char *sk = malloc(scheme->secret_key_bytes);
+    unsigned char *pk = malloc(scheme->public_key_bytes);
+    unsigned char *ct = malloc(scheme->ciphertext_bytes);
+    unsigned char *ss = malloc(scheme->shared_secret_bytes);
+    unsigned long long cycles_keygen = 0, cycles_encaps = 0, cycles_decaps = 0, cycles1, cycles2;
+
+    for (n = 0; n < BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles();
+        scheme->keypair(pk, sk);
+        cycles2 = cpucycles();
+        cycles_keygen = cycles_keygen+(cycles2-cycles1);
+
+        cycles1 = cpucycles();
+        scheme->enc(ct, ss, pk);
+        cycles2 = cpucycles();
+        cycles_encaps = cycles_encaps+(cycles2-cycles1);
+
+        cycles1 = cpucycles();
+        scheme->dec(ss, ct, sk);
+        cycles2 = cpucycles();
+        cycles_decaps = cycles_decaps+(cycles2-cycles1);
+    }
+
+    printf("  %-24s %12lld %12lld %12lld ", scheme->name, cycles_keygen/BENCH_LOOPS, cycles_encaps/BENCH_LOOPS, cycles_decaps/BENCH_LOOPS); print_unit;
+    printf("\n");
+
+    free(sk); free(pk); free(ct); free(ss);
+    return PASSED;
+}
+
+
+int main(int argc, char **argv)
+{
+    int Status = PASSED;
+    unsigned int i;
+    const sike_scheme* scheme;
+
+    printf("\n\nTESTING ISOGENY-BASED KEY ENCAPSULATION MECHANISMS OF THE UNIFIED LIBRARY\n");
+    printf("--------------------------------------------------------------------------------------------------------\n\n");
+
+    for (i = 0; (scheme = sike_get_scheme_at(i)) != NULL; i++) {
+        Status |= scheme_test(scheme);
+    }
+    if (sike_get_scheme("SIKEp434_compressed") == NULL || sike_get_scheme("SIKEp0") != NULL) {
+        printf("\n\n   Error: scheme lookup by name failed\n\n");
+        Status = FAILED;
+    }
+    if (Status != PASSED) {
+        printf("\n\n   Error detected: KEM_ERROR_SHARED_KEY \n\n");
+        return FAILED;
+    }
+
+    if ((argc > 1) && (strcmp("nobench", argv[1]) == 0)) {
+        return Status;
+    }
+
+    printf("\n\nBENCHMARKING ISOGENY-BASED KEY ENCAPSULATION MECHANISMS OF THE UNIFIED LIBRARY\n");
+    printf("--------------------------------------------------------------------------------------------------------\n\n");
+    printf("  %-24s %12s %12s %12s\n", "Scheme", "Keygen", "Encaps", "Decaps");
+
+    for (i = 0; (scheme = sike_get_scheme_at(i)) != NULL; i++) {
+        Status |= scheme_run(scheme);
+    }
+
+    return Status;
+}
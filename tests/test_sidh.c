@@ -18,6 +18,12 @@
     #define TEST_LOOPS        10      
 #endif
 
+#if defined(SIDH_THREADS)
+    #include "../src/threads/threadpool.h"
+    #include <unistd.h>
+    #include <sys/wait.h>
+#endif
+
 
 int cryptotest_kex()
 { // Testing key exchange
@@ -50,6 +56,195 @@ int cryptotest_kex()
     else { printf("  Key exchange tests ... FAILED"); printf("\n"); return FAILED; }
     printf("\n"); 
 
+#ifdef EphemeralSecretAgreement_A_ctx
+    sike_pk_ctx ctxA, ctxB;
+    unsigned char SharedSecretA_[SIDH_BYTES], SharedSecretB_[SIDH_BYTES];
+
+    for (i = 0; i < TEST_LOOPS; i++) 
+    {
+        random_mod_order_A(PrivateKeyA);
+        random_mod_order_B(PrivateKeyB);
+
+        EphemeralKeyGeneration_A(PrivateKeyA, PublicKeyA);
+        EphemeralKeyGeneration_B(PrivateKeyB, PublicKeyB);
+        sike_pk_ctx_init(&ctxB, PublicKeyB);                                          // Precompute the context of Bob's public key
+        sike_pk_ctx_init(&ctxA, PublicKeyA);                                          // Precompute the context of Alice's public key
+        EphemeralSecretAgreement_A_ctx(PrivateKeyA, &ctxB, SharedSecretA);
+        EphemeralSecretAgreement_B_ctx(PrivateKeyB, &ctxA, SharedSecretB);
+        EphemeralSecretAgreement_A(PrivateKeyA, PublicKeyB, SharedSecretA_);
+        EphemeralSecretAgreement_B(PrivateKeyB, PublicKeyA, SharedSecretB_);
+        
+        if (memcmp(SharedSecretA, SharedSecretB, SIDH_BYTES) != 0 || memcmp(SharedSecretA, SharedSecretA_, SIDH_BYTES) != 0 ||
+            memcmp(SharedSecretB, SharedSecretB_, SIDH_BYTES) != 0) {
+            passed = false;
+            break;
+        }
+    }
+
+    if (passed == true) printf("  Public key context tests ..................................... PASSED");
+    else { printf("  Public key context tests ... FAILED"); printf("\n"); return FAILED; }
+    printf("\n"); 
+#endif
+
+#ifdef EphemeralKeyGeneration_A_ex
+    // The functions with a caller-supplied workspace give the same outputs. The workspace is unaligned and filled with garbage
+    static unsigned char workspace[SIDH_WORKSPACE_BYTES + 1];
+    unsigned char PublicKeyA_ex[SIDH_PUBLICKEYBYTES], PublicKeyB_ex[SIDH_PUBLICKEYBYTES];
+    unsigned char SharedSecretA_ex[SIDH_BYTES], SharedSecretB_ex[SIDH_BYTES];
+
+    memset(workspace, 0xA5, sizeof(workspace));
+    for (i = 0; i < TEST_LOOPS; i++) 
+    {
+        random_mod_order_A(PrivateKeyA);
+        random_mod_order_B(PrivateKeyB);
+
+        EphemeralKeyGeneration_A(PrivateKeyA, PublicKeyA);
+        EphemeralKeyGeneration_B(PrivateKeyB, PublicKeyB);
+        EphemeralSecretAgreement_A(PrivateKeyA, PublicKeyB, SharedSecretA);
+        EphemeralKeyGeneration_A_ex(PrivateKeyA, PublicKeyA_ex, workspace + 1);
+        EphemeralKeyGeneration_B_ex(PrivateKeyB, PublicKeyB_ex, workspace + 1);
+        EphemeralSecretAgreement_A_ex(PrivateKeyA, PublicKeyB_ex, SharedSecretA_ex, workspace + 1);
+        EphemeralSecretAgreement_B_ex(PrivateKeyB, PublicKeyA_ex, SharedSecretB_ex, workspace + 1);
+        
+        if (memcmp(PublicKeyA, PublicKeyA_ex, SIDH_PUBLICKEYBYTES) != 0 || memcmp(PublicKeyB, PublicKeyB_ex, SIDH_PUBLICKEYBYTES) != 0 ||
+            memcmp(SharedSecretA, SharedSecretA_ex, SIDH_BYTES) != 0 || memcmp(SharedSecretA, SharedSecretB_ex, SIDH_BYTES) != 0) {
+            passed = false;
+            break;
+        }
+    }
+
+    if (passed == true) printf("  Workspace tests .............................................. PASSED");
+    else { printf("  Workspace tests ... FAILED"); printf("\n"); return FAILED; }
+    printf("\n"); 
+#endif
+
+#ifdef sidh_load_strategies
+    unsigned int strat_A[SIDH_STRATEGY_LENGTH_A], strat_B[SIDH_STRATEGY_LENGTH_B];
+    unsigned char PublicKeyA__[SIDH_PUBLICKEYBYTES], PublicKeyB__[SIDH_PUBLICKEYBYTES];
+
+    // Multiplication-only strategies, which use a single intermediate point
+    for (i = 0; i < SIDH_STRATEGY_LENGTH_A; i++) strat_A[i] = SIDH_STRATEGY_LENGTH_A - i;
+    for (i = 0; i < SIDH_STRATEGY_LENGTH_B; i++) strat_B[i] = SIDH_STRATEGY_LENGTH_B - i;
+
+    random_mod_order_A(PrivateKeyA);
+    random_mod_order_B(PrivateKeyB);
+    EphemeralKeyGeneration_A(PrivateKeyA, PublicKeyA);
+    EphemeralKeyGeneration_B(PrivateKeyB, PublicKeyB);
+    EphemeralSecretAgreement_A(PrivateKeyA, PublicKeyB, SharedSecretA);
+
+    if (sidh_load_strategies(strat_A, strat_B) != 0) passed = false;
+    EphemeralKeyGeneration_A(PrivateKeyA, PublicKeyA__);
+    EphemeralKeyGeneration_B(PrivateKeyB, PublicKeyB__);
+    EphemeralSecretAgreement_B(PrivateKeyB, PublicKeyA__, SharedSecretB);
+    strat_B[0] += 1;                                                                  // Invalid strategy, must be rejected
+    if (sidh_load_strategies(NULL, strat_B) == 0) passed = false;
+    if (sidh_load_strategies(NULL, NULL) != 0) passed = false;                        // Restore the built-in strategies
+
+    if (memcmp(PublicKeyA, PublicKeyA__, SIDH_PUBLICKEYBYTES) != 0 || memcmp(PublicKeyB, PublicKeyB__, SIDH_PUBLICKEYBYTES) != 0 ||
+        memcmp(SharedSecretA, SharedSecretB, SIDH_BYTES) != 0) {
+        passed = false;
+    }
+
+    if (passed == true) printf("  Strategy loading tests ....................................... PASSED");
+    else { printf("  Strategy loading tests ... FAILED"); printf("\n"); return FAILED; }
+    printf("\n"); 
+#endif
+
+#ifdef sidh_load_tables
+    const char* tables_file = "test_tables.tbl";
+    FILE* f;
+    long size;
+    int c;
+
+    if (sidh_write_tables(tables_file) != 0 || sidh_load_tables(tables_file) != 0) passed = false;
+    for (i = 0; i < 2; i++) 
+    {
+        random_mod_order_A(PrivateKeyA);
+        random_mod_order_B(PrivateKeyB);
+        EphemeralKeyGeneration_A(PrivateKeyA, PublicKeyA);
+        EphemeralKeyGeneration_B(PrivateKeyB, PublicKeyB);
+        EphemeralSecretAgreement_A(PrivateKeyA, PublicKeyB, SharedSecretA);
+        EphemeralSecretAgreement_B(PrivateKeyB, PublicKeyA, SharedSecretB);
+        if (memcmp(SharedSecretA, SharedSecretB, SIDH_BYTES) != 0) passed = false;
+    }
+
+    if (sidh_load_tables(NULL) != 0) passed = false;                                  // Restore the built-in tables
+
+    // A file with a corrupted table must be rejected
+    f = fopen(tables_file, "r+b");
+    if (f == NULL || fseek(f, 0, SEEK_END) != 0 || (size = ftell(f)) <= 0 || fseek(f, size/2, SEEK_SET) != 0) {
+        passed = false;
+    } else {
+        c = fgetc(f);
+        fseek(f, size/2, SEEK_SET);
+        fputc(c ^ 1, f);
+    }
+    if (f != NULL) fclose(f);
+    if (sidh_load_tables(tables_file) == 0) passed = false;
+    if (sidh_load_tables("missing_tables.tbl") == 0) passed = false;
+
+    // A file with unsupported window sizes must be rejected
+    if (sidh_write_tables(tables_file) != 0) passed = false;
+    f = fopen(tables_file, "r+b");
+    if (f == NULL || fseek(f, 24, SEEK_SET) != 0) {                                    // w2 field of the header
+        passed = false;
+    } else {
+        fputc(1, f);
+    }
+    if (f != NULL) fclose(f);
+    if (sidh_load_tables(tables_file) == 0) passed = false;
+    if (sidh_load_tables(NULL) != 0) passed = false;
+    remove(tables_file);
+
+    if (passed == true) printf("  Table file loading tests ..................................... PASSED");
+    else { printf("  Table file loading tests ... FAILED"); printf("\n"); return FAILED; }
+    printf("\n"); 
+#endif
+
+#if defined(SIDH_THREADS)
+    unsigned char PublicKeyA_[SIDH_PUBLICKEYBYTES], PublicKeyB_[SIDH_PUBLICKEYBYTES];
+    bool skipped = false;
+
+    for (i = 0; i < TEST_LOOPS; i++) 
+    {
+        random_mod_order_A(PrivateKeyA);
+        random_mod_order_B(PrivateKeyB);
+
+        EphemeralKeyGeneration_A(PrivateKeyA, PublicKeyA);                            // Parallel key generation
+        EphemeralKeyGeneration_B(PrivateKeyB, PublicKeyB);
+        if (sidh_pool_acquire() == 0) {                                               // Holding the pool forces the serial path
+            skipped = true;
+            break;
+        }
+        EphemeralKeyGeneration_A(PrivateKeyA, PublicKeyA_);
+        EphemeralKeyGeneration_B(PrivateKeyB, PublicKeyB_);
+        sidh_pool_release();
+        
+        if (memcmp(PublicKeyA, PublicKeyA_, SIDH_PUBLICKEYBYTES) != 0 || memcmp(PublicKeyB, PublicKeyB_, SIDH_PUBLICKEYBYTES) != 0) {
+            passed = false;
+            break;
+        }
+    }
+
+    // The child of a fork() starts its own workers instead of waiting for those of the parent
+    if (passed == true && skipped == false) {
+        pid_t pid = fork();
+        int status;
+
+        if (pid == 0) {
+            alarm(60);                                                                // A child stuck waiting is killed
+            EphemeralKeyGeneration_A(PrivateKeyA, PublicKeyA_);
+            _exit(memcmp(PublicKeyA, PublicKeyA_, SIDH_PUBLICKEYBYTES) != 0);
+        }
+        if (pid < 0 || waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0) passed = false;
+    }
+
+    if (skipped == true) printf("  Parallel key generation tests ... SKIPPED, no worker pool");
+    else if (passed == true) printf("  Parallel key generation tests ................................ PASSED");
+    else { printf("  Parallel key generation tests ... FAILED"); printf("\n"); return FAILED; }
+    printf("\n"); 
+#endif
+
     return PASSED;
 }
 
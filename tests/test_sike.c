@@ -9,10 +9,21 @@
 *********************************************************************************************/ 
 
 #include "../src/random/random.h"
+#include "../src/sha3/fips202.h"
+#include "../src/sha3/fips202x4.h"
+#if defined(SIDH_PROFILE)
+    #include "../src/profile.h"
+#endif
 
 #ifdef DO_VALGRIND_CHECK
 #include <valgrind/memcheck.h>
 #endif
+#if defined(__NIX__)
+    #include <unistd.h>
+    #include <sys/wait.h>
+    #include <pthread.h>
+    #include <limits.h>
+#endif
 
 #ifdef DO_VALGRIND_CHECK
     #define TEST_LOOPS   1
@@ -30,6 +41,53 @@
     #define BENCH_LOOPS     1000    
 #endif
 
+#define BATCH_ENCAPS          11      // Number of encapsulations in a batch test, spanning more than one internal batch
+#define SERVICE_REQUESTS      12      // Number of decapsulations submitted in the service test, more than its capacity
+#define SERVICE_WORKERS        4      // Number of worker threads of the decapsulation service in the benchmark
+#define SERVICE_BENCH         64      // Number of decapsulations of the batched decapsulation and service benchmarks
+#define WORKSPACE_STACK    28672      // Thread stack size in bytes of the workspace tests, enough for SIKEp751_compressed
+
+
+static int test_source(void* ctx, unsigned char* random_array, unsigned long long nbytes)
+{ // Deterministic entropy source, random_array[i] = seed + i
+    unsigned long long i;
+
+    for (i = 0; i < nbytes; i++) {
+        random_array[i] = (unsigned char)(*(unsigned char*)ctx + i);
+    }
+    return 0;
+}
+
+
+#if defined(crypto_kem_keypair_ex) && defined(__NIX__)
+typedef struct {
+    unsigned char* workspace;
+    bool passed;
+} stack_test_t;
+
+static void* workspace_stack_test(void* arg)
+{ // Key generation, encapsulation and decapsulation with a workspace, run on a thread with a stack of WORKSPACE_STACK bytes
+    stack_test_t* test = (stack_test_t*)arg;
+    unsigned char sk[CRYPTO_SECRETKEYBYTES], pk[CRYPTO_PUBLICKEYBYTES], ct[CRYPTO_CIPHERTEXTBYTES];
+    unsigned char ss[CRYPTO_BYTES], ss_[CRYPTO_BYTES];
+
+    crypto_kem_keypair_ex(pk, sk, test->workspace);
+    crypto_kem_enc_ex(ct, ss, pk, test->workspace);
+    crypto_kem_dec_ex(ss_, ct, sk, test->workspace);
+    test->passed = (memcmp(ss, ss_, CRYPTO_BYTES) == 0);
+    return NULL;
+}
+#endif
+
+
+#if defined(crypto_kem_dec_service_create) && defined(__NIX__)
+static void service_callback(void* ctx, unsigned char* ss)
+{ // Counts the completions reported to ctx
+    (void)ss;
+    *(int*)ctx += 1;
+}
+#endif
+
 
 int cryptotest_kem()
 { // Testing KEM
@@ -89,6 +147,318 @@ int cryptotest_kem()
     else { printf("  KEM tests ... FAILED"); printf("\n"); return FAILED; }
     printf("\n"); 
 
+#ifdef crypto_kem_keypair_ex
+    // The functions with a caller-supplied workspace give the same outputs with the same randomness. The workspace is 
+    // unaligned and filled with garbage
+    static unsigned char workspace[CRYPTO_WORKSPACE_BYTES + 1];
+    unsigned char sk_ex[CRYPTO_SECRETKEYBYTES], pk_ex[CRYPTO_PUBLICKEYBYTES], ct_ex[CRYPTO_CIPHERTEXTBYTES], ss_ex[CRYPTO_BYTES];
+    unsigned char seed_ex = 3;
+
+    memset(workspace, 0xA5, sizeof(workspace));
+    for (i = 0; i < TEST_LOOPS; i++, seed_ex++) 
+    {
+        randombytes_set_source(test_source, &seed_ex);
+        crypto_kem_keypair(pk, sk);
+        randombytes_set_source(test_source, &seed_ex);
+        crypto_kem_keypair_ex(pk_ex, sk_ex, workspace + 1);
+        randombytes_set_source(test_source, &seed_ex);
+        crypto_kem_enc(ct, ss, pk);
+        randombytes_set_source(test_source, &seed_ex);
+        crypto_kem_enc_ex(ct_ex, ss_ex, pk_ex, workspace + 1);
+        if (memcmp(pk, pk_ex, CRYPTO_PUBLICKEYBYTES) != 0 || memcmp(sk, sk_ex, CRYPTO_SECRETKEYBYTES) != 0 ||
+            memcmp(ct, ct_ex, CRYPTO_CIPHERTEXTBYTES) != 0 || memcmp(ss, ss_ex, CRYPTO_BYTES) != 0) {
+            passed = false;
+            break;
+        }
+        crypto_kem_dec_ex(ss_, ct, sk, workspace + 1);
+        if (memcmp(ss, ss_, CRYPTO_BYTES) != 0) {
+            passed = false;
+            break;
+        }
+        ct[i] ^= 1;
+        crypto_kem_dec(ss, ct, sk);
+        crypto_kem_dec_ex(ss_, ct, sk, workspace + 1);
+        if (memcmp(ss, ss_, CRYPTO_BYTES) != 0) {
+            passed = false;
+            break;
+        }
+    }
+    randombytes_set_source(NULL, NULL);
+
+#if defined(__NIX__)
+    // The functions with a workspace run on a small thread stack
+    stack_test_t stack_test = { workspace + 1, false };
+    pthread_attr_t attr;
+    pthread_t thread;
+
+    if (pthread_attr_init(&attr) != 0) {
+        passed = false;
+    } else {
+        if (pthread_attr_setstacksize(&attr, WORKSPACE_STACK < PTHREAD_STACK_MIN ? PTHREAD_STACK_MIN : WORKSPACE_STACK) != 0 ||
+            pthread_create(&thread, &attr, workspace_stack_test, &stack_test) != 0 || pthread_join(thread, NULL) != 0 || 
+            stack_test.passed == false) passed = false;
+        pthread_attr_destroy(&attr);
+    }
+#endif
+
+    if (passed == true) printf("  Workspace tests .............................................. PASSED");
+    else { printf("  Workspace tests ... FAILED"); printf("\n"); return FAILED; }
+    printf("\n"); 
+#endif
+
+#ifdef crypto_kem_dec_batch
+    // Batched decapsulation, with every third ciphertext rejected, gives the shared secrets of crypto_kem_dec
+    unsigned char ct_dec[BATCH_ENCAPS*CRYPTO_CIPHERTEXTBYTES], ss_dec[BATCH_ENCAPS*CRYPTO_BYTES];
+
+    crypto_kem_keypair(pk, sk);
+    for (i = 0; i < BATCH_ENCAPS; i++) {
+        crypto_kem_enc(&ct_dec[i*CRYPTO_CIPHERTEXTBYTES], ss, pk);
+        if (i % 3 == 1) ct_dec[i*CRYPTO_CIPHERTEXTBYTES + 7*i] ^= 1;
+    }
+    crypto_kem_dec_batch(ss_dec, ct_dec, sk, BATCH_ENCAPS);
+    for (i = 0; i < BATCH_ENCAPS; i++) {
+        crypto_kem_dec(ss_, &ct_dec[i*CRYPTO_CIPHERTEXTBYTES], sk);
+        if (memcmp(&ss_dec[i*CRYPTO_BYTES], ss_, CRYPTO_BYTES) != 0) {
+            passed = false;
+            break;
+        }
+    }
+
+    if (passed == true) printf("  Batched decapsulation tests .................................. PASSED");
+    else { printf("  Batched decapsulation tests ... FAILED"); printf("\n"); return FAILED; }
+    printf("\n"); 
+#endif
+
+#if defined(crypto_kem_dec_service_create) && defined(__NIX__)
+    // The service gives the shared secrets of crypto_kem_dec, including implicit rejections, and reports every request once,
+    // either to the callback (even requests) or by poll (odd requests). Its capacity is less than the number of requests
+    unsigned char ct_svc[SERVICE_REQUESTS][CRYPTO_CIPHERTEXTBYTES], ss_svc[SERVICE_REQUESTS][CRYPTO_BYTES], ss_ref[SERVICE_REQUESTS][CRYPTO_BYTES];
+    int reported[SERVICE_REQUESTS] = {0};
+    void* ctx_svc[SERVICE_REQUESTS];
+    unsigned long long depths = 0, latencies = 0;
+    unsigned int k, npolled;
+    sike_dec_stats stats;
+    sike_dec_service* service = crypto_kem_dec_service_create(3, 5);
+
+    crypto_kem_keypair(pk, sk);
+    for (i = 0; i < SERVICE_REQUESTS; i++) {
+        crypto_kem_enc(ct_svc[i], ss, pk);
+        if (i % 3 == 2) ct_svc[i][i] ^= 1;
+        crypto_kem_dec(ss_ref[i], ct_svc[i], sk);
+    }
+    if (service == NULL) passed = false;
+    for (i = 0; i < SERVICE_REQUESTS && passed == true; ) {
+        if (crypto_kem_dec_service_submit(service, ss_svc[i], ct_svc[i], sk, (i % 2 == 0) ? service_callback : NULL, &reported[i]) == 0) {
+            i++;
+            continue;
+        }
+        npolled = crypto_kem_dec_service_poll(service, ctx_svc, SERVICE_REQUESTS, 1);    // Full, release completed requests
+        for (k = 0; k < npolled; k++) {
+            *(int*)ctx_svc[k] += 1;
+        }
+    }
+    if (service != NULL) {
+        do {
+            npolled = crypto_kem_dec_service_poll(service, ctx_svc, SERVICE_REQUESTS, 1);
+            for (k = 0; k < npolled; k++) {
+                *(int*)ctx_svc[k] += 1;
+            }
+        } while (npolled > 0);
+        crypto_kem_dec_service_stats(service, &stats);
+        crypto_kem_dec_service_destroy(service);
+
+        for (i = 0; i < SERVICE_REQUESTS; i++) {
+            if (memcmp(ss_svc[i], ss_ref[i], CRYPTO_BYTES) != 0 || reported[i] != 1) passed = false;
+        }
+        for (i = 0; i < SIKE_DEC_HISTOGRAM_BUCKETS; i++) {
+            depths += stats.queue_depth[i];
+            latencies += stats.latency[i];
+        }
+        if (stats.submitted != SERVICE_REQUESTS || stats.completed != SERVICE_REQUESTS || stats.in_flight != 0 ||
+            depths != SERVICE_REQUESTS || latencies != SERVICE_REQUESTS || stats.batches == 0 || stats.batches > SERVICE_REQUESTS) passed = false;
+    }
+
+    if (passed == true) printf("  Decapsulation service tests .................................. PASSED");
+    else { printf("  Decapsulation service tests ... FAILED"); printf("\n"); return FAILED; }
+    printf("\n"); 
+#endif
+
+#ifdef crypto_kem_enc_batch
+    unsigned char ct_batch[BATCH_ENCAPS*CRYPTO_CIPHERTEXTBYTES] = {0};
+    unsigned char ss_batch[BATCH_ENCAPS*CRYPTO_BYTES] = {0};
+
+    crypto_kem_keypair(pk, sk);
+    crypto_kem_enc_batch(ct_batch, ss_batch, pk, BATCH_ENCAPS);
+    for (i = 0; i < BATCH_ENCAPS; i++) 
+    {
+        crypto_kem_dec(ss_, &ct_batch[i*CRYPTO_CIPHERTEXTBYTES], sk);
+#ifdef DO_VALGRIND_CHECK
+        VALGRIND_MAKE_MEM_DEFINED(ss_batch, BATCH_ENCAPS*CRYPTO_BYTES);
+        VALGRIND_MAKE_MEM_DEFINED(ss_, CRYPTO_BYTES);
+#endif
+        
+        if (memcmp(&ss_batch[i*CRYPTO_BYTES], ss_, CRYPTO_BYTES) != 0) {
+            passed = false;
+            break;
+        }
+    }
+
+    if (passed == true) printf("  Batched encapsulation tests .................................. PASSED");
+    else { printf("  Batched encapsulation tests ... FAILED"); printf("\n"); return FAILED; }
+    printf("\n"); 
+
+    unsigned char in4[4][3*SHAKE256_RATE], out4[4][2*SHAKE256_RATE+8], out[2*SHAKE256_RATE+8];
+    unsigned int inlen, j;
+
+    randombytes(in4[0], sizeof(in4));
+    for (inlen = 0; inlen <= sizeof(in4[0]) && passed == true; inlen += 17)          // Spanning several absorbed and squeezed blocks
+    {
+        unsigned int outlen = 1 + (inlen*7) % sizeof(out);
+
+        shake256x4(out4[0], out4[1], out4[2], out4[3], outlen, in4[0], in4[1], in4[2], in4[3], inlen);
+        for (j = 0; j < 4; j++) {
+            shake256(out, outlen, in4[j], inlen);
+            if (memcmp(out, out4[j], outlen) != 0) {
+                passed = false;
+                break;
+            }
+        }
+    }
+
+    if (passed == true) printf("  4-way SHAKE256 tests ......................................... PASSED");
+    else { printf("  4-way SHAKE256 tests ... FAILED"); printf("\n"); return FAILED; }
+    printf("\n"); 
+#endif
+
+#ifdef crypto_kem_enc_ctx
+    sike_pk_ctx ctx;
+
+    crypto_kem_keypair(pk, sk);
+    sike_pk_ctx_init(&ctx, pk);
+    for (i = 0; i < TEST_LOOPS; i++) 
+    {
+        crypto_kem_enc_ctx(ct, ss, &ctx);
+        crypto_kem_dec(ss_, ct, sk);
+#ifdef DO_VALGRIND_CHECK
+        VALGRIND_MAKE_MEM_DEFINED(ss, CRYPTO_BYTES);
+        VALGRIND_MAKE_MEM_DEFINED(ss_, CRYPTO_BYTES);
+#endif
+        
+        if (memcmp(ss, ss_, CRYPTO_BYTES) != 0) {
+            passed = false;
+            break;
+        }
+    }
+
+    if (passed == true) printf("  Public key context tests ..................................... PASSED");
+    else { printf("  Public key context tests ... FAILED"); printf("\n"); return FAILED; }
+    printf("\n"); 
+#endif
+
+#ifdef crypto_kem_ct_validate
+    #define MSG_LEN    (CRYPTO_CIPHERTEXTBYTES - CRYPTO_PUBLICKEYBYTES)
+    #define COORD_LEN  (CRYPTO_PUBLICKEYBYTES / 6)
+    unsigned char ct_[CRYPTO_CIPHERTEXTBYTES], reject[MSG_LEN + CRYPTO_CIPHERTEXTBYTES];
+
+    crypto_kem_keypair(pk, sk);
+    crypto_kem_enc(ct, ss, pk);
+    if (crypto_kem_ct_validate(ct) != 0) passed = false;
+    for (i = 0; i < 6 && passed == true; i++) 
+    {
+        // Both a reduced but wrong coordinate and an unreduced one give the implicit-rejection secret ss = H(s||ct)
+        memcpy(ct_, ct, CRYPTO_CIPHERTEXTBYTES);
+        ct_[i*COORD_LEN] ^= 1;
+        if (crypto_kem_ct_validate(ct_) != 0) passed = false;
+        crypto_kem_dec(ss_, ct_, sk);
+        memcpy(reject, sk, MSG_LEN);
+        memcpy(&reject[MSG_LEN], ct_, CRYPTO_CIPHERTEXTBYTES);
+        shake256(ss, CRYPTO_BYTES, reject, MSG_LEN + CRYPTO_CIPHERTEXTBYTES);
+        if (memcmp(ss, ss_, CRYPTO_BYTES) != 0) passed = false;
+
+        memset(&ct_[i*COORD_LEN], 0xFF, COORD_LEN);
+        if (crypto_kem_ct_validate(ct_) != -1) passed = false;
+        crypto_kem_dec(ss_, ct_, sk);
+        memcpy(&reject[MSG_LEN], ct_, CRYPTO_CIPHERTEXTBYTES);
+        shake256(ss, CRYPTO_BYTES, reject, MSG_LEN + CRYPTO_CIPHERTEXTBYTES);
+        if (memcmp(ss, ss_, CRYPTO_BYTES) != 0) passed = false;
+    }
+
+    if (passed == true) printf("  Ciphertext validation tests .................................. PASSED");
+    else { printf("  Ciphertext validation tests ... FAILED"); printf("\n"); return FAILED; }
+    printf("\n"); 
+#endif
+
+    unsigned char seed = 7, r0[3*SHAKE256_RATE+5], r1[3*SHAKE256_RATE+5];
+
+    // The output only depends on the seed read from the source, the generators reseed when the source is set
+    randombytes_set_source(test_source, &seed);
+    randombytes(r0, 1);
+    randombytes(r0 + 1, sizeof(r0) - 1);           // Spanning a refill of the buffer
+    randombytes_set_source(test_source, &seed);
+    randombytes(r1, sizeof(r1));
+    if (memcmp(r0, r1, sizeof(r0)) != 0) passed = false;
+    seed = 8;
+    randombytes_set_source(test_source, &seed);
+    randombytes(r1, sizeof(r1));
+    if (memcmp(r0, r1, sizeof(r0)) == 0) passed = false;
+    randombytes_set_source(NULL, NULL);
+    randombytes(r1, sizeof(r1));
+    if (memcmp(r0, r1, sizeof(r0)) == 0) passed = false;
+
+#if defined(__NIX__)
+    // The child of a fork does not repeat the output of the parent
+    int fd[2];
+    pid_t pid;
+
+    randombytes(r0, 1);
+    if (pipe(fd) != 0 || (pid = fork()) < 0) {
+        passed = false;
+    } else if (pid == 0) {
+        randombytes(r1, 32);
+        _exit(write(fd[1], r1, 32) == 32 ? 0 : 1);
+    } else {
+        randombytes(r0, 32);
+        if (read(fd[0], r1, 32) != 32 || waitpid(pid, NULL, 0) != pid) passed = false;
+        if (memcmp(r0, r1, 32) == 0) passed = false;
+        close(fd[0]);
+        close(fd[1]);
+    }
+#endif
+
+    if (passed == true) printf("  Random number generator tests ................................ PASSED");
+    else { printf("  Random number generator tests ... FAILED"); printf("\n"); return FAILED; }
+    printf("\n"); 
+
+#if defined(SIDH_PROFILE)
+    sidh_profile_t profile;
+    unsigned int phase, op;
+
+    sidh_profile_reset();
+    sidh_profile_get(&profile);
+    for (phase = 0; phase < SIDH_PROFILE_PHASES; phase++) {
+        for (op = 0; op < SIDH_PROFILE_OPS; op++) {
+            if (profile.count[phase][op] != 0) passed = false;
+        }
+    }
+
+    crypto_kem_keypair(pk, sk);
+    crypto_kem_enc(ct, ss, pk);
+    crypto_kem_dec(ss_, ct, sk);
+    sidh_profile_get(&profile);
+    if (memcmp(ss, ss_, CRYPTO_BYTES) != 0) passed = false;
+    if (profile.count[SIDH_PHASE_LADDER][SIDH_OP_FP2MUL] == 0 || profile.count[SIDH_PHASE_TRAVERSAL][SIDH_OP_FP2MUL] == 0) passed = false;
+#ifdef COMPRESS
+    if (profile.count[SIDH_PHASE_BASIS][SIDH_OP_FP2MUL] == 0 || profile.count[SIDH_PHASE_PAIRING][SIDH_OP_FP2MUL] == 0 ||
+        profile.count[SIDH_PHASE_DLOG][SIDH_OP_FP2MUL] == 0) passed = false;
+#endif
+
+    if (passed == true) printf("  Profiling counters tests ..................................... PASSED");
+    else { printf("  Profiling counters tests ... FAILED"); printf("\n"); return FAILED; }
+    printf("\n\n  Operation counts of one keypair/encapsulation/decapsulation:\n");
+    sidh_profile_write_json(stdout, &profile);
+    printf("\n");
+#endif
+
     return PASSED;
 }
 
@@ -134,6 +504,43 @@ int cryptorun_kem()
     printf("  Decapsulation runs in ........................................ %10lld ", cycles_decaps/BENCH_LOOPS); print_unit;
     printf("\n");
 
+#ifdef crypto_kem_dec_batch
+    // Batched decapsulation of SERVICE_BENCH ciphertexts, as time per ciphertext
+    static unsigned char ct_dec[SERVICE_BENCH*CRYPTO_CIPHERTEXTBYTES], ss_dec[SERVICE_BENCH*CRYPTO_BYTES];
+
+    for (n = 0; n < SERVICE_BENCH; n++) {
+        memcpy(&ct_dec[n*CRYPTO_CIPHERTEXTBYTES], ct, CRYPTO_CIPHERTEXTBYTES);
+    }
+    cycles1 = cpucycles();
+    crypto_kem_dec_batch(ss_dec, ct_dec, sk, SERVICE_BENCH);
+    cycles2 = cpucycles();
+
+    printf("  Batched decapsulation runs in ................................ %10lld ", (cycles2-cycles1)/SERVICE_BENCH); print_unit;
+    printf("\n");
+#endif
+
+#if defined(crypto_kem_dec_service_create) && defined(__NIX__)
+    // Throughput of the decapsulation service with SERVICE_BENCH requests in flight, as time per ciphertext
+    static unsigned char ss_svc[SERVICE_BENCH][CRYPTO_BYTES];
+    void* ctx_svc[SERVICE_BENCH];
+    unsigned int released = 0;
+    sike_dec_service* service = crypto_kem_dec_service_create(SERVICE_WORKERS, SERVICE_BENCH);
+
+    if (service == NULL) return FAILED;
+    cycles1 = cpucycles();
+    for (n = 0; n < SERVICE_BENCH; n++) {
+        crypto_kem_dec_service_submit(service, ss_svc[n], ct, sk, NULL, NULL);
+    }
+    while (released < SERVICE_BENCH) {
+        released += crypto_kem_dec_service_poll(service, ctx_svc, SERVICE_BENCH, 1);
+    }
+    cycles2 = cpucycles();
+    crypto_kem_dec_service_destroy(service);
+
+    printf("  Decapsulation service (%d workers) runs in .................... %10lld ", SERVICE_WORKERS, (cycles2-cycles1)/SERVICE_BENCH); print_unit;
+    printf("\n");
+#endif
+
     return PASSED;
 }
 
@@ -0,0 +1,340 @@
+/********************************************************************************************
+* SIDH: an efficient supersingular isogeny cryptography library
+* Copyright (c) Microsoft Corporation
+*
+* Website: https://github.com/microsoft/PQCrypto-SIDH
+* Released under MIT license
+*
+* Abstract: parallel van Oorschot-Wiener collision search on reduced SIDH instances
+*
+* Usage: vow-pXXX [-e bits] [-w log2slots] [-t threads] [-n runs] [--scaling seconds]
+*   -e:        length of the secret isogeny, a multiple of 4 (24 by default)
+*   -w:        log2 of the number of slots of the distinguished point table (m/2+2 by default, for e = 2m)
+*   -t:        number of threads (number of online processors by default)
+*   -n:        number of instances to solve (1 by default)
+*   --scaling: instead of solving instances, run the search for the given number of seconds with 1, 2, 4, ...
+*              threads and report steps/second/core and the parallel efficiency
+*
+* The step function f_n maps a walk point x to the hash, keyed by the function version n, of the j-invariant reached
+* by the walk of x (see isogeny_walks.c), a point is distinguished if a second keyed hash is below a fraction theta
+* = 2.25*sqrt(w/N) of its range for N = 2^(m+1) points and w table slots, and each version runs until 10*w
+* distinguished points have been found (van Oorschot and Wiener, "Parallel collision search with cryptanalytic
+* applications", J. Cryptology 1999). The threads share a table of 64-bit slots holding the pair (distinguished
+* point, starting point), written with atomic exchanges, so that a collision of trails is detected lock-free by the
+* thread that overwrites the slot. The golden collision is a collision of walk points on opposite sides with equal
+* j-invariants. The expected number of steps is 2.5*sqrt(N^3/w), which is printed with the measured steps/second/core
+* for this and for full-size instances.
+*********************************************************************************************/
+
+#include <inttypes.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "isogeny_walks.c"
+
+
+#define VOW_DIST_PER_SLOT     10              // Distinguished points per table slot and function version
+#define VOW_MAX_TRAIL         20              // Maximum trail length, in units of 1/theta
+#define VOW_MAX_VERSIONS    1000              // Maximum number of function versions per instance
+
+// Shared state of a search
+typedef struct {
+    const walk_instance_t* inst;
+    unsigned int m, nthreads;
+    uint64_t npoints;                         // N = 2^(m+1)
+    uint64_t theta;                           // Distinguished points have hash < theta*2^32
+    uint64_t max_trail;
+    uint64_t nslots, dist_per_version;
+    _Atomic uint64_t* table;                  // Slots (xd+1)*2^32 + x0, 0 if empty
+    uint64_t version;                         // Function version, changed by one thread between two barriers
+    int halt;                                 // Halting decision, written by one thread between two barriers
+    atomic_uint_fast64_t ndist;               // Distinguished points of the current version
+    atomic_int stop;                          // 1 if the golden collision was found, 2 on time or version limit
+    atomic_uint_fast64_t steps, collisions;
+    uint64_t golden[2];                       // Kernel scalars of the golden collision on sides 0 and 1
+    pthread_barrier_t barrier;
+} vow_t;
+
+
+static uint64_t vow_step(const vow_t* v, uint64_t x, uint64_t version, f2elm_t j)
+{ // Step function f_version(x), with j the j-invariant of the walk of x
+    unsigned int side = (unsigned int)(x >> v->m);
+
+    walk_curve(&v->inst->side[side], v->m, x & (((uint64_t)1 << v->m) - 1), j);
+    return walk_hash(j, version) & (v->npoints - 1);
+}
+
+
+static int vow_distinguished(const vow_t* v, uint64_t x, uint64_t version)
+{ // Distinguished point predicate of version version
+    return (walk_mix(x ^ walk_mix(~version)) >> 32) < v->theta;
+}
+
+
+static uint64_t vow_trail(const vow_t* v, uint64_t x, uint64_t version, uint64_t* steps)
+{ // Length of the trail from x to its first distinguished point, 0 if it is longer than max_trail
+    f2elm_t j;
+    uint64_t len;
+
+    for (len = 1; len <= v->max_trail; len++) {
+        x = vow_step(v, x, version, j);
+        if (vow_distinguished(v, x, version)) {
+            *steps += len;
+            return len;
+        }
+    }
+    *steps += v->max_trail;
+    return 0;
+}
+
+
+static void vow_locate(vow_t* v, uint64_t a, uint64_t b, uint64_t version, uint64_t* steps)
+{ // Locating the collision of the trails from a and b, which end at the same distinguished point
+    uint64_t la = vow_trail(v, a, version, steps), lb = vow_trail(v, b, version, steps), fa, fb;
+    f2elm_t ja, jb;
+
+    if (la == 0 || lb == 0) return;
+    for (; la > lb; la--, (*steps)++) a = vow_step(v, a, version, ja);
+    for (; lb > la; lb--, (*steps)++) b = vow_step(v, b, version, jb);
+    if (a == b) return;                       // One trail starts on the other
+
+    for (; la > 0; la--) {
+        fa = vow_step(v, a, version, ja);
+        fb = vow_step(v, b, version, jb);
+        *steps += 2;
+        if (fa == fb) {
+            atomic_fetch_add(&v->collisions, 1);
+            if ((a >> v->m) != (b >> v->m) && fp2_equal(ja, jb)) {
+                int expected = 0;
+                if (atomic_compare_exchange_strong(&v->stop, &expected, 1)) {
+                    v->golden[a >> v->m] = a & (((uint64_t)1 << v->m) - 1);
+                    v->golden[b >> v->m] = b & (((uint64_t)1 << v->m) - 1);
+                }
+            }
+            return;
+        }
+        a = fa;
+        b = fb;
+    }
+}
+
+
+static void* vow_worker(void* arg)
+{ // Search thread: trails from random starting points until the golden collision is found or the search is stopped
+    vow_t* v = (vow_t*)arg;
+    uint64_t rng, x0, x, xd, len, slot, entry, old, steps = 0;
+    f2elm_t j;
+
+    randombytes((unsigned char*)&rng, sizeof(rng));
+    for (;;) {
+        if (atomic_load(&v->stop) != 0 || atomic_load(&v->ndist) >= v->dist_per_version) {
+            // All threads meet to change the function version or to halt
+            if (pthread_barrier_wait(&v->barrier) == PTHREAD_BARRIER_SERIAL_THREAD) {
+                v->halt = (atomic_load(&v->stop) != 0);
+                if (!v->halt && v->version + 1 >= VOW_MAX_VERSIONS) {
+                    atomic_store(&v->stop, 2);
+                    v->halt = 1;
+                }
+                if (!v->halt) {
+                    memset((void*)v->table, 0, v->nslots*sizeof(uint64_t));
+                    atomic_store(&v->ndist, 0);
+                    v->version++;
+                }
+            }
+            pthread_barrier_wait(&v->barrier);
+            if (v->halt) break;
+            continue;
+        }
+
+        rng += 0x9e3779b97f4a7c15ULL;
+        x0 = walk_mix(rng) & (v->npoints - 1);
+        x = x0;
+        for (len = 1; len <= v->max_trail; len++) {
+            x = vow_step(v, x, v->version, j);
+            if (vow_distinguished(v, x, v->version)) break;
+        }
+        steps += (len > v->max_trail) ? v->max_trail : len;
+        if (len > v->max_trail) continue;     // Trail in a cycle or too long
+
+        xd = x;
+        atomic_fetch_add(&v->ndist, 1);
+        slot = walk_mix(xd ^ v->version) & (v->nslots - 1);
+        entry = ((xd + 1) << 32) | x0;
+        old = atomic_exchange(&v->table[slot], entry);
+        if ((old >> 32) == xd + 1 && (old & 0xFFFFFFFF) != x0) {
+            vow_locate(v, old & 0xFFFFFFFF, x0, v->version, &steps);
+        }
+    }
+    atomic_fetch_add(&v->steps, steps);
+    return NULL;
+}
+
+
+static double vow_time(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec*1e-9;
+}
+
+
+static int vow_search(vow_t* v, const walk_instance_t* inst, unsigned int log2w, unsigned int nthreads, double seconds, double* elapsed)
+{ // Search for the golden collision of an instance, stopped after the given number of seconds if not 0.
+  // Returns 1 if the golden collision was found, 0 if the search was stopped, -1 on failure
+    pthread_t* threads;
+    double theta, start;
+    unsigned int i;
+    int found;
+
+    memset(v, 0, sizeof(*v));
+    v->inst = inst;
+    v->m = inst->m;
+    v->nthreads = nthreads;
+    v->npoints = (uint64_t)1 << (inst->m + 1);
+    v->nslots = (uint64_t)1 << log2w;
+    theta = 2.25*sqrt((double)v->nslots/(double)v->npoints);
+    if (theta > 1) theta = 1;
+    v->theta = (uint64_t)(theta*4294967296.0);
+    v->max_trail = (uint64_t)(VOW_MAX_TRAIL/theta);
+    v->dist_per_version = VOW_DIST_PER_SLOT*v->nslots;
+    v->table = calloc(v->nslots, sizeof(uint64_t));
+    threads = calloc(nthreads, sizeof(pthread_t));
+    if (v->table == NULL || threads == NULL || pthread_barrier_init(&v->barrier, NULL, nthreads) != 0) {
+        free((void*)v->table);
+        free(threads);
+        return -1;
+    }
+
+    start = vow_time();
+    for (i = 0; i < nthreads; i++) {
+        if (pthread_create(&threads[i], NULL, vow_worker, v) != 0) {
+            fprintf(stderr, "  Thread creation failed\n");
+            exit(1);
+        }
+    }
+    while (seconds > 0 && atomic_load(&v->stop) == 0 && vow_time() - start < seconds) {
+        usleep(1000);
+    }
+    if (seconds > 0) {
+        int expected = 0;
+        atomic_compare_exchange_strong(&v->stop, &expected, 2);
+    }
+    for (i = 0; i < nthreads; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    *elapsed = vow_time() - start;
+    found = (atomic_load(&v->stop) == 1);
+
+    pthread_barrier_destroy(&v->barrier);
+    free((void*)v->table);
+    free(threads);
+    return found;
+}
+
+
+static double vow_expected_steps(unsigned int m, unsigned int log2w)
+{ // Expected number of steps 2.5*sqrt(N^3/w) for N = 2^(m+1)
+    return 2.5*pow(2.0, 1.5*(m + 1) - 0.5*log2w);
+}
+
+
+static void print_usage(const char* prog)
+{
+    printf("Usage: %s [-e bits] [-w log2slots] [-t threads] [-n runs] [--scaling seconds]\n", prog);
+}
+
+
+int main(int argc, char** argv)
+{
+    unsigned int e = 24, log2w = 0, nthreads = 0, runs = 1, i, t, nfound = 0;
+    double scaling = 0, elapsed, rate, rate1 = 0, total_time = 0, total_steps = 0;
+    walk_instance_t inst;
+    vow_t v;
+    f2elm_t j;
+    int r;
+
+    for (i = 1; i < (unsigned int)argc; i++) {
+        if (strcmp(argv[i], "-e") == 0 && i + 1 < (unsigned int)argc) {
+            e = (unsigned int)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-w") == 0 && i + 1 < (unsigned int)argc) {
+            log2w = (unsigned int)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-t") == 0 && i + 1 < (unsigned int)argc) {
+            nthreads = (unsigned int)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < (unsigned int)argc) {
+            runs = (unsigned int)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--scaling") == 0 && i + 1 < (unsigned int)argc) {
+            scaling = atof(argv[++i]);
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (nthreads == 0) {
+        long n = sysconf(_SC_NPROCESSORS_ONLN);
+        nthreads = (n > 0) ? (unsigned int)n : 1;
+    }
+    if (log2w == 0) {
+        log2w = e/4 + 2;
+    }
+    if ((e & 3) != 0 || e == 0 || e/2 > WALK_MAX_M || 3*(e/2) > OALICE_BITS || log2w > e/2 - 1 || log2w > 30 || runs == 0) {
+        printf("  Unsupported parameters: e must be a multiple of 4 with e/2 <= %d and 3e/2 <= %d, and log2slots < e/2 \n", WALK_MAX_M, OALICE_BITS);
+        return 1;
+    }
+
+    printf("\n\nVAN OORSCHOT-WIENER SEARCH ON REDUCED %s INSTANCES\n", SCHEME_NAME);
+    printf("--------------------------------------------------------------------------------------------------------\n\n");
+    printf("  Secret isogeny of length e = %u, N = 2^%u walk points, w = 2^%u table slots, theta = %.4f \n", e, e/2 + 1, log2w, fmin(1, 2.25*pow(2.0, 0.5*log2w - 0.5*(e/2 + 1))));
+    printf("  Expected steps per instance: 2^%.2f \n\n", log2(vow_expected_steps(e/2, log2w)));
+
+    if (scaling > 0) {
+        if (!walk_instance_init(&inst, e)) {
+            printf("  Instance generation failed \n");
+            return 1;
+        }
+        printf("  %8s %16s %20s %12s\n", "threads", "steps/second", "steps/second/core", "efficiency");
+        for (t = 1; ; t = (2*t < nthreads) ? 2*t : nthreads) {
+            if (vow_search(&v, &inst, log2w, t, scaling, &elapsed) < 0) {
+                printf("  Search setup failed \n");
+                return 1;
+            }
+            rate = (double)atomic_load(&v.steps)/elapsed;
+            if (t == 1) rate1 = rate;
+            printf("  %8u %16.0f %20.0f %11.1f%%\n", t, rate, rate/t, 100*rate/(rate1*t));
+            if (t == nthreads) break;
+        }
+        return 0;
+    }
+
+    for (i = 0; i < runs; i++) {
+        if (!walk_instance_init(&inst, e)) {
+            printf("  Instance generation failed \n");
+            return 1;
+        }
+        r = vow_search(&v, &inst, log2w, nthreads, 0, &elapsed);
+        if (r < 0) {
+            printf("  Search setup failed \n");
+            return 1;
+        }
+        total_time += elapsed;
+        total_steps += (double)atomic_load(&v.steps);
+        if (r == 1) {
+            walk_curve(&inst.side[0], inst.m, v.golden[0], j);
+            r = fp2_equal(j, inst.jmid);
+            nfound += r;
+        }
+        printf("  Instance %u: %s after 2^%.2f steps, %" PRIu64 " versions, %" PRIu64 " collisions, %.2f s\n", i + 1,
+               (r == 1) ? "middle curve found" : "FAILED", log2((double)atomic_load(&v.steps)), v.version + 1, (uint64_t)atomic_load(&v.collisions), elapsed);
+    }
+
+    rate = total_steps/total_time;
+    printf("\n  Solved %u of %u instances, average 2^%.2f steps (expected 2^%.2f)\n", nfound, runs, log2(total_steps/runs), log2(vow_expected_steps(e/2, log2w)));
+    printf("  Throughput: %.0f steps/second, %.0f steps/second/core on %u threads\n", rate, rate/nthreads, nthreads);
+    printf("  Extrapolation to e = %d with w = 2^%u: 2^%.2f steps, 2^%.2f core-seconds at the step cost of e = %u\n", OALICE_BITS, log2w,
+           log2(vow_expected_steps(OALICE_BITS/2, log2w)), log2(vow_expected_steps(OALICE_BITS/2, log2w)/(rate/nthreads)), e);
+    return (nfound == runs) ? 0 : 1;
+}